@@ -0,0 +1,57 @@
+#ifndef ALERT_H
+#define ALERT_H
+
+/**
+ * Alertas de seguridad hacia el servidor remoto por USART3.
+ *
+ * Cada evento (clave incorrecta, emergencia, cambio de clave) entra en una
+ * cola de ALERT_QUEUE_LEN alertas guardada en config_store, así que las
+ * que no llegaron sobreviven a un reset. Se envían de a una, la más vieja
+ * primero, como PUBLISH de MQTT-SN con QoS 1 (trama en sn_link.h):
+ *   largo | 0x0C | flags | tópico ALERT_TOPIC_ID | msg id = id | tipo | tiempo (32)
+ * con id creciente (nunca 0) y tiempo de rtc_clock_timestamp() (hora Unix,
+ * o segundos desde el arranque si el RTC no está en hora), big endian.
+ * La alerta queda pendiente hasta recibir el PUBACK con su id y código 0;
+ * sin respuesta se reenvía (flag DUP) con espera exponencial de
+ * ALERT_ACK_TIMEOUT_MS a ALERT_BACKOFF_MAX_MS. El receptor descarta
+ * duplicados por id.
+ *
+ * Con la cola llena de pendientes, una alerta nueva pisa la más vieja
+ * (queda contada en dropped).
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ALERT_QUEUE_LEN         8U      // Dos valores de config_store de 4 alertas
+#define ALERT_TOPIC_ID          0x0002U
+#define ALERT_TOPIC_NAME        "room/alert"
+#define ALERT_ACK_TIMEOUT_MS    2000U
+#define ALERT_BACKOFF_MAX_MS    64000U
+
+// No reordenar: el valor queda en la flash y viaja en el mensaje
+typedef enum {
+    ALERT_ACCESS_DENIED = 1,
+    ALERT_EMERGENCY = 2,
+    ALERT_PASSWORD_CHANGED = 3
+} alert_type_t;
+
+typedef struct {
+    uint32_t pending;         // En la cola sin PUBACK
+    uint32_t raised;
+    uint32_t sent;            // Envíos, incluidos los reenvíos
+    uint32_t retries;
+    uint32_t acked;
+    uint32_t dropped;         // Pisadas con la cola llena
+    uint32_t next_id;
+    uint32_t backoff_ms;      // Espera actual de la alerta en vuelo
+} alert_stats_t;
+
+void alert_init(void);
+void alert_raise(alert_type_t type);
+void alert_poll(void);
+void alert_on_puback(uint16_t topic_id, uint16_t msg_id, uint8_t return_code);
+void alert_get_stats(alert_stats_t *stats);
+
+#endif // ALERT_H
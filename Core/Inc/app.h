@@ -0,0 +1,26 @@
+#ifndef APP_H
+#define APP_H
+
+/**
+ * Aplicación: inicialización de módulos y una vuelta del superloop.
+ *
+ * main() solo inicializa los periféricos de CubeMX y llama app_loop() en
+ * el while (1); así el mismo código corre en el simulador de host, que
+ * avanza el tiempo virtual entre vueltas.
+ */
+
+#include "main.h"
+#include "keypad.h"
+#include "room_control.h"
+#include "ssd1306.h"
+
+extern keypad_handle_t keypad;
+extern room_control_t room_system;
+
+void app_init(void);
+void app_loop(void);
+
+void write_to_oled(char *message, SSD1306_COLOR color, uint8_t x, uint8_t y);
+void heartbeat(void);
+
+#endif // APP_H
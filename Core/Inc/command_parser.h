@@ -8,4 +8,13 @@ void command_parser_process_debug(uint8_t byte);
 // Versión para ESP-01 (nivel intermedio)
 void command_parser_process_esp01(uint8_t byte);
 
+// Líneas descartadas por superar el buffer de comando
+uint32_t command_parser_get_overflows(void);
+
+// Líneas descartadas por el limitador de ambos canales
+uint32_t command_parser_get_rate_limited(void);
+
+// Vacía los buffers de ambos canales, llena el limitador y borra los contadores
+void command_parser_reset(void);
+
 #endif // COMMAND_PARSER_H
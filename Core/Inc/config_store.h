@@ -0,0 +1,73 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+/**
+ * Almacén clave-valor de configuración en la flash interna.
+ *
+ * Es un log de registros en CONFIG_STORE_PAGES páginas de 2 KB al final
+ * del banco 2 (región CONFIG de STM32L476RGTx_FLASH.ld). Cada registro
+ * ocupa palabras dobles (la unidad de programación del L476) y lleva un
+ * CRC-16; uno cortado por un reset se descarta al arrancar.
+ *
+ * Las páginas se usan en anillo: al llenarse la activa se abre la
+ * siguiente y, si ya no queda ninguna borrada, se copian los registros
+ * vigentes de la más vieja a la activa y se borra. Así todas las páginas
+ * se borran por igual.
+ *
+ * config_store_init() recorre la región una vez y arma un índice en RAM
+ * (dirección del último registro de cada clave); las lecturas son O(1).
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Debe coincidir con la región CONFIG del linker script
+#define CONFIG_STORE_BASE        0x080FE000UL
+#define CONFIG_STORE_PAGES       4U
+#define CONFIG_STORE_PAGE_SIZE   2048U
+#define CONFIG_STORE_VALUE_MAX   32U
+
+// Lectura de la flash (el build de host la redefine)
+#ifndef FLASH_READ_PTR
+#define FLASH_READ_PTR(address) ((const uint8_t *)(uintptr_t)(address))
+#endif
+
+// Claves guardadas (no reordenar: el valor numérico queda en la flash)
+typedef enum {
+    CONFIG_KEY_PASSWORD = 1,     // pin_hash_t (antes char[4] en texto)
+    CONFIG_KEY_THRESHOLDS = 2,   // int16_t[3], centésimas de °C
+    CONFIG_KEY_FAN_MODE = 3,     // uint8_t (fan_mode_t)
+    CONFIG_KEY_SETPOINT = 4,     // int32_t, centésimas de °C
+    CONFIG_KEY_PUBLISH = 5,      // uint16_t intervalo s, uint8_t muestras, uint8_t formato
+    CONFIG_KEY_ALERTS_0 = 6,     // Cola de alertas, slots 0-3
+    CONFIG_KEY_ALERTS_1 = 7,     // Cola de alertas, slots 4-7
+    CONFIG_KEY_FAILED_ATTEMPTS = 8,  // uint8_t, claves incorrectas consecutivas
+    CONFIG_KEY_RTC = 9,          // int16_t calibración base (pulsos), int16_t huso (min)
+    CONFIG_KEY_PROFILES_0 = 10,  // room_profile_t[2], perfiles 0-1 de la programación
+    CONFIG_KEY_PROFILES_1 = 11,  // room_profile_t[2], perfiles 2-3
+    CONFIG_KEY_SCHEDULE_0 = 12,  // schedule_entry_t[8], entradas 0-7
+    CONFIG_KEY_SCHEDULE_1 = 13,  // schedule_entry_t[8], entradas 8-15
+    CONFIG_KEY_COUNT
+} config_key_t;
+
+typedef struct {
+    uint32_t records;        // Registros válidos en la flash
+    uint32_t keys;           // Claves con valor
+    uint32_t corrupt;        // Registros descartados al arrancar
+    uint32_t active_page;
+    uint32_t free_bytes;     // Libres en la página activa
+    uint32_t generation;     // Páginas abiertas desde el formateo
+    uint32_t compactions;
+    uint32_t write_errors;
+    uint32_t boot_us;        // Duración de config_store_init()
+} config_store_stats_t;
+
+bool config_store_init(void);
+bool config_store_get(config_key_t key, void *value, uint16_t len);
+bool config_store_set(config_key_t key, const void *value, uint16_t len);
+bool config_store_compact(void);
+bool config_store_format(void);
+void config_store_get_stats(config_store_stats_t *stats);
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,37 @@
+#ifndef FAN_PID_H
+#define FAN_PID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Periodo fijo del lazo de control
+#define FAN_PID_PERIOD_MS 500
+
+// Duty del ventilador en por mil
+#define FAN_DUTY_MAX 1000
+
+/*
+ * PID en punto fijo. Unidades:
+ *  - temperatura y setpoint en centésimas de °C
+ *  - salida en por mil de duty (0..FAN_DUTY_MAX)
+ *  - ganancias en Q8: kp [‰ por 0.01 °C], ki [‰ por 0.01 °C·s], kd [‰ por 0.01 °C/s]
+ */
+typedef struct {
+    int32_t kp_q8;
+    int32_t ki_q8;
+    int32_t kd_q8;
+    int32_t out_min;
+    int32_t out_max;
+    int32_t rate_limit;        // máximo cambio de salida en ‰ por segundo
+
+    int64_t integral;          // término integral en ‰ x 1000
+    int32_t prev_measurement;
+    int32_t output;
+    bool primed;               // ya hay una medición previa para el término D
+} fan_pid_t;
+
+void fan_pid_init(fan_pid_t *pid);
+void fan_pid_reset(fan_pid_t *pid, int32_t output);
+int32_t fan_pid_update(fan_pid_t *pid, int32_t setpoint, int32_t measurement, uint32_t dt_ms);
+
+#endif // FAN_PID_H
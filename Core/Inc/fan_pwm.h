@@ -0,0 +1,26 @@
+#ifndef FAN_PWM_H
+#define FAN_PWM_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Frecuencia por defecto: por encima del rango audible
+#define FAN_PWM_DEFAULT_HZ        25000
+#define FAN_PWM_MIN_RESOLUTION    10     // bits
+
+// Resultado del cálculo de prescaler / periodo para una frecuencia
+typedef struct {
+    uint32_t prescaler;        // valor a cargar en PSC
+    uint32_t period;           // pasos de duty (ARR + 1)
+    uint32_t frequency_hz;     // frecuencia real obtenida
+    uint8_t resolution_bits;   // floor(log2(period))
+} fan_pwm_config_t;
+
+bool fan_pwm_compute(uint32_t timer_clock_hz, uint32_t frequency_hz,
+                     uint8_t min_resolution_bits, fan_pwm_config_t *config);
+uint32_t fan_pwm_timer_clock_hz(void);
+bool fan_pwm_configure(TIM_HandleTypeDef *htim, uint32_t frequency_hz, uint8_t min_resolution_bits);
+uint32_t fan_pwm_get_frequency(TIM_HandleTypeDef *htim);
+
+#endif // FAN_PWM_H
@@ -0,0 +1,29 @@
+#ifndef FAN_RAMP_H
+#define FAN_RAMP_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Muestras del buffer circular DMA -> TIM3->CCR1 (dos mitades).
+// A 25 kHz cada mitad dura ~1.3 ms: una interrupción cada 32 periodos PWM
+#define FAN_RAMP_BUFFER_LEN 64
+
+// Perfil de la transición entre dos valores de CCR
+typedef enum {
+    FAN_RAMP_LINEAR,
+    FAN_RAMP_S_CURVE,      // smoothstep: arranca y frena suave
+    FAN_RAMP_EXPONENTIAL   // rápido al inicio, se asienta al final
+} fan_ramp_curve_t;
+
+void fan_ramp_init(TIM_HandleTypeDef *htim);
+void fan_ramp_configure(fan_ramp_curve_t curve, uint32_t duration_ms);
+void fan_ramp_set_target(uint16_t ccr);
+void fan_ramp_rescale(uint32_t old_period, uint32_t new_period);
+uint16_t fan_ramp_get_target(void);
+bool fan_ramp_is_active(void);
+
+// Forma de la curva: progreso Q15 (0..32768) -> fracción Q15 (0..32768)
+uint16_t fan_ramp_curve(fan_ramp_curve_t curve, uint16_t progress_q15);
+
+#endif // FAN_RAMP_H
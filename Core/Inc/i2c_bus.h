@@ -0,0 +1,25 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+/**
+ * Velocidad del bus I2C1 (OLED) configurable en ejecución: 100 kHz
+ * (Standard), 400 kHz (Fast) o 1 MHz (Fast-mode Plus).
+ *
+ * Si el display responde con NACK, error de bus o timeout a 400 kHz o
+ * 1 MHz, se baja un escalón y el driver del SSD1306 reintenta la
+ * transacción a la nueva velocidad.
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define I2C_BUS_DEFAULT_KHZ  400
+
+void i2c_bus_init(I2C_HandleTypeDef *hi2c, uint32_t khz);
+bool i2c_bus_request_speed(uint32_t khz);
+void i2c_bus_poll(void);
+uint32_t i2c_bus_get_speed(void);
+uint32_t i2c_bus_get_fallbacks(void);
+
+#endif // I2C_BUS_H
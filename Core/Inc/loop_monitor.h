@@ -0,0 +1,54 @@
+#ifndef LOOP_MONITOR_H
+#define LOOP_MONITOR_H
+
+/**
+ * Medición continua del superloop: duración de cada vuelta del while (1)
+ * y latencia desde la EXTI del keypad hasta room_control_process_key().
+ *
+ * Ambas se guardan en histogramas log2 en microsegundos. Si una vuelta
+ * supera el umbral de alarma se informa la sección del loop que más tardó.
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Secciones del superloop en main.c
+typedef enum {
+    LOOP_SEC_HEARTBEAT,
+    LOOP_SEC_ROOM,        // room_control_update() (incluye refresco del OLED)
+    LOOP_SEC_KEYPAD,      // scan del keypad y entrega de la tecla
+    LOOP_SEC_DEMO,        // mensajes de demo en el OLED
+    LOOP_SEC_TEMP,        // muestreo del LM35
+    LOOP_SEC_TELEMETRY,   // muestra y volcado de telemetría (TLM_DUMP)
+    LOOP_SEC_ALERTS,      // reintentos de alertas y su guardado en flash
+    LOOP_SEC_USERS,       // altas y bajas de usuarios (borra la flash)
+    LOOP_SEC_RTC,         // SET_TIME y alarma de 1 Hz del RTC
+    LOOP_SEC_SCHEDULE,    // programación semanal (guarda en flash)
+    LOOP_SEC_PUBLISH,     // lote de telemetría MQTT-SN por USART3
+    LOOP_SEC_TLOG,        // envío de las tramas TLOG por USART2
+    LOOP_SEC_COUNT
+} loop_section_t;
+
+// Histogramas: el intervalo i cubre [2^(i-1), 2^i) µs; el último acumula el resto
+#define LOOP_MON_BUCKETS           24
+#define LOOP_MON_DEFAULT_ALARM_US  20000   // 20 ms
+#define LOOP_MON_ALARM_HOLDOFF_MS  1000    // Como máximo un aviso por segundo
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[LOOP_MON_BUCKETS];
+} loop_histogram_t;
+
+void loop_monitor_init(void);
+void loop_monitor_iteration(void);
+void loop_monitor_section(loop_section_t section);
+uint32_t loop_monitor_now(void);
+void loop_monitor_key_latency(uint32_t exti_timestamp);
+void loop_monitor_set_alarm(uint32_t threshold_us);
+uint32_t loop_monitor_get_alarm(void);
+void loop_monitor_dump(void);
+
+#endif // LOOP_MONITOR_H
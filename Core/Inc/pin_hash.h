@@ -0,0 +1,47 @@
+#ifndef PIN_HASH_H
+#define PIN_HASH_H
+
+/**
+ * Clave del keypad guardada como hash con sal.
+ *
+ * hash = SipHash-2-4(clave del equipo, sal | largo | dígitos rellenados
+ * con 0 hasta PIN_LENGTH_MAX). La clave de 128 bits del equipo se deriva
+ * del UID de 96 bits del STM32 (HAL_GetUIDw0..2), así que un volcado de la
+ * flash de un equipo no sirve para probar claves fuera de él, y la sal
+ * (nueva en cada cambio) hace que dos equipos o dos cambios con la misma
+ * clave no den el mismo hash.
+ *
+ * La verificación siempre hashea el mismo bloque de 13 bytes y compara
+ * los 8 bytes completos, sin salir en la primera diferencia: el tiempo no
+ * depende de cuántos dígitos coinciden. En un L476 a 80 MHz es del orden
+ * de unos µs; PIN_VERIFY_BUDGET_US es el límite que debe respetar (sonda
+ * PROF_PIN_VERIFY en GET_PROF, caso pin/verify del benchmark de host).
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PIN_LENGTH_MIN          4U
+#define PIN_LENGTH_MAX          8U
+#define PIN_HASH_SALT_LEN       4U
+#define PIN_HASH_LEN            8U
+#define PIN_VERIFY_BUDGET_US    50U     // De tecla a resultado, sin el display
+
+// Así se guarda en config_store (CONFIG_KEY_PASSWORD)
+typedef struct {
+    uint8_t length;                     // Dígitos de la clave
+    uint8_t reserved[3];
+    uint8_t salt[PIN_HASH_SALT_LEN];
+    uint8_t hash[PIN_HASH_LEN];
+} pin_hash_t;
+
+bool pin_hash_valid_pin(const char *pin, uint8_t length);
+bool pin_hash_create(pin_hash_t *stored, const char *pin, uint8_t length);
+bool pin_hash_verify(const pin_hash_t *stored, const char *pin, uint8_t length);
+bool pin_hash_check_format(const pin_hash_t *stored);
+uint64_t pin_hash_digest(const uint8_t salt[PIN_HASH_SALT_LEN], const char *pin, uint8_t length);
+void pin_hash_new_salt(uint8_t salt[PIN_HASH_SALT_LEN]);
+uint64_t pin_hash_siphash(const uint8_t key[16], const uint8_t *data, uint32_t len);
+
+#endif // PIN_HASH_H
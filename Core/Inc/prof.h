@@ -0,0 +1,114 @@
+#ifndef PROF_H
+#define PROF_H
+
+/**
+ * Perfilado por ciclos con el contador DWT->CYCCNT del Cortex-M4.
+ *
+ * Cada sonda (prof_probe_t) acumula conteo, mínimo, máximo, suma y un
+ * histograma logarítmico para estimar percentiles. Uso:
+ *
+ *     PROF_BEGIN(PROF_ROOM_UPDATE);
+ *     ...
+ *     PROF_END(PROF_ROOM_UPDATE);
+ *
+ * o PROF_SCOPE(probe) al inicio de un bloque con varios return.
+ * Sin PROF_ENABLED todas las macros desaparecen.
+ */
+
+#include "main.h"
+#include <stdint.h>
+
+// Sondas instrumentadas
+typedef enum {
+    PROF_ROOM_UPDATE,       // room_control_update()
+    PROF_ROOM_DISPLAY,      // room_control_update_display()
+    PROF_SSD1306_UPDATE,    // ssd1306_UpdateScreen()
+    PROF_TEMP_READ,         // temperature_sensor_read()
+    PROF_PIN_VERIFY,        // pin_hash_verify() al confirmar la clave
+    PROF_PROBE_COUNT
+} prof_probe_t;
+
+// Histograma: 4 sub-intervalos por potencia de 2 (error < 25 %)
+#define PROF_SUB_BITS       2
+#define PROF_BUCKETS        ((32 - PROF_SUB_BITS + 1) << PROF_SUB_BITS)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t buckets[PROF_BUCKETS];
+} prof_stats_t;
+
+// Lectura del contador de ciclos (el build de host la redefine)
+#ifndef PROF_CYCLES
+#define PROF_CYCLES() (DWT->CYCCNT)
+#endif
+
+#ifdef PROF_ENABLED
+
+extern prof_stats_t prof_stats[PROF_PROBE_COUNT];
+
+/**
+ * @brief Índice del histograma para una duración en ciclos.
+ */
+static inline uint32_t prof_bucket(uint32_t cycles)
+{
+    if (cycles < (1u << PROF_SUB_BITS)) {
+        return cycles;
+    }
+    uint32_t msb = 31u - (uint32_t)__builtin_clz(cycles);
+    uint32_t sub = (cycles >> (msb - PROF_SUB_BITS)) & ((1u << PROF_SUB_BITS) - 1u);
+    return ((msb - PROF_SUB_BITS + 1u) << PROF_SUB_BITS) + sub;
+}
+
+static inline void prof_record(prof_probe_t probe, uint32_t cycles)
+{
+    prof_stats_t *s = &prof_stats[probe];
+
+    if (s->count == 0 || cycles < s->min) {
+        s->min = cycles;
+    }
+    if (cycles > s->max) {
+        s->max = cycles;
+    }
+    s->count++;
+    s->sum += cycles;
+    s->buckets[prof_bucket(cycles)]++;
+}
+
+// Medición abierta por PROF_SCOPE; se cierra al salir del bloque
+typedef struct {
+    uint32_t start;
+    prof_probe_t probe;
+} prof_scope_t;
+
+static inline void prof_scope_end(const prof_scope_t *scope)
+{
+    prof_record(scope->probe, PROF_CYCLES() - scope->start);
+}
+
+#define PROF_BEGIN(probe)   uint32_t prof_start_##probe = PROF_CYCLES()
+#define PROF_END(probe)     prof_record((probe), PROF_CYCLES() - prof_start_##probe)
+#define PROF_SCOPE(probe) \
+    prof_scope_t prof_scope_##probe __attribute__((cleanup(prof_scope_end))) = { PROF_CYCLES(), (probe) }
+
+void prof_init(void);
+void prof_reset(void);
+uint32_t prof_percentile(prof_probe_t probe, uint32_t percent);
+const char *prof_name(prof_probe_t probe);
+void prof_dump(void);
+
+#else
+
+#define PROF_BEGIN(probe)   ((void)0)
+#define PROF_END(probe)     ((void)0)
+#define PROF_SCOPE(probe)   ((void)0)
+
+#define prof_init()         ((void)0)
+#define prof_reset()        ((void)0)
+#define prof_dump()         ((void)0)
+
+#endif // PROF_ENABLED
+
+#endif // PROF_H
@@ -0,0 +1,65 @@
+#ifndef PUBLISHER_H
+#define PUBLISHER_H
+
+/**
+ * Publicación periódica de la telemetría por USART3 (ESP-01 con esp-link).
+ *
+ * Cada interval_s / samples se toma una muestra (temperatura, duty del
+ * ventilador, puerta y estado) y, cuando el lote tiene samples muestras,
+ * sale en un solo mensaje con HAL_UART_Transmit_IT(): el superloop no
+ * espera a la UART. Si la transmisión anterior sigue en curso el lote se
+ * guarda y se reintenta en la vuelta siguiente.
+ *
+ * Formato SN (por defecto): un PUBLISH de MQTT-SN con QoS -1 y tópico
+ * predefinido, que un gateway MQTT-SN acepta sin CONNECT ni REGISTER
+ * (trama en sn_link.h):
+ *   largo | 0x0C | 0x61 | tópico (16) | msg id 0 (16) | datos
+ * Datos, big endian:
+ *   seq (16) | período en décimas de s (16) | tiempo (32) | n (8) | n x muestra
+ *   muestra: temperatura en décimas de °C (int16) | duty / 4 | flags
+ *   flags: bits 0-2 estado, bit 3 puerta bloqueada
+ * tiempo es el de la última muestra (rtc_clock_timestamp(): hora Unix, o
+ * segundos desde el arranque si el RTC no está en hora); las anteriores
+ * van un período antes cada una.
+ *
+ * Formato TXT: una línea por lote para un broker en modo texto,
+ *   PUB room/telemetry seq=N dt=MS t=TIEMPO t,duty,puerta,estado;...\r\n
+ *
+ * Host/tools/esp_link_stub.py hace de esp-link en Linux: decodifica los
+ * mensajes y los reenvía por UDP a un gateway MQTT-SN.
+ */
+
+#include "main.h"
+#include "room_control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PUBLISHER_BATCH_MAX         16U
+#define PUBLISHER_INTERVAL_MAX_S    3600U
+#define PUBLISHER_DEFAULT_INTERVAL  60U     // s
+#define PUBLISHER_DEFAULT_SAMPLES   6U      // Una muestra cada 10 s
+#define PUBLISHER_TOPIC_ID          0x0001U // Tópico predefinido en el gateway
+#define PUBLISHER_TOPIC_NAME        "room/telemetry"
+
+typedef enum {
+    PUBLISHER_FORMAT_SN = 0,
+    PUBLISHER_FORMAT_TXT = 1
+} publisher_format_t;
+
+typedef struct {
+    uint32_t interval_s;      // 0 = deshabilitado
+    uint32_t samples;         // Muestras por mensaje
+    publisher_format_t format;
+    uint32_t sent;            // Mensajes entregados a la UART
+    uint32_t bytes;
+    uint32_t busy;            // Vueltas en que la UART seguía transmitiendo
+    uint32_t dropped;         // Muestras descartadas por lote lleno
+} publisher_stats_t;
+
+void publisher_init(void);
+bool publisher_configure(uint32_t interval_s, uint32_t samples);
+void publisher_set_format(publisher_format_t format);
+void publisher_poll(room_control_t *room);
+void publisher_get_stats(publisher_stats_t *stats);
+
+#endif // PUBLISHER_H
@@ -2,59 +2,186 @@
 #define ROOM_CONTROL_H
 
 #include "main.h"
+#include "fan_pid.h"
+#include "pin_hash.h"
+#include "user_table.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
-#define PASSWORD_LENGTH 4
 #define MAX_TEMP_READINGS 5
 
+// Umbrales del modo por niveles: OFF < bajo <= LOW < medio <= MED < alto <= HIGH
+#define ROOM_THRESHOLD_COUNT 3
+
+// Capacidad de la cola de eventos (potencia de 2)
+#define ROOM_EVENT_QUEUE_LEN 16
+
+// Bloqueo del keypad por claves incorrectas consecutivas: desde la
+// ROOM_LOCKOUT_ATTEMPTS-ésima cada fallo impone una espera que se duplica
+// (BASE, 2*BASE, ...) hasta ROOM_LOCKOUT_MAX_MS
+#define ROOM_LOCKOUT_ATTEMPTS 3
+#define ROOM_LOCKOUT_BASE_MS  30000U    // 30 s
+#define ROOM_LOCKOUT_MAX_MS   960000U   // 16 min
+
 typedef enum {
     ROOM_STATE_LOCKED,
     ROOM_STATE_UNLOCKED,
     ROOM_STATE_INPUT_PASSWORD,
     ROOM_STATE_ACCESS_DENIED,
-    ROOM_STATE_EMERGENCY
+    ROOM_STATE_EMERGENCY,
+    ROOM_STATE_COUNT
 } room_state_t;
 
 typedef enum {
     FAN_LEVEL_OFF = 0,    // 0% PWM
-    FAN_LEVEL_LOW = 30,   // 30% PWM  
+    FAN_LEVEL_LOW = 30,   // 30% PWM
     FAN_LEVEL_MED = 70,   // 70% PWM
     FAN_LEVEL_HIGH = 100  // 100% PWM
 } fan_level_t;
 
+// Modo automático del ventilador
+typedef enum {
+    FAN_MODE_LEVELS,   // 4 niveles discretos por umbrales de temperatura
+    FAN_MODE_PID       // Lazo cerrado continuo hacia un setpoint
+} fan_mode_t;
+
+// Perfil de clima de la programación horaria (schedule.h). Reemplaza al
+// modo, setpoint y umbrales guardados mientras está activo, y acota el
+// duty automático a fan_min..fan_max. Así se guarda en config_store.
+typedef struct {
+    uint8_t fan_mode;          // fan_mode_t
+    uint8_t fan_min;           // %
+    uint8_t fan_max;           // %
+    uint8_t reserved;
+    int16_t setpoint;          // centésimas de °C (modo PID)
+    int16_t thresholds[ROOM_THRESHOLD_COUNT];   // centésimas de °C (modo por niveles)
+} room_profile_t;
+
+// Tipos de evento que consume la máquina de estados
+typedef enum {
+    ROOM_EVENT_KEY,          // Tecla del keypad
+    ROOM_EVENT_TEMPERATURE,  // Nueva muestra de temperatura
+    ROOM_EVENT_TIMEOUT,      // Venció el plazo del estado actual
+    ROOM_EVENT_COMMAND,      // Comando remoto (USART2 / USART3)
+    ROOM_EVENT_COUNT
+} room_event_type_t;
+
+// Comandos remotos que modifican el estado del sistema
+typedef enum {
+    ROOM_CMD_FORCE_FAN,
+    ROOM_CMD_SET_PASSWORD,
+    ROOM_CMD_SET_SETPOINT,
+    ROOM_CMD_SET_FAN_MODE,
+    ROOM_CMD_SET_THRESHOLDS,
+    ROOM_CMD_APPLY_PROFILE,    // Perfil de la programación (no se guarda)
+    ROOM_CMD_CLEAR_PROFILE     // Vuelve a la configuración guardada
+} room_command_id_t;
+
+typedef struct {
+    room_command_id_t id;
+    union {
+        fan_level_t fan_level;
+        char password[PIN_LENGTH_MAX + 1];
+        int32_t setpoint;      // centésimas de °C
+        fan_mode_t fan_mode;
+        int16_t thresholds[ROOM_THRESHOLD_COUNT];   // centésimas de °C
+        room_profile_t profile;
+    };
+} room_command_t;
+
+typedef struct {
+    room_event_type_t type;
+    uint32_t timestamp;
+    union {
+        char key;
+        float temperature;
+        room_command_t command;
+    };
+} room_event_t;
+
 typedef struct {
     room_state_t current_state;
-    char password[PASSWORD_LENGTH + 1];
-    char input_buffer[PASSWORD_LENGTH + 1];
+    pin_hash_t password;           // Clave maestra (usuario 0, admin); solo el hash
+    user_t user;                   // Quién desbloqueó por última vez
+    char input_buffer[PIN_LENGTH_MAX + 1];
     uint8_t input_index;
     uint32_t last_input_time;
     uint32_t state_enter_time;
-    
+
+    // Plazo del estado actual (INPUT_PASSWORD / ACCESS_DENIED)
+    bool timeout_armed;
+    uint32_t timeout_deadline;
+
+    // Bloqueo por claves incorrectas (el contador se guarda en la flash
+    // para que un reset no lo borre)
+    uint8_t failed_attempts;
+    bool lockout_active;
+    uint32_t lockout_until;
+    uint32_t lockout_shown_s;      // Segundos restantes en pantalla
+
     // Door control
     bool door_locked;
-    
-    // Temperature and fan control  
+
+    // Temperature and fan control
     float current_temperature;
     fan_level_t current_fan_level;
     bool manual_fan_override;
-    
+    uint16_t fan_duty;             // duty aplicado, en por mil
+
+    // Filtro de temperatura (promedio móvil) y lazo PID
+    float temp_readings[MAX_TEMP_READINGS];
+    uint8_t temp_count;
+    uint8_t temp_index;
+    fan_mode_t fan_mode;
+    int32_t setpoint;              // centésimas de °C
+    int16_t thresholds[ROOM_THRESHOLD_COUNT];   // centésimas de °C, ascendentes
+    fan_pid_t pid;
+    uint32_t next_control_time;
+    bool profile_active;           // Hay un perfil de la programación aplicado
+    uint16_t fan_min;              // Rango del duty automático, en por mil
+    uint16_t fan_max;
+
     // Display update flags
     bool display_update_needed;
+
+    // Cola de eventos: la llenan el superloop y las ISR de UART,
+    // la vacía room_control_update() en orden de llegada
+    room_event_t event_queue[ROOM_EVENT_QUEUE_LEN];
+    volatile uint8_t event_head;
+    volatile uint8_t event_tail;
+    uint32_t events_dropped;
 } room_control_t;
 
 // Public functions
 void room_control_init(room_control_t *room);
 void room_control_update(room_control_t *room);
+bool room_control_post_event(room_control_t *room, const room_event_t *event);
 void room_control_process_key(room_control_t *room, char key);
 void room_control_set_temperature(room_control_t *room, float temperature);
 void room_control_force_fan_level(room_control_t *room, fan_level_t level);
 void room_control_change_password(room_control_t *room, const char *new_password);
+void room_control_set_setpoint(room_control_t *room, float setpoint);
+void room_control_set_fan_mode(room_control_t *room, fan_mode_t mode);
+bool room_control_set_thresholds(room_control_t *room, float low, float med, float high);
+void room_control_apply_profile(room_control_t *room, const room_profile_t *profile);
+int room_control_check_transitions(const uint8_t *next, size_t states, size_t inputs);
+int room_control_validate_transitions(void);
+uint32_t room_control_lockout_ms(uint8_t failed_attempts);
+bool room_control_identify(room_control_t *room, const char *pin, uint8_t length, user_t *user);
+void room_control_show_clock(room_control_t *room);
 
 // Status getters
 room_state_t room_control_get_state(room_control_t *room);
 bool room_control_is_door_locked(room_control_t *room);
 fan_level_t room_control_get_fan_level(room_control_t *room);
 float room_control_get_temperature(room_control_t *room);
+uint16_t room_control_get_fan_duty(room_control_t *room);
+fan_mode_t room_control_get_fan_mode(room_control_t *room);
+float room_control_get_setpoint(room_control_t *room);
+float room_control_get_threshold(room_control_t *room, uint8_t index);
+uint8_t room_control_get_failed_attempts(room_control_t *room);
+user_t room_control_get_user(room_control_t *room);
+uint32_t room_control_get_lockout_remaining(room_control_t *room);
 
-#endif
\ No newline at end of file
+#endif
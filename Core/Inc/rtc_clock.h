@@ -0,0 +1,75 @@
+#ifndef RTC_CLOCK_H
+#define RTC_CLOCK_H
+
+/**
+ * Hora real con el RTC del STM32L476, alimentado por el LSE de 32768 Hz.
+ *
+ * El calendario del RTC guarda UTC y está en el dominio de backup: sigue
+ * contando durante un reset. RTC_BKP_DR0 = RTC_CLOCK_BKP_MAGIC indica que
+ * ya fue puesto en hora. La hora local suma el huso (minutos, en
+ * config_store) solo al mostrarla.
+ *
+ * SET_TIME:<unix>[.<ms>][,<huso>] llega por USART3 (esp-link) o USART2 y
+ * se aplica en rtc_clock_poll(), sumando la demora desde que llegó:
+ *   - sin hora o con más de RTC_CLOCK_STEP_MS de diferencia: salto
+ *     (calendario y, para los ms, corrimiento de subsegundos en RTC_SHIFTR)
+ *   - si no, slewing: la calibración fina (RTC_CALR) acelera o frena el
+ *     reloj RTC_CLOCK_SLEW_PULSES hasta absorber la diferencia, así la
+ *     hora nunca salta ni retrocede.
+ * Entre dos sincronizaciones separadas al menos RTC_CLOCK_DRIFT_MIN_MS, lo
+ * que el reloj se desvió además de lo que corrigió el slewing es la deriva
+ * del cristal: se descuenta de la calibración base (también en
+ * config_store), que queda aplicada entre sincronizaciones.
+ *
+ * La calibración se expresa en pulsos cada 2^20 ciclos del LSE (32 s):
+ * un pulso son 0.954 ppm; positivo adelanta.
+ *
+ * La alarma A, con todos los campos enmascarados, interrumpe una vez por
+ * segundo; rtc_clock_poll() lee el calendario solo entonces y devuelve
+ * true para que la pantalla redibuje el reloj. La alarma B queda para
+ * eventos a una hora dada (rtc_clock_arm_alarm_b(), programación horaria).
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define RTC_CLOCK_BKP_MAGIC       0x52544331UL    // "RTC1"
+#define RTC_CLOCK_UNIX_MIN        946684800UL     // 2000-01-01, año 0 del RTC
+#define RTC_CLOCK_UNIX_MAX        4102444799UL    // 2099-12-31 23:59:59
+#define RTC_CLOCK_STEP_MS         1000U
+#define RTC_CLOCK_SLEW_PULSES     256             // ~244 ppm: 1 s en ~68 min
+#define RTC_CLOCK_CAL_MAX         240             // Calibración base máxima (±229 ppm)
+#define RTC_CLOCK_DRIFT_MIN_MS    3600000U
+#define RTC_CLOCK_TZ_MIN          (-720)
+#define RTC_CLOCK_TZ_MAX          840
+#define RTC_CLOCK_TEXT_LEN        20U             // "AAAA-MM-DD hh:mm:ss"
+
+typedef struct {
+    bool set;                 // Calendario puesto en hora
+    int16_t tz_min;
+    uint32_t syncs;
+    uint32_t steps;
+    int32_t last_offset_ms;   // Diferencia medida en la última sincronización
+    int32_t slew_left_ms;     // Lo que falta absorber
+    int32_t base_pulses;      // Calibración por la deriva medida
+    uint32_t alarms;          // Interrupciones de la alarma A
+} rtc_clock_stats_t;
+
+void rtc_clock_init(void);
+bool rtc_clock_request_sync(uint32_t unix_s, uint16_t ms, bool has_tz, int16_t tz_min);
+bool rtc_clock_poll(void);
+void rtc_clock_on_alarm(void);
+bool rtc_clock_is_set(void);
+uint32_t rtc_clock_now(void);
+uint32_t rtc_clock_timestamp(void);
+uint32_t rtc_clock_local_seconds_of_day(void);
+uint32_t rtc_clock_local_now(void);
+uint32_t rtc_clock_generation(void);
+bool rtc_clock_arm_alarm_b(uint32_t unix_s);
+void rtc_clock_disarm_alarm_b(void);
+void rtc_clock_format(uint32_t unix_s, bool local, char *text, size_t len);
+void rtc_clock_get_stats(rtc_clock_stats_t *stats);
+
+#endif // RTC_CLOCK_H
@@ -0,0 +1,72 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+/**
+ * Programación horaria semanal de perfiles de clima.
+ *
+ * Un perfil (room_profile_t) fija el modo del ventilador, el setpoint o
+ * los umbrales y el rango de duty permitido. Una entrada dice desde qué
+ * hora local (HH:MM) y qué días de la semana rige un perfil; el perfil
+ * sigue vigente hasta la próxima entrada, aunque sea de otro día. Sin
+ * entradas (o sin hora en el RTC) vale la configuración guardada
+ * (FAN_MODE, SET_POINT, SET_THRESH); esos comandos, con un perfil vigente,
+ * cambian la guardada y también la actual hasta el próximo cambio.
+ *
+ * Las entradas se compilan, solo cuando cambian, en una tabla ordenada de
+ * cambios por minuto de la semana (lunes 00:00 = 0): si dos entradas caen
+ * en el mismo minuto gana la de número mayor, y los cambios que repiten el
+ * perfil anterior se descartan. La alarma B del RTC se arma a la hora del
+ * próximo cambio; al dispararse, schedule_poll() pasa al siguiente de la
+ * tabla y arma el que sigue: O(1), sin recorrer la programación ni leer el
+ * calendario. La búsqueda binaria del cambio vigente solo se hace al editar
+ * la programación o cuando la hora o el huso saltan (rtc_clock_generation()).
+ *
+ * Perfiles y entradas se guardan en config_store (CONFIG_KEY_PROFILES_x,
+ * CONFIG_KEY_SCHEDULE_x). Los comandos llegan desde la ISR de la UART y se
+ * aplican en schedule_poll() (superloop), que escribe la flash y responde.
+ */
+
+#include "main.h"
+#include "room_control.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHEDULE_PROFILES       4U
+#define SCHEDULE_ENTRIES        16U
+#define SCHEDULE_NO_PROFILE     0xFFU     // Configuración guardada
+#define SCHEDULE_ALL_DAYS       0x7FU     // Bit 0 = lunes ... bit 6 = domingo
+#define SCHEDULE_WEEK_MIN       10080U    // Minutos de una semana
+#define SCHEDULE_FAN_MIN_GAP    10U       // fan_max - fan_min mínimo, en %
+
+// Una entrada tal como se guarda en la flash; days == 0 es un hueco libre
+typedef struct {
+    uint8_t days;               // Máscara SCHEDULE_ALL_DAYS
+    uint8_t profile;
+    uint16_t minute;            // Minuto del día, hora local
+} schedule_entry_t;
+
+typedef struct {
+    uint8_t entries;
+    uint8_t transitions;        // Cambios por semana tras compilar
+    uint8_t active;             // Perfil vigente o SCHEDULE_NO_PROFILE
+    uint32_t next_unix;         // Alarma B armada (0 = ninguna)
+    uint32_t alarms;            // Cambios por la alarma B (O(1))
+    uint32_t searches;          // Búsquedas completas
+} schedule_stats_t;
+
+void schedule_init(void);
+bool schedule_request_pid(uint8_t profile, int16_t setpoint);
+bool schedule_request_levels(uint8_t profile, const int16_t thresholds[ROOM_THRESHOLD_COUNT]);
+bool schedule_request_fan(uint8_t profile, uint8_t fan_min, uint8_t fan_max);
+bool schedule_request_add(uint8_t days, uint16_t minute, uint8_t profile);
+bool schedule_request_delete(uint8_t index);
+bool schedule_request_clear(void);
+bool schedule_request_list(void);
+bool schedule_poll(void);
+void schedule_on_alarm(void);
+const room_profile_t *schedule_active_profile(void);
+void schedule_get_stats(schedule_stats_t *stats);
+bool schedule_parse_days(const char *text, uint8_t *days);
+void schedule_format_days(uint8_t days, char text[8]);
+
+#endif // SCHEDULE_H
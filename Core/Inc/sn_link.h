@@ -0,0 +1,38 @@
+#ifndef SN_LINK_H
+#define SN_LINK_H
+
+/**
+ * Mensajes MQTT-SN sobre USART3 (ESP-01 con esp-link).
+ *
+ * En la UART cada mensaje va entre un STX y un CRC-8 para encontrarlo en
+ * el flujo, que también lleva líneas de comando en texto:
+ *   0x02 | mensaje MQTT-SN (largo de un byte, cuenta desde sí mismo) | crc
+ * El crc-8 (polinomio 0x07, valor inicial 0) cubre el mensaje completo.
+ * Los comandos de texto nunca llevan 0x02.
+ *
+ * Hacia el dispositivo solo se interpretan PUBACK (los de alert.c); el
+ * resto de los bytes sigue al parser de comandos.
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SN_LINK_STX             0x02U
+#define SN_LINK_RX_TIMEOUT_MS   50U     // Silencio que descarta una trama a medias
+
+// Tipos de mensaje MQTT-SN que se usan
+#define SN_MSG_PUBLISH          0x0CU
+#define SN_MSG_PUBACK           0x0DU
+
+// Flags de PUBLISH: tópico predefinido con QoS -1 o 1, DUP en reenvíos
+#define SN_FLAG_TOPIC_PREDEF    0x01U
+#define SN_FLAG_QOS_1           0x20U
+#define SN_FLAG_QOS_M1          0x60U
+#define SN_FLAG_DUP             0x80U
+
+uint8_t sn_link_crc8(const uint8_t *data, uint16_t len);
+uint16_t sn_link_seal(uint8_t *frame);
+bool sn_link_rx_byte(uint8_t byte);
+
+#endif // SN_LINK_H
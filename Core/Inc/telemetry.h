@@ -0,0 +1,76 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+/**
+ * Registro de telemetría en RAM: una muestra por TELEMETRY_PERIOD_MS con
+ * temperatura, duty del ventilador, estado y eventos ocurridos en el
+ * período, para analizar el comportamiento de la sala después.
+ *
+ * Las muestras se guardan en bloques de TELEMETRY_BLOCK_SIZE bytes: una
+ * cabecera con el tiempo y la temperatura absolutos y registros de 32 bits
+ * con la temperatura en delta. Una muestra idéntica a la anterior solo
+ * incrementa el contador de repeticiones del último registro, así que los
+ * períodos estables casi no ocupan lugar. Los bloques forman un anillo:
+ * al llenarse se pisa el más viejo.
+ *
+ * El tiempo de la cabecera es rtc_clock_timestamp(): hora Unix, o segundos
+ * desde el arranque si el RTC todavía no está en hora.
+ *
+ * El anillo vive en SRAM2 (sección .telemetry, sin inicializar): un reset
+ * no lo borra y telemetry_init() lo retoma si la cabecera es válida.
+ *
+ * TLM_DUMP lo vuelca por USART2 en líneas hexadecimales, un bloque por
+ * vuelta del superloop; Host/tools/telemetry_decode.py lo pasa a CSV.
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TELEMETRY_PERIOD_MS     1000U
+#define TELEMETRY_BLOCK_SIZE    128U
+#define TELEMETRY_BLOCKS        128U    // 16 KB de los 32 KB de SRAM2
+#define TELEMETRY_BLOCK_RECORDS ((TELEMETRY_BLOCK_SIZE - 8U) / 4U)
+
+// Sección del anillo (el build de host puede redefinirla)
+#ifndef TELEMETRY_SECTION
+#define TELEMETRY_SECTION __attribute__((section(".telemetry")))
+#endif
+
+/*
+ * Registro (little endian):
+ *   bits  0-7   delta de temperatura, int8, décimas de °C
+ *   bits  8-15  duty del ventilador / 4 (0..250)
+ *   bits 16-18  estado de room_control
+ *   bits 19-23  eventos (telemetry_event_t)
+ *   bits 24-31  repeticiones: períodos idénticos que siguen a este
+ * 0xFFFFFFFF marca un registro libre (duty 255 no existe).
+ */
+#define TELEMETRY_RECORD_FREE   0xFFFFFFFFUL
+
+// Eventos del período (se combinan)
+typedef enum {
+    TLM_EVT_BOOT        = 1U << 0,   // Primera muestra después de telemetry_init()
+    TLM_EVT_KEY         = 1U << 1,   // Tecla del keypad
+    TLM_EVT_COMMAND     = 1U << 2,   // Comando remoto aplicado
+    TLM_EVT_LOOP_ALARM  = 1U << 3,   // Vuelta del superloop sobre el umbral
+    TLM_EVT_QUEUE_FULL  = 1U << 4,   // room_control descartó un evento
+} telemetry_event_t;
+
+typedef struct {
+    uint32_t blocks;          // Bloques con datos
+    uint32_t records;         // Registros guardados
+    uint32_t periods;         // Muestras que representan (records + repeticiones)
+    uint32_t bytes;           // Ocupados: blocks * TELEMETRY_BLOCK_SIZE
+    bool restored;            // El anillo sobrevivió al último reset
+} telemetry_stats_t;
+
+void telemetry_init(void);
+void telemetry_sample(float temperature, uint16_t fan_duty, uint8_t state);
+void telemetry_event(telemetry_event_t event);
+void telemetry_request_dump(void);
+void telemetry_poll(void);
+void telemetry_clear(void);
+void telemetry_get_stats(telemetry_stats_t *stats);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,86 @@
+#ifndef TLOG_H
+#define TLOG_H
+
+/**
+ * Log tokenizado: TLOG(fmt, ...) en lugar de printf para los mensajes del
+ * camino rápido.
+ *
+ * El formato no se guarda en la flash ni se procesa en el MCU: queda en la
+ * sección tlog del ELF (no se carga, INFO en el linker script) y el
+ * dispositivo envía solo su desplazamiento en esa sección y los argumentos
+ * en binario. Host/tools/tlog_decode.py reconstruye el texto a partir del
+ * ELF; room_control_sim lo hace en el mismo proceso.
+ *
+ * Trama (los bytes 0x00 no aparecen en el texto de printf):
+ *   0x00 | largo | id (16 bits LE) | argumentos
+ * con largo = bytes desde id hasta el final. Argumentos según su tipo en C:
+ *   enteros  varint zigzag de 32 bits (%d %i %u %x %X %c)
+ *   float    4 bytes IEEE 754 LE      (%f, también para double)
+ *   char *   largo varint + bytes     (%s, hasta TLOG_STR_MAX)
+ * Además del printf normal, el formato acepta %{A|B|C}: el argumento
+ * entero elige uno de los textos (para enums) sin enviarlo.
+ *
+ * Las tramas se encolan en un buffer de TX que tlog_flush() envía por
+ * USART2 desde el superloop (y antes de cada printf, para no desordenar).
+ */
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TLOG_TX_BUFFER_LEN  512U     // Potencia de 2
+#define TLOG_FRAME_MAX      48U
+#define TLOG_STR_MAX        16U
+#define TLOG_SYNC           0x00U
+
+// Id del formato: su dirección en la sección tlog, que el linker ubica en 0
+// (el build de host la redefine)
+#ifndef TLOG_ID
+#define TLOG_ID(fmt) ((uint16_t)(uintptr_t)(fmt))
+#endif
+
+typedef struct {
+    uint8_t len;
+    uint8_t buf[TLOG_FRAME_MAX];
+} tlog_frame_t;
+
+void tlog_init(void);
+void tlog_frame_begin(tlog_frame_t *frame, uint16_t id);
+void tlog_arg_int(tlog_frame_t *frame, int32_t value);
+void tlog_arg_float(tlog_frame_t *frame, float value);
+void tlog_arg_str(tlog_frame_t *frame, const char *value);
+void tlog_frame_end(tlog_frame_t *frame);
+void tlog_flush(void);
+uint32_t tlog_get_dropped(void);
+
+// Codificador de cada argumento según su tipo
+#define TLOG_ARG(frame, x) _Generic((x),                     \
+        float: tlog_arg_float,                               \
+        double: tlog_arg_float,                              \
+        char *: tlog_arg_str,                                \
+        const char *: tlog_arg_str,                          \
+        default: tlog_arg_int)(frame, x);
+
+// Hasta 6 argumentos
+#define TLOG_NARGS(...) TLOG_NARGS_(_, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define TLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+#define TLOG_CAT(a, b) TLOG_CAT_(a, b)
+#define TLOG_CAT_(a, b) a##b
+#define TLOG_ARGS(frame, ...) TLOG_CAT(TLOG_ARGS_, TLOG_NARGS(__VA_ARGS__))(frame, ##__VA_ARGS__)
+#define TLOG_ARGS_0(f)
+#define TLOG_ARGS_1(f, a) TLOG_ARG(f, a)
+#define TLOG_ARGS_2(f, a, ...) TLOG_ARG(f, a) TLOG_ARGS_1(f, __VA_ARGS__)
+#define TLOG_ARGS_3(f, a, ...) TLOG_ARG(f, a) TLOG_ARGS_2(f, __VA_ARGS__)
+#define TLOG_ARGS_4(f, a, ...) TLOG_ARG(f, a) TLOG_ARGS_3(f, __VA_ARGS__)
+#define TLOG_ARGS_5(f, a, ...) TLOG_ARG(f, a) TLOG_ARGS_4(f, __VA_ARGS__)
+#define TLOG_ARGS_6(f, a, ...) TLOG_ARG(f, a) TLOG_ARGS_5(f, __VA_ARGS__)
+
+#define TLOG(fmt, ...) do {                                                      \
+        static const char tlog_fmt_[] __attribute__((section("tlog"), used)) = fmt; \
+        tlog_frame_t tlog_frame_;                                                \
+        tlog_frame_begin(&tlog_frame_, TLOG_ID(tlog_fmt_));                      \
+        TLOG_ARGS(&tlog_frame_, ##__VA_ARGS__)                                   \
+        tlog_frame_end(&tlog_frame_);                                            \
+    } while (0)
+
+#endif // TLOG_H
@@ -0,0 +1,73 @@
+#ifndef USER_TABLE_H
+#define USER_TABLE_H
+
+/**
+ * Tabla de usuarios del keypad: una clave (PIN) por persona, con rol.
+ *
+ * Es una tabla hash de direccionamiento abierto (sondeo lineal) de
+ * USER_TABLE_SLOTS ranuras de 8 bytes indexada por el hash de la clave:
+ *   h = pin_hash_digest(sal de la tabla, clave), 40 bits bajos
+ *   ranura inicial = h % USER_TABLE_SLOTS
+ * Cada ranura guarda solo h (nunca la clave), el id y el rol, así que una
+ * verificación es un hash y unas pocas comparaciones, sin recorrer la
+ * lista. Con la carga limitada a USER_TABLE_MAX_USERS (75 %) el sondeo
+ * promedio queda en ~2.5 ranuras. Las bajas corren hacia atrás las
+ * ranuras del grupo (sin lápidas), así que el sondeo no se degrada.
+ * user_table_lookup() no corta al encontrar la clave: siempre recorre el
+ * sondeo más largo de la tabla (max_probe), así cuesta lo mismo con o sin
+ * coincidencia.
+ *
+ * La tabla vive en RAM y se guarda entera en la región USERS de la flash
+ * (STM32L476RGTx_FLASH.ld), en dos copias que se alternan: se escribe la
+ * que no está vigente y su cabecera (generación y CRC) va al final, así que
+ * un reset a mitad de la escritura deja la copia anterior.
+ *
+ * Las altas y bajas llegan desde la ISR de la UART y se aplican en
+ * user_table_poll() (superloop), que es la que escribe la flash y responde.
+ *
+ * El id 0 es la clave maestra de room_control (SET_PASS), siempre admin.
+ */
+
+#include "main.h"
+#include "pin_hash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Debe coincidir con la región USERS del linker script
+#define USER_TABLE_BASE         0x080FA000UL
+#define USER_TABLE_COPY_SIZE    8192U           // Cada copia: 4 páginas de 2 KB
+#define USER_TABLE_SLOTS        512U            // Potencia de 2
+#define USER_TABLE_MAX_USERS    384U
+#define USER_ID_MASTER          0U
+#define USER_ID_MAX             9999U
+
+// No reordenar: el valor queda en la flash
+typedef enum {
+    USER_ROLE_NONE = 0,       // Ranura libre / sin sesión
+    USER_ROLE_USER = 1,       // Solo desbloquea
+    USER_ROLE_ADMIN = 2       // Además SET_PASS, FORCE_FAN y USER_*
+} user_role_t;
+
+typedef struct {
+    uint16_t id;
+    user_role_t role;
+} user_t;
+
+typedef struct {
+    uint32_t users;
+    uint32_t max_probe;       // Sondeo más largo de la tabla actual
+    uint32_t generation;      // Escrituras de la tabla desde que se creó
+    uint32_t write_errors;
+    uint32_t lookups;
+} user_table_stats_t;
+
+void user_table_init(void);
+bool user_table_lookup(const char *pin, uint8_t length, user_t *user);
+bool user_table_request_add(uint16_t id, user_role_t role, const char *pin, uint8_t length);
+bool user_table_request_delete(uint16_t id);
+bool user_table_request_list(void);
+void user_table_poll(void);
+void user_table_get_stats(user_table_stats_t *stats);
+const char *user_role_name(user_role_t role);
+
+#endif // USER_TABLE_H
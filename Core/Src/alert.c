@@ -0,0 +1,264 @@
+#include "alert.h"
+#include "config_store.h"
+#include "sn_link.h"
+#include "rtc_clock.h"
+#include <string.h>
+
+#define ALERT_SLOTS_PER_KEY     4U
+#define ALERT_KEYS              (ALERT_QUEUE_LEN / ALERT_SLOTS_PER_KEY)
+#define ALERT_MSG_LEN           12U     // Cabecera PUBLISH (7) + tipo + tiempo
+
+extern UART_HandleTypeDef huart3;
+
+typedef enum {
+    ALERT_SLOT_FREE = 0,
+    ALERT_SLOT_PENDING = 1,
+    ALERT_SLOT_ACKED = 2
+} alert_slot_status_t;
+
+// Una alerta tal como se guarda en la flash
+typedef struct {
+    uint16_t id;
+    uint8_t type;
+    uint8_t status;
+    uint32_t time_s;
+} alert_entry_t;
+
+_Static_assert(sizeof(alert_entry_t) * ALERT_SLOTS_PER_KEY <= CONFIG_STORE_VALUE_MAX, "alertas por clave");
+_Static_assert(CONFIG_KEY_ALERTS_0 + ALERT_KEYS - 1U == CONFIG_KEY_ALERTS_1, "claves de alertas");
+
+static struct {
+    alert_entry_t queue[ALERT_QUEUE_LEN];
+    uint16_t next_id;
+    uint8_t dirty;              // Bit por clave de config_store a reescribir
+
+    // Alerta en vuelo (una a la vez, la más vieja)
+    int8_t inflight;            // Slot, -1 si no hay
+    bool need_send;             // Toca (re)enviarla apenas la UART esté libre
+    bool dup;
+    uint32_t sent_at;
+    uint32_t backoff_ms;
+
+    // PUBACK recibido en la ISR, lo procesa alert_poll()
+    volatile uint16_t ack_id;
+    volatile bool ack_received;
+
+    uint32_t raised;
+    uint32_t sent;
+    uint32_t retries;
+    uint32_t acked;
+    uint32_t dropped;
+} al = { .inflight = -1 };
+
+// El buffer no se toca mientras la UART lo transmite
+static uint8_t tx_frame[ALERT_MSG_LEN + 2U];
+
+// Helpers privados
+
+// Antigüedad de un id respecto al próximo (ids de 16 bits que dan la vuelta)
+static uint16_t alert_age(uint16_t id)
+{
+    return (uint16_t)(al.next_id - id);
+}
+
+static void alert_mark_dirty(uint8_t slot)
+{
+    al.dirty |= (uint8_t)(1U << (slot / ALERT_SLOTS_PER_KEY));
+}
+
+static void alert_persist(void)
+{
+    for (uint8_t k = 0; k < ALERT_KEYS; k++) {
+        if (al.dirty & (1U << k)) {
+            config_store_set((config_key_t)(CONFIG_KEY_ALERTS_0 + k), &al.queue[k * ALERT_SLOTS_PER_KEY],
+                             (uint16_t)(sizeof(alert_entry_t) * ALERT_SLOTS_PER_KEY));
+        }
+    }
+    al.dirty = 0;
+}
+
+// Slot con el estado pedido y el id más viejo, -1 si no hay
+static int8_t alert_oldest(alert_slot_status_t status)
+{
+    int8_t best = -1;
+    for (uint8_t i = 0; i < ALERT_QUEUE_LEN; i++) {
+        if (al.queue[i].status == status &&
+            (best < 0 || alert_age(al.queue[i].id) > alert_age(al.queue[best].id))) {
+            best = (int8_t)i;
+        }
+    }
+    return best;
+}
+
+static void alert_handle_ack(uint16_t id)
+{
+    for (uint8_t i = 0; i < ALERT_QUEUE_LEN; i++) {
+        if (al.queue[i].status == ALERT_SLOT_PENDING && al.queue[i].id == id) {
+            al.queue[i].status = ALERT_SLOT_ACKED;
+            alert_mark_dirty(i);
+            al.acked++;
+            if (al.inflight == (int8_t)i) {
+                al.inflight = -1;
+            }
+            return;
+        }
+    }
+}
+
+static bool alert_send(const alert_entry_t *entry)
+{
+    if (huart3.gState != HAL_UART_STATE_READY) {
+        return false;   // Publicando telemetría: en la próxima vuelta
+    }
+
+    uint8_t *p = &tx_frame[1];
+    *p++ = ALERT_MSG_LEN;
+    *p++ = SN_MSG_PUBLISH;
+    *p++ = SN_FLAG_QOS_1 | SN_FLAG_TOPIC_PREDEF | (al.dup ? SN_FLAG_DUP : 0U);
+    *p++ = (uint8_t)(ALERT_TOPIC_ID >> 8);
+    *p++ = (uint8_t)ALERT_TOPIC_ID;
+    *p++ = (uint8_t)(entry->id >> 8);
+    *p++ = (uint8_t)entry->id;
+    *p++ = entry->type;
+    *p++ = (uint8_t)(entry->time_s >> 24);
+    *p++ = (uint8_t)(entry->time_s >> 16);
+    *p++ = (uint8_t)(entry->time_s >> 8);
+    *p++ = (uint8_t)entry->time_s;
+
+    return HAL_UART_Transmit_IT(&huart3, tx_frame, sn_link_seal(tx_frame)) == HAL_OK;
+}
+
+// API pública
+
+/**
+ * @brief Recupera la cola guardada (después de config_store_init()); las
+ * pendientes se reenvían desde la primera alert_poll().
+ */
+void alert_init(void)
+{
+    memset(&al, 0, sizeof(al));
+    al.inflight = -1;
+
+    for (uint8_t k = 0; k < ALERT_KEYS; k++) {
+        alert_entry_t *slots = &al.queue[k * ALERT_SLOTS_PER_KEY];
+        if (!config_store_get((config_key_t)(CONFIG_KEY_ALERTS_0 + k), slots,
+                              (uint16_t)(sizeof(alert_entry_t) * ALERT_SLOTS_PER_KEY))) {
+            memset(slots, 0, sizeof(alert_entry_t) * ALERT_SLOTS_PER_KEY);
+        }
+    }
+
+    // Próximo id: después del más nuevo guardado (el que ningún otro supera)
+    bool found = false;
+    for (uint8_t i = 0; i < ALERT_QUEUE_LEN; i++) {
+        if (al.queue[i].status > ALERT_SLOT_ACKED) {
+            al.queue[i].status = ALERT_SLOT_FREE;
+        } else if (al.queue[i].status != ALERT_SLOT_FREE &&
+                   (!found || (int16_t)(al.queue[i].id - al.next_id) >= 0)) {
+            al.next_id = (uint16_t)(al.queue[i].id + 1U);
+            found = true;
+        }
+    }
+    if (al.next_id == 0) {
+        al.next_id = 1;
+    }
+}
+
+/**
+ * @brief Encola una alerta. Llamar desde el superloop (la máquina de estados).
+ */
+void alert_raise(alert_type_t type)
+{
+    int8_t slot = alert_oldest(ALERT_SLOT_FREE);
+    if (slot < 0) {
+        slot = alert_oldest(ALERT_SLOT_ACKED);
+    }
+    if (slot < 0) {
+        slot = alert_oldest(ALERT_SLOT_PENDING);
+        al.dropped++;
+        if (al.inflight == slot) {
+            al.inflight = -1;
+        }
+    }
+
+    alert_entry_t *entry = &al.queue[slot];
+    entry->id = al.next_id++;
+    if (al.next_id == 0) {
+        al.next_id = 1;   // Msg id 0 no vale con QoS 1
+    }
+    entry->type = (uint8_t)type;
+    entry->status = ALERT_SLOT_PENDING;
+    entry->time_s = rtc_clock_timestamp();
+    alert_mark_dirty((uint8_t)slot);
+    al.raised++;
+}
+
+/**
+ * @brief Guarda los cambios de la cola, procesa el PUBACK recibido y envía
+ * o reenvía la alerta en vuelo sin bloquear. Llamar en cada vuelta del
+ * superloop.
+ */
+void alert_poll(void)
+{
+    if (al.ack_received) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        uint16_t id = al.ack_id;
+        al.ack_received = false;
+        __set_PRIMASK(primask);
+        alert_handle_ack(id);
+    }
+    if (al.dirty != 0) {
+        alert_persist();
+    }
+
+    uint32_t now = HAL_GetTick();
+    if (al.inflight < 0) {
+        al.inflight = alert_oldest(ALERT_SLOT_PENDING);
+        if (al.inflight < 0) {
+            return;
+        }
+        al.need_send = true;
+        al.dup = false;
+        al.backoff_ms = ALERT_ACK_TIMEOUT_MS;
+    } else if (!al.need_send && now - al.sent_at >= al.backoff_ms) {
+        // Sin PUBACK a tiempo: reenvío con el doble de espera
+        al.backoff_ms = (al.backoff_ms * 2U > ALERT_BACKOFF_MAX_MS) ? ALERT_BACKOFF_MAX_MS : al.backoff_ms * 2U;
+        al.need_send = true;
+        al.dup = true;
+        al.retries++;
+    }
+
+    if (al.need_send && alert_send(&al.queue[al.inflight])) {
+        al.need_send = false;
+        al.sent_at = now;
+        al.sent++;
+    }
+}
+
+/**
+ * @brief PUBACK recibido por USART3 (desde la ISR, vía sn_link).
+ */
+void alert_on_puback(uint16_t topic_id, uint16_t msg_id, uint8_t return_code)
+{
+    // Código distinto de 0 (congestión, tópico inválido): sigue el reintento
+    if (topic_id != ALERT_TOPIC_ID || return_code != 0U) {
+        return;
+    }
+    al.ack_id = msg_id;
+    al.ack_received = true;
+}
+
+void alert_get_stats(alert_stats_t *stats)
+{
+    stats->pending = 0;
+    for (uint8_t i = 0; i < ALERT_QUEUE_LEN; i++) {
+        stats->pending += (al.queue[i].status == ALERT_SLOT_PENDING) ? 1U : 0U;
+    }
+    stats->raised = al.raised;
+    stats->sent = al.sent;
+    stats->retries = al.retries;
+    stats->acked = al.acked;
+    stats->dropped = al.dropped;
+    stats->next_id = al.next_id;
+    stats->backoff_ms = (al.inflight >= 0) ? al.backoff_ms : 0U;
+}
@@ -0,0 +1,250 @@
+#include "app.h"
+#include "led.h"
+#include "ring_buffer.h"
+#include "ssd1306_fonts.h"
+#include "temperature_sensor.h"
+#include "command_parser.h"
+#include "prof.h"
+#include "loop_monitor.h"
+#include "i2c_bus.h"
+#include "config_store.h"
+#include "telemetry.h"
+#include "tlog.h"
+#include "publisher.h"
+#include "alert.h"
+#include "sn_link.h"
+#include "user_table.h"
+#include "rtc_clock.h"
+#include "schedule.h"
+#include <stdio.h>
+
+#define TEMP_SAMPLE_PERIOD_MS 100 // Periodo de muestreo del LM35
+
+extern I2C_HandleTypeDef hi2c1;
+extern UART_HandleTypeDef huart2;
+extern UART_HandleTypeDef huart3;
+
+uint8_t button_pressed = 0; // Flag to indicate if the button is pressed
+
+led_handle_t heartbeat_led = {
+    .port = LD2_GPIO_Port,
+    .pin = LD2_Pin
+};
+
+uint8_t usart_2_rxbyte = 0; // Variable to hold received byte from UART3
+uint8_t usart_3_rxbyte = 0; // Byte recibido del ESP-01
+
+keypad_handle_t keypad = {
+    .row_ports = {KEYPAD_R1_GPIO_Port, KEYPAD_R2_GPIO_Port, KEYPAD_R3_GPIO_Port, KEYPAD_R4_GPIO_Port},
+    .row_pins  = {KEYPAD_R1_Pin, KEYPAD_R2_Pin, KEYPAD_R3_Pin, KEYPAD_R4_Pin},
+    .col_ports = {KEYPAD_C1_GPIO_Port, KEYPAD_C2_GPIO_Port, KEYPAD_C3_GPIO_Port, KEYPAD_C4_GPIO_Port},
+    .col_pins  = {KEYPAD_C1_Pin, KEYPAD_C2_Pin, KEYPAD_C3_Pin, KEYPAD_C4_Pin}
+};
+
+#define KEYPAD_BUFFER_LEN 16
+uint8_t keypad_buffer[KEYPAD_BUFFER_LEN];
+ring_buffer_t keypad_rb;
+
+volatile uint16_t keypad_interrupt_pin = 0;
+volatile uint16_t keypad_interrupt_time = 0; // Tiempo de la interrupción
+volatile uint32_t keypad_interrupt_stamp = 0; // Marca en ciclos para medir latencia
+
+// Room control system instance
+room_control_t room_system;
+
+void write_to_oled(char *message, SSD1306_COLOR color, uint8_t x, uint8_t y)
+{
+    ssd1306_SetCursor(x, y); // Set cursor to the specified position
+    ssd1306_WriteString(message, Font_7x10, color);
+    ssd1306_UpdateScreen(); // Update the display to show the message
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    if (GPIO_Pin == B1_Pin) {
+        button_pressed = 1; // Set the flag when the button is pressed
+    } else {
+        keypad_interrupt_pin = GPIO_Pin;
+        keypad_interrupt_time = HAL_GetTick(); // Guardar el tiempo de la interrupción
+        keypad_interrupt_stamp = loop_monitor_now();
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART2) {
+        // Enviar el byte al parser de debug
+        command_parser_process_debug(usart_2_rxbyte);
+
+        // Re-armar recepción
+        HAL_UART_Receive_IT(&huart2, &usart_2_rxbyte, 1);
+    } else if (huart->Instance == USART3) {
+        // PUBACK de las alertas o comandos que llegan por esp-link
+        if (!sn_link_rx_byte(usart_3_rxbyte)) {
+            command_parser_process_esp01(usart_3_rxbyte);
+        }
+        HAL_UART_Receive_IT(&huart3, &usart_3_rxbyte, 1);
+    }
+}
+
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    rtc_clock_on_alarm();   // Una vez por segundo
+}
+
+void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    schedule_on_alarm();    // Próximo cambio de perfil de la programación
+}
+
+void heartbeat(void)
+{
+    static uint32_t last_toggle = 0;
+    if (HAL_GetTick() - last_toggle >= 500) { // Toggle every 500 ms
+        led_toggle(&heartbeat_led); // Toggle the heartbeat LED
+        last_toggle = HAL_GetTick();
+    }
+}
+
+/**
+ * @brief Inicializa los módulos de la aplicación (tras los MX_*_Init()).
+ */
+void app_init(void)
+{
+    led_init(&heartbeat_led);
+    i2c_bus_init(&hi2c1, I2C_BUS_DEFAULT_KHZ);
+    ssd1306_Init();
+    HAL_UART_Receive_IT(&huart2, &usart_2_rxbyte, 1);
+    HAL_UART_Receive_IT(&huart3, &usart_3_rxbyte, 1);
+    tlog_init();                // Antes del primer TLOG() (room_control_init)
+
+    ring_buffer_init(&keypad_rb, keypad_buffer, KEYPAD_BUFFER_LEN);
+    keypad_init(&keypad);
+
+    temperature_sensor_init();  // Inicializar módulo de temperatura (LM35)
+
+    // El DWT se habilita antes para medir el recorrido de la flash al arrancar
+    prof_init();
+    loop_monitor_init();
+
+    config_store_init();        // Configuración guardada (la lee room_control_init)
+    user_table_init();          // Claves por persona (región USERS de la flash)
+    rtc_clock_init();           // Hora del RTC (sigue contando tras un reset)
+    room_control_init(&room_system);
+    schedule_init();            // Perfiles por hora (se aplican con la hora del RTC)
+    telemetry_init();           // Retoma el log de SRAM2 si sobrevivió al reset
+    publisher_init();           // Intervalo de publicación guardado
+    alert_init();               // Alertas que quedaron sin confirmar
+
+    // Clear the display
+    ssd1306_Fill(Black);
+    printf("Sistema iniciado\r\n");
+}
+
+/**
+ * @brief Una vuelta del superloop.
+ */
+void app_loop(void)
+{
+    loop_monitor_iteration();
+
+    loop_monitor_section(LOOP_SEC_HEARTBEAT);
+    heartbeat(); // Call the heartbeat function to toggle the LED
+
+    loop_monitor_section(LOOP_SEC_ROOM);
+    i2c_bus_poll();   // Cambio de velocidad pedido por I2C_SPEED
+    room_control_update(&room_system);
+
+    loop_monitor_section(LOOP_SEC_KEYPAD);
+
+    // DEMO: Keypad functionality - Remove when implementing room control logic
+    static uint32_t last_key_time = 0;      // Guardar el tiempo de la última tecla
+    static char last_key_value = '\0';      // Guardar el valor de la última tecla
+
+    if (keypad_interrupt_pin != 0) {
+        uint32_t now = HAL_GetTick();
+
+        // Esperar un pequeño tiempo de estabilización del contacto (debounce)
+        if (now - keypad_interrupt_time >= 20) {   // ~20 ms de debounce
+
+            char key = keypad_scan(&keypad, keypad_interrupt_pin);
+            if (key != '\0') {
+
+                // Filtro extra: si es la misma tecla rebotando muy seguido, la ignoramos
+                if ((now - last_key_time > 150) || (key != last_key_value)) {
+
+                    write_to_oled(&key, White, 31, 31);
+
+                    // Debug: mostrar tecla y estado actual
+                    printf("[KEYPAD] Tecla: %c, estado actual: %d\r\n",
+                           key, room_control_get_state(&room_system));
+
+                    room_control_process_key(&room_system, key);
+                    loop_monitor_key_latency(keypad_interrupt_stamp);
+                    telemetry_event(TLM_EVT_KEY);
+
+                    last_key_time = now;
+                    last_key_value = key;
+                }
+            }
+
+            keypad_interrupt_pin = 0;
+        }
+    }
+
+    loop_monitor_section(LOOP_SEC_DEMO);
+
+    // DEMO: Button functionality - Remove when implementing room control logic
+    if (button_pressed) {
+        write_to_oled("Button Pressed!", White, 17, 17); // Display message on OLED
+        button_pressed = 0; // Reset the flag
+    }
+
+    // DEMO: UART functionality - Remove when implementing room control logic
+    if (usart_2_rxbyte != 0) {
+        write_to_oled((char *)&usart_2_rxbyte, White, 31, 31); // Display received byte on OLED
+        usart_2_rxbyte = 0; // Reset the received byte variable
+    }
+
+    loop_monitor_section(LOOP_SEC_TEMP);
+
+    static uint32_t last_temp_sample = 0;
+    if (HAL_GetTick() - last_temp_sample >= TEMP_SAMPLE_PERIOD_MS) {
+        float temperature = temperature_sensor_read();
+        room_control_set_temperature(&room_system, temperature);
+        last_temp_sample = HAL_GetTick();
+    }
+
+    loop_monitor_section(LOOP_SEC_TELEMETRY);
+
+    // Telemetría: avanza de a un período exacto para que el tiempo de cada
+    // muestra se pueda reconstruir desde la cabecera del bloque
+    static uint32_t last_telemetry_sample = 0;
+    if (HAL_GetTick() - last_telemetry_sample >= TELEMETRY_PERIOD_MS) {
+        telemetry_sample(room_control_get_temperature(&room_system),
+                         room_control_get_fan_duty(&room_system),
+                         (uint8_t)room_control_get_state(&room_system));
+        last_telemetry_sample += TELEMETRY_PERIOD_MS;
+    }
+    telemetry_poll();
+
+    loop_monitor_section(LOOP_SEC_ALERTS);
+    alert_poll();                   // Alertas primero: USART3 es de a un mensaje
+    loop_monitor_section(LOOP_SEC_USERS);
+    user_table_poll();              // USER_ADD / USER_DEL / USER_LIST pendientes
+    loop_monitor_section(LOOP_SEC_RTC);
+    if (rtc_clock_poll()) {         // SET_TIME pendiente y alarma de 1 Hz
+        room_control_show_clock(&room_system);
+    }
+    loop_monitor_section(LOOP_SEC_SCHEDULE);
+    if (schedule_poll()) {          // Alarma B o edición de la programación
+        room_control_apply_profile(&room_system, schedule_active_profile());
+    }
+    loop_monitor_section(LOOP_SEC_PUBLISH);
+    publisher_poll(&room_system);   // Lote por USART3 sin esperar a la UART
+
+    loop_monitor_section(LOOP_SEC_TLOG);
+    tlog_flush();   // Tramas de TLOG() de esta vuelta
+}
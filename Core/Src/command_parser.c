@@ -1,29 +1,191 @@
 #include "command_parser.h"
 #include "room_control.h"
+#include "fan_ramp.h"
+#include "fan_pwm.h"
+#include "prof.h"
+#include "loop_monitor.h"
+#include "ssd1306.h"
+#include "i2c_bus.h"
+#include "config_store.h"
+#include "telemetry.h"
+#include "publisher.h"
+#include "alert.h"
+#include "rtc_clock.h"
+#include "schedule.h"
 #include "main.h"
 #include <string.h>
+#include <stdbool.h>
 #include <stdio.h>
-#include <ctype.h>
 
-// Declaraciones externas de los UARTs definidos en main.c
-extern UART_HandleTypeDef huart2;
-extern UART_HandleTypeDef huart3;
+// Timer del ventilador definido en main.c (las respuestas salen por printf a USART2)
+extern TIM_HandleTypeDef htim3;
 
-// Usamos la instancia global definida en main.c
+// Usamos la instancia global definida en app.c
 extern room_control_t room_system;
 
 // Buffers independientes para debug (USART2) y ESP-01 (USART3)
 #define CMD_BUFFER_SIZE 32
 
-static char debug_buf[CMD_BUFFER_SIZE];
-static uint8_t debug_idx = 0;
+// Limitador por canal (token bucket): hasta CMD_RATE_BURST líneas seguidas
+// y después CMD_RATE_PER_S por segundo. SET_PASS y LOGIN vacían el balde
+// entero: como máximo un intento de clave cada CMD_RATE_BURST / CMD_RATE_PER_S s.
+#define CMD_RATE_BURST      8U
+#define CMD_RATE_PER_S      4U
+#define CMD_RATE_COST_PASS  CMD_RATE_BURST
+#define CMD_RATE_SCALE      1000U       // Fichas en milésimas: se recargan de a ms
+#define CMD_RATE_FULL       (CMD_RATE_BURST * CMD_RATE_SCALE)
 
-static char esp01_buf[CMD_BUFFER_SIZE];
-static uint8_t esp01_idx = 0;
+// Sesión abierta con LOGIN: vence tras CMD_SESSION_IDLE_MS sin comandos
+#define CMD_SESSION_IDLE_MS 300000U
+
+typedef struct {
+    char buf[CMD_BUFFER_SIZE];
+    uint8_t idx;
+    bool overflow;              // La línea actual superó el buffer: se descarta
+
+    uint32_t tokens;            // Fichas del limitador, en milésimas
+    uint32_t last_refill;
+    uint32_t limited;           // Líneas descartadas por el limitador
+    bool limit_reported;        // Ya se avisó "ERR: RATE" en esta racha
+
+    user_t session;             // role NONE: sin sesión
+    uint32_t session_time;      // Último comando de la sesión
+    uint8_t login_failures;     // LOGIN incorrectos seguidos
+    uint32_t login_blocked_until;
+} cmd_channel_t;
+
+static cmd_channel_t debug_channel = { .tokens = CMD_RATE_FULL };
+static cmd_channel_t esp01_channel = { .tokens = CMD_RATE_FULL };
+
+static uint32_t overflow_count = 0;
+
+// Transacciones I2C del OLED que muestra GET_I2C (las más recientes)
+#define I2C_TRACE_DUMP 8
 
 // Helpers privados
 
-static void handle_command(const char *cmd, UART_HandleTypeDef *huart)
+#if defined(SSD1306_TRACE)
+// Resumen de uso del bus I2C del OLED y últimas transacciones; reinicia la ventana
+static void print_i2c_trace(void)
+{
+    static ssd1306_TraceEntry_t entries[I2C_TRACE_DUMP];
+    ssd1306_TraceStats_t st;
+
+    ssd1306_TraceGetStats(&st);
+    uint32_t n = ssd1306_TraceRead(entries, I2C_TRACE_DUMP);
+    ssd1306_TraceReset();
+
+    uint32_t cycles_per_us = SystemCoreClock / 1000000u;
+    if (cycles_per_us == 0) {
+        cycles_per_us = 1;
+    }
+
+    printf("I2C: %lu kHz fallbacks=%lu\r\n",
+           (unsigned long)i2c_bus_get_speed(), (unsigned long)i2c_bus_get_fallbacks());
+    printf("I2C: tx=%lu bytes=%lu err=%lu timeout=%lu ventana=%lums\r\n",
+           (unsigned long)st.transactions, (unsigned long)st.bytes,
+           (unsigned long)st.errors, (unsigned long)st.timeouts,
+           (unsigned long)st.window_ms);
+    printf("I2C: %lu B/s busy=%lu.%lu%% max=%luus\r\n",
+           (unsigned long)st.bytes_per_s,
+           (unsigned long)(st.busy_permille / 10), (unsigned long)(st.busy_permille % 10),
+           (unsigned long)(st.max_cycles / cycles_per_us));
+    for (uint32_t i = 0; i < n; i++) {
+        printf("I2C: t=%lu %s len=%u dur=%luus st=%u err=0x%lx\r\n",
+               (unsigned long)entries[i].tick,
+               entries[i].control == 0x00 ? "CMD" : "DATA",
+               (unsigned)entries[i].bytes,
+               (unsigned long)(entries[i].cycles / cycles_per_us),
+               (unsigned)entries[i].status, (unsigned long)entries[i].error);
+    }
+}
+#endif
+
+// Sesión vigente del canal; un comando la mantiene abierta
+static void channel_touch_session(cmd_channel_t *ch)
+{
+    uint32_t now = HAL_GetTick();
+    if (ch->session.role != USER_ROLE_NONE && now - ch->session_time >= CMD_SESSION_IDLE_MS) {
+        ch->session.role = USER_ROLE_NONE;
+    }
+    ch->session_time = now;
+}
+
+// SET_PASS, FORCE_FAN y USER_* necesitan LOGIN con una clave de admin
+static bool channel_require_admin(const cmd_channel_t *ch)
+{
+    if (ch->session.role == USER_ROLE_ADMIN) {
+        return true;
+    }
+    printf("ERR: PERMISO (LOGIN de admin)\r\n");
+    return false;
+}
+
+static void handle_login(cmd_channel_t *ch, const char *pin)
+{
+    uint32_t now = HAL_GetTick();
+    int32_t blocked = (int32_t)(ch->login_blocked_until - now);
+    if (ch->login_failures >= ROOM_LOCKOUT_ATTEMPTS && blocked > 0) {
+        printf("ERR: LOGIN bloqueado %lus\r\n", (unsigned long)(blocked + 999) / 1000UL);
+        return;
+    }
+
+    user_t user;
+    size_t len = strlen(pin);
+    if (len <= PIN_LENGTH_MAX && room_control_identify(&room_system, pin, (uint8_t)len, &user)) {
+        ch->session = user;
+        ch->login_failures = 0;
+        printf("OK: LOGIN id=%u role=%s\r\n", (unsigned)user.id, user_role_name(user.role));
+        return;
+    }
+
+    // Mismo escalonamiento que el keypad, por canal
+    ch->session.role = USER_ROLE_NONE;
+    if (ch->login_failures < UINT8_MAX) {
+        ch->login_failures++;
+    }
+    ch->login_blocked_until = now + room_control_lockout_ms(ch->login_failures);
+    printf("ERR: LOGIN\r\n");
+}
+
+// "<unix>[.<fracción>][,<huso>]": hasta 3 decimales (ms), huso en minutos
+static bool parse_time(const char *arg, uint32_t *unix_s, uint16_t *ms, bool *has_tz, int16_t *tz_min)
+{
+    unsigned long seconds = 0;
+    int tz = 0;
+    int used = 0;
+
+    if (sscanf(arg, "%10lu%n", &seconds, &used) != 1) {
+        return false;
+    }
+    arg += used;
+
+    uint32_t fraction = 0;
+    if (*arg == '.') {
+        uint32_t scale = 100U;
+        for (arg++; *arg >= '0' && *arg <= '9'; arg++) {
+            fraction += (uint32_t)(*arg - '0') * scale;
+            scale /= 10U;
+        }
+    }
+
+    *has_tz = false;
+    if (*arg == ',') {
+        if (sscanf(arg + 1, "%d%n", &tz, &used) != 1 || arg[1 + used] != '\0') {
+            return false;
+        }
+        *has_tz = true;
+    } else if (*arg != '\0') {
+        return false;
+    }
+
+    *unix_s = (uint32_t)seconds;
+    *ms = (uint16_t)fraction;
+    *tz_min = (int16_t)((tz < -32768 || tz > 32767) ? 32767 : tz);
+    return true;
+}
+
+static void handle_command(const char *cmd, cmd_channel_t *ch)
 {
     // Eliminar posibles '\r' o espacios al final
     char local[CMD_BUFFER_SIZE];
@@ -34,6 +196,59 @@ static void handle_command(const char *cmd, UART_HandleTypeDef *huart)
         local[--len] = '\0';
     }
 
+    channel_touch_session(ch);
+
+    // LOGIN:NNNN  (clave maestra o de la tabla de usuarios; abre sesión en este canal)
+    if (strncmp(local, "LOGIN:", 6) == 0) {
+        handle_login(ch, &local[6]);
+        return;
+    }
+
+    // LOGOUT
+    if (strcmp(local, "LOGOUT") == 0) {
+        ch->session.role = USER_ROLE_NONE;
+        printf("OK: LOGOUT\r\n");
+        return;
+    }
+
+    // USER_ADD:ID,R,NNNN  (R = U usuario, A admin; con el mismo ID reemplaza clave y rol)
+    if (strncmp(local, "USER_ADD:", 9) == 0) {
+        unsigned id = 0;
+        char role = 0;
+        char pin[PIN_LENGTH_MAX + 2];
+        if (!channel_require_admin(ch)) {
+            return;
+        }
+        if (sscanf(&local[9], "%u,%c,%9[0-9]", &id, &role, pin) != 3 ||
+            (role != 'U' && role != 'A') || strlen(pin) > PIN_LENGTH_MAX ||
+            !user_table_request_add((uint16_t)id, role == 'A' ? USER_ROLE_ADMIN : USER_ROLE_USER,
+                                    pin, (uint8_t)strlen(pin))) {
+            printf("ERR: USER_ADD arg\r\n");
+        }
+        memset(pin, 0, sizeof(pin));
+        return;   // La respuesta sale de user_table_poll()
+    }
+
+    // USER_DEL:ID
+    if (strncmp(local, "USER_DEL:", 9) == 0) {
+        unsigned id = 0;
+        if (!channel_require_admin(ch)) {
+            return;
+        }
+        if (sscanf(&local[9], "%u", &id) != 1 || !user_table_request_delete((uint16_t)id)) {
+            printf("ERR: USER_DEL arg\r\n");
+        }
+        return;
+    }
+
+    // USER_LIST  (ids y roles, de a unos pocos por vuelta del superloop)
+    if (strcmp(local, "USER_LIST") == 0) {
+        if (channel_require_admin(ch) && !user_table_request_list()) {
+            printf("ERR: USER ocupado\r\n");
+        }
+        return;
+    }
+
     // GET_TEMP
     if (strcmp(local, "GET_TEMP") == 0) {
         float t = room_control_get_temperature(&room_system);
@@ -47,13 +262,321 @@ static void handle_command(const char *cmd, UART_HandleTypeDef *huart)
         fan_level_t fan = room_control_get_fan_level(&room_system);
         uint8_t door_locked = room_control_is_door_locked(&room_system);
 
-        printf("STATUS: state=%d, fan=%d, door_locked=%d\r\n",
-               (int)st, (int)fan, (int)door_locked);
+        schedule_stats_t sched;
+        schedule_get_stats(&sched);
+
+        printf("STATUS: state=%d, fan=%d, door_locked=%d, duty=%u, mode=%s, setpoint=%.1f, user=%u, profile=%d\r\n",
+               (int)st, (int)fan, (int)door_locked,
+               (unsigned)room_control_get_fan_duty(&room_system),
+               room_control_get_fan_mode(&room_system) == FAN_MODE_PID ? "PID" : "AUTO",
+               room_control_get_setpoint(&room_system),
+               (unsigned)room_control_get_user(&room_system).id,
+               (sched.active == SCHEDULE_NO_PROFILE) ? -1 : (int)sched.active);
+        return;
+    }
+
+    // GET_PROF  (ciclos por sonda; reinicia las estadísticas)
+    if (strcmp(local, "GET_PROF") == 0) {
+#ifdef PROF_ENABLED
+        prof_dump();
+#else
+        printf("ERR: PROF deshabilitado\r\n");
+#endif
+        return;
+    }
+
+    // GET_LAT  (histogramas de vuelta del superloop y latencia de teclas)
+    if (strcmp(local, "GET_LAT") == 0) {
+        loop_monitor_dump();
+        return;
+    }
+
+    // GET_I2C  (uso del bus I2C del OLED y últimas transacciones; reinicia la ventana)
+    if (strcmp(local, "GET_I2C") == 0) {
+#if defined(SSD1306_TRACE)
+        print_i2c_trace();
+#else
+        printf("ERR: I2C trace deshabilitado\r\n");
+#endif
+        return;
+    }
+
+    // GET_CFG  (umbrales y estado del almacén de configuración en flash)
+    if (strcmp(local, "GET_CFG") == 0) {
+        config_store_stats_t st;
+        config_store_get_stats(&st);
+        printf("CFG: thresh=%.2f,%.2f,%.2f\r\n",
+               room_control_get_threshold(&room_system, 0),
+               room_control_get_threshold(&room_system, 1),
+               room_control_get_threshold(&room_system, 2));
+        printf("CFG: records=%lu keys=%lu corrupt=%lu page=%lu free=%lu gen=%lu "
+               "compactions=%lu errors=%lu boot_us=%lu\r\n",
+               (unsigned long)st.records, (unsigned long)st.keys, (unsigned long)st.corrupt,
+               (unsigned long)st.active_page, (unsigned long)st.free_bytes,
+               (unsigned long)st.generation, (unsigned long)st.compactions,
+               (unsigned long)st.write_errors, (unsigned long)st.boot_us);
+        return;
+    }
+
+    // GET_TLM  (ocupación del log de telemetría)
+    if (strcmp(local, "GET_TLM") == 0) {
+        telemetry_stats_t st;
+        telemetry_get_stats(&st);
+        printf("TLM: blocks=%lu/%u records=%lu periods=%lu bytes=%lu restored=%d\r\n",
+               (unsigned long)st.blocks, (unsigned)TELEMETRY_BLOCKS, (unsigned long)st.records,
+               (unsigned long)st.periods, (unsigned long)st.bytes, (int)st.restored);
+        return;
+    }
+
+    // TLM_DUMP  (vuelca el log en líneas TLMB:<hex>, un bloque por vuelta del superloop)
+    if (strcmp(local, "TLM_DUMP") == 0) {
+        telemetry_request_dump();
+        return;
+    }
+
+    // TLM_CLEAR
+    if (strcmp(local, "TLM_CLEAR") == 0) {
+        telemetry_clear();
+        printf("OK: TLM_CLEAR\r\n");
+        return;
+    }
+
+    // GET_PUB  (publicación por USART3)
+    if (strcmp(local, "GET_PUB") == 0) {
+        publisher_stats_t st;
+        publisher_get_stats(&st);
+        printf("PUB: interval=%lu samples=%lu fmt=%s sent=%lu bytes=%lu busy=%lu dropped=%lu\r\n",
+               (unsigned long)st.interval_s, (unsigned long)st.samples,
+               st.format == PUBLISHER_FORMAT_TXT ? "TXT" : "SN",
+               (unsigned long)st.sent, (unsigned long)st.bytes,
+               (unsigned long)st.busy, (unsigned long)st.dropped);
+        return;
+    }
+
+    // GET_ALERT  (cola de alertas hacia el servidor remoto)
+    if (strcmp(local, "GET_ALERT") == 0) {
+        alert_stats_t st;
+        alert_get_stats(&st);
+        printf("ALERT: pending=%lu raised=%lu sent=%lu retries=%lu acked=%lu dropped=%lu "
+               "next_id=%lu backoff=%lums\r\n",
+               (unsigned long)st.pending, (unsigned long)st.raised, (unsigned long)st.sent,
+               (unsigned long)st.retries, (unsigned long)st.acked, (unsigned long)st.dropped,
+               (unsigned long)st.next_id, (unsigned long)st.backoff_ms);
+        return;
+    }
+
+    // GET_SEC  (bloqueo del keypad y líneas descartadas por el limitador)
+    if (strcmp(local, "GET_SEC") == 0) {
+        user_table_stats_t users;
+        user_table_get_stats(&users);
+        printf("SEC: failed=%u lockout=%lums limited=%lu,%lu session=%s users=%lu\r\n",
+               (unsigned)room_control_get_failed_attempts(&room_system),
+               (unsigned long)room_control_get_lockout_remaining(&room_system),
+               (unsigned long)debug_channel.limited, (unsigned long)esp01_channel.limited,
+               user_role_name(ch->session.role), (unsigned long)users.users);
+        return;
+    }
+
+    // GET_TIME  (hora del RTC y estado de la sincronización)
+    if (strcmp(local, "GET_TIME") == 0) {
+        rtc_clock_stats_t st;
+        char text[RTC_CLOCK_TEXT_LEN];
+        rtc_clock_get_stats(&st);
+        rtc_clock_format(rtc_clock_now(), true, text, sizeof(text));
+        printf("TIME: %s unix=%lu tz=%d set=%u syncs=%lu steps=%lu offset=%ldms slew=%ldms cal=%ld\r\n",
+               st.set ? text : "-", (unsigned long)rtc_clock_now(), (int)st.tz_min, (unsigned)st.set,
+               (unsigned long)st.syncs, (unsigned long)st.steps, (long)st.last_offset_ms,
+               (long)st.slew_left_ms, (long)st.base_pulses);
+        return;
+    }
+
+    // SET_TIME:UNIX[.MS][,TZ]  (UTC; TZ = huso en minutos; se aplica en rtc_clock_poll())
+    if (strncmp(local, "SET_TIME:", 9) == 0) {
+        uint32_t unix_s = 0;
+        uint16_t ms = 0;
+        bool has_tz = false;
+        int16_t tz_min = 0;
+        if (!parse_time(&local[9], &unix_s, &ms, &has_tz, &tz_min)) {
+            printf("ERR: SET_TIME arg\r\n");
+        } else if (!rtc_clock_request_sync(unix_s, ms, has_tz, tz_min)) {
+            printf("ERR: SET_TIME arg u ocupado\r\n");
+        }
+        return;   // La respuesta sale de rtc_clock_poll()
+    }
+
+    // PUB:S,N  (un mensaje cada S segundos con N muestras; S=0 deshabilita)
+    if (strncmp(local, "PUB:", 4) == 0) {
+        unsigned long interval = 0, samples = 0;
+        if (sscanf(&local[4], "%lu,%lu", &interval, &samples) == 2 &&
+            publisher_configure((uint32_t)interval, (uint32_t)samples)) {
+            printf("OK: PUB=%lu,%lu\r\n", interval, samples);
+        } else {
+            printf("ERR: PUB arg\r\n");
+        }
+        return;
+    }
+
+    // PUB_FMT:SN | PUB_FMT:TXT
+    if (strncmp(local, "PUB_FMT:", 8) == 0) {
+        if (strcmp(&local[8], "SN") == 0) {
+            publisher_set_format(PUBLISHER_FORMAT_SN);
+        } else if (strcmp(&local[8], "TXT") == 0) {
+            publisher_set_format(PUBLISHER_FORMAT_TXT);
+        } else {
+            printf("ERR: PUB_FMT arg\r\n");
+            return;
+        }
+        printf("OK: PUB_FMT=%s\r\n", &local[8]);
+        return;
+    }
+
+    // I2C_SPEED:KHZ  (100, 400 o 1000; se aplica en la próxima vuelta del superloop)
+    if (strncmp(local, "I2C_SPEED:", 10) == 0) {
+        unsigned long khz = 0;
+        if (sscanf(&local[10], "%lu", &khz) == 1 && i2c_bus_request_speed((uint32_t)khz)) {
+            printf("OK: I2C_SPEED=%lu kHz\r\n", khz);
+        } else {
+            printf("ERR: I2C_SPEED arg\r\n");
+        }
+        return;
+    }
+
+    // LAT_ALARM:US  (umbral de alarma por vuelta; 0 la deshabilita)
+    if (strncmp(local, "LAT_ALARM:", 10) == 0) {
+        unsigned long us = 0;
+        if (sscanf(&local[10], "%lu", &us) == 1) {
+            loop_monitor_set_alarm((uint32_t)us);
+            printf("OK: LAT_ALARM=%lu us\r\n", us);
+        } else {
+            printf("ERR: LAT_ALARM arg\r\n");
+        }
+        return;
+    }
+
+    // FAN_MODE:PID | FAN_MODE:AUTO
+    if (strncmp(local, "FAN_MODE:", 9) == 0) {
+        if (strcmp(&local[9], "PID") == 0) {
+            room_control_set_fan_mode(&room_system, FAN_MODE_PID);
+        } else if (strcmp(&local[9], "AUTO") == 0) {
+            room_control_set_fan_mode(&room_system, FAN_MODE_LEVELS);
+        } else {
+            printf("ERR: FAN_MODE arg\r\n");
+            return;
+        }
+        printf("OK: FAN_MODE=%s\r\n", &local[9]);
+        return;
+    }
+
+    // SET_POINT:TT.T  (setpoint del modo PID en °C)
+    if (strncmp(local, "SET_POINT:", 10) == 0) {
+        float sp = 0.0f;
+        if (sscanf(&local[10], "%f", &sp) == 1 && sp >= 10.0f && sp <= 40.0f) {
+            room_control_set_setpoint(&room_system, sp);
+            printf("OK: SET_POINT=%.1f\r\n", sp);
+        } else {
+            printf("ERR: SET_POINT arg\r\n");
+        }
+        return;
+    }
+
+    // SET_THRESH:LOW,MED,HIGH  (umbrales del modo por niveles en °C, ascendentes)
+    if (strncmp(local, "SET_THRESH:", 11) == 0) {
+        float low = 0.0f, med = 0.0f, high = 0.0f;
+        if (sscanf(&local[11], "%f,%f,%f", &low, &med, &high) == 3 &&
+            room_control_set_thresholds(&room_system, low, med, high)) {
+            printf("OK: SET_THRESH=%.1f,%.1f,%.1f\r\n", low, med, high);
+        } else {
+            printf("ERR: SET_THRESH arg\r\n");
+        }
+        return;
+    }
+
+    // PROF_PID:P,TT.T  (perfil P de la programación: PID con setpoint en °C)
+    if (strncmp(local, "PROF_PID:", 9) == 0) {
+        unsigned profile = 0;
+        float sp = 0.0f;
+        if (sscanf(&local[9], "%u,%f", &profile, &sp) != 2 || profile >= SCHEDULE_PROFILES ||
+            !(sp >= 10.0f && sp <= 40.0f) || !schedule_request_pid((uint8_t)profile, (int16_t)(sp * 100.0f))) {
+            printf("ERR: PROF_PID arg u ocupado\r\n");
+        }
+        return;   // La respuesta sale de schedule_poll()
+    }
+
+    // PROF_LVL:P,LOW,MED,HIGH  (perfil P: niveles con umbrales en °C, ascendentes)
+    if (strncmp(local, "PROF_LVL:", 9) == 0) {
+        unsigned profile = 0;
+        float low = 0.0f, med = 0.0f, high = 0.0f;
+        if (sscanf(&local[9], "%u,%f,%f,%f", &profile, &low, &med, &high) != 4 ||
+            profile >= SCHEDULE_PROFILES || !(low >= -20.0f && high <= 80.0f)) {
+            printf("ERR: PROF_LVL arg u ocupado\r\n");
+            return;
+        }
+        int16_t thresholds[ROOM_THRESHOLD_COUNT] = {
+            (int16_t)(low * 100.0f), (int16_t)(med * 100.0f), (int16_t)(high * 100.0f)
+        };
+        if (!schedule_request_levels((uint8_t)profile, thresholds)) {
+            printf("ERR: PROF_LVL arg u ocupado\r\n");
+        }
+        return;
+    }
+
+    // PROF_FAN:P,MIN,MAX  (perfil P: rango del duty automático en %)
+    if (strncmp(local, "PROF_FAN:", 9) == 0) {
+        unsigned profile = 0, fan_min = 0, fan_max = 0;
+        if (sscanf(&local[9], "%u,%u,%u", &profile, &fan_min, &fan_max) != 3 ||
+            profile >= SCHEDULE_PROFILES || fan_max > 100U ||
+            !schedule_request_fan((uint8_t)profile, (uint8_t)fan_min, (uint8_t)fan_max)) {
+            printf("ERR: PROF_FAN arg u ocupado\r\n");
+        }
+        return;
+    }
+
+    // SCHED_ADD:DIAS,HH:MM,P  (DIAS = LMXJVSD o *; desde esa hora local rige el perfil P)
+    if (strncmp(local, "SCHED_ADD:", 10) == 0) {
+        char days_text[8];
+        unsigned hours = 0, minutes = 0, profile = 0;
+        uint8_t days = 0;
+        int used = 0;
+        if (sscanf(&local[10], "%7[^,],%u:%u,%u%n", days_text, &hours, &minutes, &profile, &used) != 4 ||
+            local[10 + used] != '\0' || !schedule_parse_days(days_text, &days) ||
+            hours > 23U || minutes > 59U || profile >= SCHEDULE_PROFILES ||
+            !schedule_request_add(days, (uint16_t)(hours * 60U + minutes), (uint8_t)profile)) {
+            printf("ERR: SCHED_ADD arg u ocupado\r\n");
+        }
+        return;
+    }
+
+    // SCHED_DEL:N  (número de entrada de GET_SCHED; las siguientes se corren)
+    if (strncmp(local, "SCHED_DEL:", 10) == 0) {
+        unsigned index = 0;
+        if (sscanf(&local[10], "%u", &index) != 1 || index >= SCHEDULE_ENTRIES ||
+            !schedule_request_delete((uint8_t)index)) {
+            printf("ERR: SCHED_DEL arg u ocupado\r\n");
+        }
+        return;
+    }
+
+    // SCHED_CLEAR  (borra todas las entradas; los perfiles quedan)
+    if (strcmp(local, "SCHED_CLEAR") == 0) {
+        if (!schedule_request_clear()) {
+            printf("ERR: SCHED ocupado\r\n");
+        }
+        return;
+    }
+
+    // GET_SCHED  (perfiles, entradas y próximo cambio, de a unas líneas por vuelta)
+    if (strcmp(local, "GET_SCHED") == 0) {
+        if (!schedule_request_list()) {
+            printf("ERR: SCHED ocupado\r\n");
+        }
         return;
     }
 
     // FORCE_FAN:N
     if (strncmp(local, "FORCE_FAN:", 10) == 0) {
+        if (!channel_require_admin(ch)) {
+            return;
+        }
         char n = local[10];
         if (n >= '0' && n <= '3') {
             fan_level_t level = FAN_LEVEL_OFF;
@@ -69,57 +592,163 @@ static void handle_command(const char *cmd, UART_HandleTypeDef *huart)
         return;
     }
 
-    // SET_PASS:XXXX
+    // SET_PASS:NNNN  (de PIN_LENGTH_MIN a PIN_LENGTH_MAX dígitos; no se repite en la respuesta)
     if (strncmp(local, "SET_PASS:", 9) == 0) {
+        if (!channel_require_admin(ch)) {
+            return;
+        }
         const char *pass = &local[9];
-        if (strlen(pass) == PASSWORD_LENGTH &&
-            isdigit((unsigned char)pass[0]) &&
-            isdigit((unsigned char)pass[1]) &&
-            isdigit((unsigned char)pass[2]) &&
-            isdigit((unsigned char)pass[3])) {
-
+        size_t pass_len = strlen(pass);
+        if (pass_len <= PIN_LENGTH_MAX && pin_hash_valid_pin(pass, (uint8_t)pass_len)) {
             room_control_change_password(&room_system, pass);
-            printf("OK: PASS=%s\r\n", pass);
+            printf("OK: PASS len=%u\r\n", (unsigned)pass_len);
         } else {
             printf("ERR: PASS\r\n");
         }
         return;
     }
 
+    // FAN_RAMP:C,MS  (C = L lineal, S curva S, E exponencial)
+    if (strncmp(local, "FAN_RAMP:", 9) == 0) {
+        char c = local[9];
+        fan_ramp_curve_t curve;
+        if (c == 'L') curve = FAN_RAMP_LINEAR;
+        else if (c == 'S') curve = FAN_RAMP_S_CURVE;
+        else if (c == 'E') curve = FAN_RAMP_EXPONENTIAL;
+        else {
+            printf("ERR: FAN_RAMP arg\r\n");
+            return;
+        }
+
+        unsigned int ms = 0;
+        if (local[10] != ',' || sscanf(&local[11], "%u", &ms) != 1) {
+            printf("ERR: FAN_RAMP arg\r\n");
+            return;
+        }
+
+        fan_ramp_configure(curve, ms);
+        printf("OK: FAN_RAMP=%c,%u\r\n", c, ms);
+        return;
+    }
+
+    // FAN_PWM:HZ  (frecuencia PWM del ventilador, resolución >= 10 bits)
+    if (strncmp(local, "FAN_PWM:", 8) == 0) {
+        unsigned int hz = 0;
+        if (sscanf(&local[8], "%u", &hz) == 1 &&
+            fan_pwm_configure(&htim3, hz, FAN_PWM_MIN_RESOLUTION)) {
+            printf("OK: FAN_PWM=%lu Hz, %lu pasos\r\n",
+                   (unsigned long)fan_pwm_get_frequency(&htim3),
+                   (unsigned long)(__HAL_TIM_GET_AUTORELOAD(&htim3) + 1));
+        } else {
+            printf("ERR: FAN_PWM arg\r\n");
+        }
+        return;
+    }
+
     // Si no coincide con nada
     printf("ERR: UNKNOWN CMD (%s)\r\n", local);
 }
 
-// API pública 
-
-void command_parser_process_debug(uint8_t byte)
+// Recarga el balde según el tiempo transcurrido y descuenta el costo de la
+// línea; false si no alcanza (la línea se descarta sin ejecutarse)
+static bool channel_take_tokens(cmd_channel_t *ch, uint32_t cost)
 {
-    if (byte == '\n') {
-        debug_buf[debug_idx] = '\0';
-        if (debug_idx > 0) {
-            handle_command(debug_buf, &huart2);
+    uint32_t now = HAL_GetTick();
+    uint32_t elapsed = now - ch->last_refill;
+    ch->last_refill = now;
+
+    if (elapsed >= CMD_RATE_FULL / CMD_RATE_PER_S) {
+        ch->tokens = CMD_RATE_FULL;
+    } else {
+        ch->tokens += elapsed * CMD_RATE_PER_S;
+        if (ch->tokens > CMD_RATE_FULL) {
+            ch->tokens = CMD_RATE_FULL;
         }
-        debug_idx = 0;
-        return;
     }
 
-    if (debug_idx < CMD_BUFFER_SIZE - 1) {
-        debug_buf[debug_idx++] = (char)byte;
+    cost *= CMD_RATE_SCALE;
+    if (ch->tokens < cost) {
+        return false;
     }
+    ch->tokens -= cost;
+    return true;
 }
 
-void command_parser_process_esp01(uint8_t byte)
+// Acumula un byte en el canal y ejecuta la línea al recibir '\n'.
+// Una línea más larga que el buffer no se ejecuta truncada (podría
+// coincidir con otro comando): se descarta completa y se informa.
+static void channel_feed(cmd_channel_t *ch, uint8_t byte)
 {
     if (byte == '\n') {
-        esp01_buf[esp01_idx] = '\0';
-        if (esp01_idx > 0) {
-            handle_command(esp01_buf, &huart3);
+        if (ch->idx == 0 && !ch->overflow) {
+            return;
         }
-        esp01_idx = 0;
+
+        // Una ráfaga de líneas (inválidas incluidas) no acapara el superloop:
+        // fuera de cupo se descarta y se avisa una sola vez por racha
+        ch->buf[ch->idx] = '\0';
+        bool password = strncmp(ch->buf, "SET_PASS:", 9) == 0 || strncmp(ch->buf, "LOGIN:", 6) == 0;
+        uint32_t cost = password ? CMD_RATE_COST_PASS : 1U;
+        if (!channel_take_tokens(ch, cost)) {
+            ch->limited++;
+            if (!ch->limit_reported) {
+                ch->limit_reported = true;
+                printf("ERR: RATE\r\n");
+            }
+        } else if (ch->overflow) {
+            ch->limit_reported = false;
+            overflow_count++;
+            printf("ERR: CMD demasiado largo (max %d)\r\n", CMD_BUFFER_SIZE - 1);
+        } else {
+            ch->limit_reported = false;
+            handle_command(ch->buf, ch);
+        }
+        ch->idx = 0;
+        ch->overflow = false;
         return;
     }
 
-    if (esp01_idx < CMD_BUFFER_SIZE - 1) {
-        esp01_buf[esp01_idx++] = (char)byte;
+    if (ch->idx < CMD_BUFFER_SIZE - 1) {
+        ch->buf[ch->idx++] = (char)byte;
+    } else {
+        ch->overflow = true;
+    }
+}
+
+// API pública 
+
+void command_parser_process_debug(uint8_t byte)
+{
+    channel_feed(&debug_channel, byte);
+}
+
+void command_parser_process_esp01(uint8_t byte)
+{
+    channel_feed(&esp01_channel, byte);
+}
+
+uint32_t command_parser_get_overflows(void)
+{
+    return overflow_count;
+}
+
+uint32_t command_parser_get_rate_limited(void)
+{
+    return debug_channel.limited + esp01_channel.limited;
+}
+
+void command_parser_reset(void)
+{
+    cmd_channel_t *channels[] = { &debug_channel, &esp01_channel };
+    for (uint8_t i = 0; i < 2; i++) {
+        channels[i]->idx = 0;
+        channels[i]->overflow = false;
+        channels[i]->tokens = CMD_RATE_FULL;
+        channels[i]->last_refill = HAL_GetTick();
+        channels[i]->limited = 0;
+        channels[i]->limit_reported = false;
+        channels[i]->session.role = USER_ROLE_NONE;
+        channels[i]->login_failures = 0;
     }
+    overflow_count = 0;
 }
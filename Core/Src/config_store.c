@@ -0,0 +1,441 @@
+#include "config_store.h"
+#include "prof.h"   // PROF_CYCLES(): costo de config_store_init()
+#include <string.h>
+
+#define CONFIG_PAGE_MAGIC    0x31564352u   // "RCV1"
+#define CONFIG_WORD          8U            // Palabra doble: unidad de programación
+#define CONFIG_ALIGN(n)      (((n) + CONFIG_WORD - 1U) & ~(CONFIG_WORD - 1U))
+#define CONFIG_RECORD_MAX    (CONFIG_WORD + CONFIG_ALIGN(CONFIG_STORE_VALUE_MAX))
+
+_Static_assert(CONFIG_WORD + (CONFIG_KEY_COUNT - 1) * CONFIG_RECORD_MAX <= CONFIG_STORE_PAGE_SIZE,
+               "config_store_compact() copia todas las claves a una página");
+
+// Cabecera de página (una palabra doble)
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;     // Crece con cada página abierta; 0 = página libre
+} config_page_hdr_t;
+
+// Cabecera de registro; el valor sigue en las palabras dobles siguientes
+typedef struct {
+    uint16_t key;
+    uint16_t len;
+    uint16_t crc;            // CRC-16/CCITT de key, len y valor
+    uint16_t key_inv;        // ~key: descarta cabeceras que no son registros
+} config_record_hdr_t;
+
+static struct {
+    bool ready;
+    uint8_t active;                          // Página donde se escribe
+    uint16_t offset;                         // Próxima escritura en la página activa
+    uint32_t generation[CONFIG_STORE_PAGES];
+    uint16_t records[CONFIG_STORE_PAGES];    // Registros válidos por página
+    uint32_t index[CONFIG_KEY_COUNT];        // Último registro de cada clave (0 = sin valor)
+    config_store_stats_t stats;
+} store;
+
+// Helpers privados
+
+static uint32_t config_page_addr(uint8_t page)
+{
+    return CONFIG_STORE_BASE + (uint32_t)page * CONFIG_STORE_PAGE_SIZE;
+}
+
+static uint16_t config_crc16(uint16_t crc, const uint8_t *data, uint16_t len)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t config_record_crc(uint16_t key, uint16_t len, const uint8_t *value)
+{
+    const uint8_t head[4] = { (uint8_t)key, (uint8_t)(key >> 8), (uint8_t)len, (uint8_t)(len >> 8) };
+    return config_crc16(config_crc16(0xFFFFu, head, sizeof(head)), value, len);
+}
+
+static bool config_is_erased(uint32_t address, uint32_t size)
+{
+    const uint8_t *p = FLASH_READ_PTR(address);
+    for (uint32_t i = 0; i < size; i++) {
+        if (p[i] != 0xFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Programa size bytes (múltiplo de CONFIG_WORD) palabra por palabra, en orden
+static bool config_program(uint32_t address, const uint8_t *data, uint32_t size)
+{
+    bool ok = true;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    for (uint32_t i = 0; ok && i < size; i += CONFIG_WORD) {
+        uint64_t word;
+        memcpy(&word, &data[i], sizeof(word));
+        ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address + i, word) == HAL_OK);
+    }
+    HAL_FLASH_Lock();
+
+    if (!ok) {
+        store.stats.write_errors++;
+    }
+    return ok;
+}
+
+static bool config_erase(uint8_t page)
+{
+    uint32_t offset = config_page_addr(page) - FLASH_BASE;
+    uint32_t page_error = 0;
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .Banks = (offset < FLASH_BANK_SIZE) ? FLASH_BANK_1 : FLASH_BANK_2,
+        .Page = (offset % FLASH_BANK_SIZE) / FLASH_PAGE_SIZE,
+        .NbPages = 1,
+    };
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    bool ok = (HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK);
+    HAL_FLASH_Lock();
+
+    store.generation[page] = 0;
+    store.records[page] = 0;
+    if (!ok) {
+        store.stats.write_errors++;
+    }
+    return ok;
+}
+
+/**
+ * @brief Recorre los registros de una página y actualiza el índice.
+ * @return Offset de la primera palabra borrada (dónde seguir escribiendo);
+ * CONFIG_STORE_PAGE_SIZE si la página está llena o tiene una cabecera
+ * inválida (no se vuelve a escribir en ella).
+ */
+static uint16_t config_replay_page(uint8_t page)
+{
+    uint32_t base = config_page_addr(page);
+    uint16_t offset = CONFIG_WORD;
+
+    while (offset + CONFIG_WORD <= CONFIG_STORE_PAGE_SIZE) {
+        config_record_hdr_t hdr;
+        memcpy(&hdr, FLASH_READ_PTR(base + offset), sizeof(hdr));
+
+        if (config_is_erased(base + offset, CONFIG_WORD)) {
+            return offset;
+        }
+        if ((uint16_t)(hdr.key ^ hdr.key_inv) != UINT16_MAX || hdr.len > CONFIG_STORE_VALUE_MAX ||
+            offset + CONFIG_WORD + CONFIG_ALIGN(hdr.len) > CONFIG_STORE_PAGE_SIZE) {
+            store.stats.corrupt++;
+            return CONFIG_STORE_PAGE_SIZE;
+        }
+
+        const uint8_t *value = FLASH_READ_PTR(base + offset + CONFIG_WORD);
+        if (hdr.crc != config_record_crc(hdr.key, hdr.len, value)) {
+            // Escritura cortada por un reset: se salta, la cabecera da el largo
+            store.stats.corrupt++;
+        } else {
+            store.records[page]++;
+            if (hdr.key > 0 && hdr.key < CONFIG_KEY_COUNT) {
+                store.index[hdr.key] = base + offset;
+            }
+        }
+        offset += CONFIG_WORD + CONFIG_ALIGN(hdr.len);
+    }
+    return CONFIG_STORE_PAGE_SIZE;
+}
+
+// Escribe el registro en la página activa; el llamador verificó que entra
+static bool config_append(uint16_t key, const void *value, uint16_t len)
+{
+    uint8_t record[CONFIG_RECORD_MAX];
+    config_record_hdr_t hdr = {
+        .key = key,
+        .len = len,
+        .crc = config_record_crc(key, len, value),
+        .key_inv = (uint16_t)~key,
+    };
+    uint16_t size = (uint16_t)(CONFIG_WORD + CONFIG_ALIGN(len));
+    uint32_t address = config_page_addr(store.active) + store.offset;
+
+    memset(record, 0xFF, sizeof(record));
+    memcpy(record, &hdr, sizeof(hdr));
+    memcpy(&record[CONFIG_WORD], value, len);
+
+    // La cabecera va primero: si se corta el valor, el CRC lo descarta
+    store.offset += size;
+    if (!config_program(address, record, size)) {
+        store.offset = CONFIG_STORE_PAGE_SIZE;   // No seguir en una página con errores
+        return false;
+    }
+    store.records[store.active]++;
+    store.index[key] = address;
+    return true;
+}
+
+static bool config_open_page(uint8_t page, uint32_t generation)
+{
+    config_page_hdr_t hdr = { .magic = CONFIG_PAGE_MAGIC, .generation = generation };
+    uint8_t word[CONFIG_WORD];
+
+    if (!config_is_erased(config_page_addr(page), CONFIG_STORE_PAGE_SIZE) && !config_erase(page)) {
+        return false;
+    }
+    memcpy(word, &hdr, sizeof(word));
+    if (!config_program(config_page_addr(page), word, sizeof(word))) {
+        return false;
+    }
+    store.active = page;
+    store.offset = CONFIG_WORD;
+    store.generation[page] = generation;
+    store.stats.generation = generation;
+    return true;
+}
+
+static bool config_has_free_page(void)
+{
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        if (store.generation[p] == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Libera la página más vieja: copia a la activa los registros que
+ * siguen vigentes y la borra. Si se corta antes del borrado, al arrancar
+ * las copias (generación más nueva) ganan sobre los originales.
+ */
+static bool config_compact_oldest(void)
+{
+    uint8_t victim = store.active;
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        if (store.generation[p] != 0 && store.generation[p] < store.generation[victim]) {
+            victim = p;
+        }
+    }
+    if (victim == store.active) {
+        return false;
+    }
+
+    uint32_t start = config_page_addr(victim);
+    for (uint16_t key = 1; key < CONFIG_KEY_COUNT; key++) {
+        uint32_t address = store.index[key];
+        if (address < start || address >= start + CONFIG_STORE_PAGE_SIZE) {
+            continue;
+        }
+
+        config_record_hdr_t hdr;
+        uint8_t value[CONFIG_STORE_VALUE_MAX];
+        memcpy(&hdr, FLASH_READ_PTR(address), sizeof(hdr));
+        memcpy(value, FLASH_READ_PTR(address + CONFIG_WORD), hdr.len);
+
+        if (store.offset + CONFIG_WORD + CONFIG_ALIGN(hdr.len) > CONFIG_STORE_PAGE_SIZE ||
+            !config_append(key, value, hdr.len)) {
+            return false;
+        }
+    }
+
+    store.stats.compactions++;
+    return config_erase(victim);
+}
+
+// La activa se llenó: abrir una libre y conservar siempre otra libre
+static bool config_next_page(void)
+{
+    uint8_t next = store.active;
+    for (uint8_t i = 1; i <= CONFIG_STORE_PAGES; i++) {
+        next = (uint8_t)((store.active + i) % CONFIG_STORE_PAGES);
+        if (store.generation[next] == 0) {
+            break;
+        }
+    }
+    if (store.generation[next] != 0 ||
+        !config_open_page(next, store.generation[store.active] + 1)) {
+        return false;
+    }
+    return config_has_free_page() || config_compact_oldest();
+}
+
+/**
+ * @brief Recorre la región, arma el índice en RAM y deja una página activa.
+ *
+ * Se llama una vez al arrancar, antes de room_control_init(); el tiempo
+ * que toma queda en stats.boot_us (requiere el DWT habilitado).
+ */
+bool config_store_init(void)
+{
+    uint32_t start = PROF_CYCLES();
+    uint8_t order[CONFIG_STORE_PAGES];
+    uint8_t used = 0;
+
+    memset(&store, 0, sizeof(store));
+
+    // Páginas con cabecera válida, ordenadas por generación
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        config_page_hdr_t hdr;
+        memcpy(&hdr, FLASH_READ_PTR(config_page_addr(p)), sizeof(hdr));
+
+        if (hdr.magic == CONFIG_PAGE_MAGIC && hdr.generation != 0 && hdr.generation != UINT32_MAX) {
+            uint8_t i = used++;
+            while (i > 0 && store.generation[order[i - 1]] > hdr.generation) {
+                order[i] = order[i - 1];
+                i--;
+            }
+            order[i] = p;
+            store.generation[p] = hdr.generation;
+        } else if (!config_is_erased(config_page_addr(p), CONFIG_WORD)) {
+            config_erase(p);   // Basura (borrado interrumpido o región sin formatear)
+        }
+    }
+
+    bool ok;
+    if (used == 0) {
+        ok = config_open_page(0, 1);
+    } else {
+        // En orden de generación: el último registro de cada clave gana
+        for (uint8_t i = 0; i < used; i++) {
+            store.offset = config_replay_page(order[i]);
+        }
+        store.active = order[used - 1];
+        store.stats.generation = store.generation[store.active];
+
+        // Reset entre abrir una página y compactar la más vieja
+        ok = config_has_free_page() || config_compact_oldest();
+    }
+
+    uint32_t cycles_per_us = SystemCoreClock / 1000000u;
+    store.stats.boot_us = (PROF_CYCLES() - start) / (cycles_per_us ? cycles_per_us : 1u);
+    store.ready = ok;
+    return ok;
+}
+
+/**
+ * @brief Copia el valor de la clave. Falla si no hay valor guardado o si
+ * su largo no es len (p. ej. de una versión anterior con otro formato).
+ */
+bool config_store_get(config_key_t key, void *value, uint16_t len)
+{
+    if (!store.ready || key < CONFIG_KEY_PASSWORD || key >= CONFIG_KEY_COUNT || store.index[key] == 0) {
+        return false;
+    }
+
+    config_record_hdr_t hdr;
+    memcpy(&hdr, FLASH_READ_PTR(store.index[key]), sizeof(hdr));
+    if (hdr.len != len) {
+        return false;
+    }
+    memcpy(value, FLASH_READ_PTR(store.index[key] + CONFIG_WORD), len);
+    return true;
+}
+
+/**
+ * @brief Agrega un registro con el nuevo valor. Si es igual al guardado no
+ * escribe nada. Puede bloquear ~22 ms cuando hay que borrar una página.
+ */
+bool config_store_set(config_key_t key, const void *value, uint16_t len)
+{
+    if (!store.ready || key < CONFIG_KEY_PASSWORD || key >= CONFIG_KEY_COUNT || len > CONFIG_STORE_VALUE_MAX) {
+        return false;
+    }
+
+    if (store.index[key] != 0) {
+        config_record_hdr_t hdr;
+        memcpy(&hdr, FLASH_READ_PTR(store.index[key]), sizeof(hdr));
+        if (hdr.len == len && memcmp(FLASH_READ_PTR(store.index[key] + CONFIG_WORD), value, len) == 0) {
+            return true;
+        }
+    }
+
+    if (store.offset + CONFIG_WORD + CONFIG_ALIGN(len) > CONFIG_STORE_PAGE_SIZE && !config_next_page()) {
+        return false;
+    }
+    return config_append((uint16_t)key, value, len);
+}
+
+/**
+ * @brief Copia los valores vigentes a una página nueva y borra todas las
+ * demás: en la flash no queda ningún registro reemplazado.
+ *
+ * Para valores que no deben sobrevivir a su reemplazo (la clave en texto
+ * de versiones anteriores). Un reset a mitad deja las copias con
+ * generación más nueva, que ganan al arrancar. Bloquea hasta ~22 ms por
+ * página borrada.
+ */
+bool config_store_compact(void)
+{
+    if (!store.ready) {
+        return false;
+    }
+
+    uint8_t fresh = store.active;
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        if (store.generation[p] == 0) {
+            fresh = p;
+            break;
+        }
+    }
+    uint8_t old = store.active;
+    if (fresh == old || !config_open_page(fresh, store.generation[old] + 1)) {
+        return false;
+    }
+
+    for (uint16_t key = 1; key < CONFIG_KEY_COUNT; key++) {
+        uint32_t address = store.index[key];
+        if (address == 0) {
+            continue;
+        }
+
+        config_record_hdr_t hdr;
+        uint8_t value[CONFIG_STORE_VALUE_MAX];
+        memcpy(&hdr, FLASH_READ_PTR(address), sizeof(hdr));
+        memcpy(value, FLASH_READ_PTR(address + CONFIG_WORD), hdr.len);
+        if (!config_append(key, value, hdr.len)) {
+            return false;
+        }
+    }
+
+    bool ok = true;
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        if (p != fresh && store.generation[p] != 0) {
+            ok = config_erase(p) && ok;
+        }
+    }
+    store.stats.compactions++;
+    return ok;
+}
+
+/**
+ * @brief Borra la región completa (vuelven los valores por defecto).
+ */
+bool config_store_format(void)
+{
+    bool ok = true;
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        ok = config_erase(p) && ok;
+    }
+    return ok && config_store_init();
+}
+
+void config_store_get_stats(config_store_stats_t *stats)
+{
+    *stats = store.stats;
+    stats->records = 0;
+    stats->keys = 0;
+    for (uint8_t p = 0; p < CONFIG_STORE_PAGES; p++) {
+        stats->records += store.records[p];
+    }
+    for (uint16_t key = 1; key < CONFIG_KEY_COUNT; key++) {
+        stats->keys += (store.index[key] != 0);
+    }
+    stats->active_page = store.active;
+    stats->free_bytes = CONFIG_STORE_PAGE_SIZE - store.offset;
+}
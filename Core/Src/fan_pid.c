@@ -0,0 +1,93 @@
+#include "fan_pid.h"
+
+// Ganancias por defecto: 1 °C de error -> 10 % de duty proporcional
+#define FAN_PID_DEFAULT_KP_Q8   256
+#define FAN_PID_DEFAULT_KI_Q8   13     // ~0.05 ‰/(0.01 °C·s)
+#define FAN_PID_DEFAULT_KD_Q8   0
+#define FAN_PID_DEFAULT_RATE    200    // 20 % por segundo
+
+static int32_t clamp(int32_t value, int32_t min, int32_t max)
+{
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+/**
+ * @brief Carga las ganancias y límites por defecto y reinicia el estado.
+ */
+void fan_pid_init(fan_pid_t *pid)
+{
+    pid->kp_q8 = FAN_PID_DEFAULT_KP_Q8;
+    pid->ki_q8 = FAN_PID_DEFAULT_KI_Q8;
+    pid->kd_q8 = FAN_PID_DEFAULT_KD_Q8;
+    pid->out_min = 0;
+    pid->out_max = FAN_DUTY_MAX;
+    pid->rate_limit = FAN_PID_DEFAULT_RATE;
+    fan_pid_reset(pid, 0);
+}
+
+/**
+ * @brief Reinicia el estado interno partiendo de una salida conocida
+ * (transferencia sin saltos al pasar de manual/niveles a PID).
+ */
+void fan_pid_reset(fan_pid_t *pid, int32_t output)
+{
+    pid->output = clamp(output, pid->out_min, pid->out_max);
+    pid->integral = (int64_t)pid->output * 1000;
+    pid->prev_measurement = 0;
+    pid->primed = false;
+}
+
+/**
+ * @brief Un paso del lazo de control.
+ *
+ * Enfriamiento: una temperatura por encima del setpoint sube el duty.
+ * El término D se calcula sobre la medición (sin golpe al cambiar el
+ * setpoint), la integral se congela mientras la salida está saturada en
+ * la dirección del error, y el cambio de salida se limita a rate_limit.
+ *
+ * @return Nuevo duty en por mil.
+ */
+int32_t fan_pid_update(fan_pid_t *pid, int32_t setpoint, int32_t measurement, uint32_t dt_ms)
+{
+    int32_t error = measurement - setpoint;
+
+    int32_t p = (int32_t)(((int64_t)pid->kp_q8 * error) >> 8);
+
+    int32_t d = 0;
+    if (pid->primed && dt_ms > 0) {
+        int32_t slope = (int32_t)(((int64_t)(measurement - pid->prev_measurement) * 1000) / (int32_t)dt_ms);
+        d = (int32_t)(((int64_t)pid->kd_q8 * slope) >> 8);
+    }
+    pid->prev_measurement = measurement;
+    pid->primed = true;
+
+    // Integral tentativa (‰ x 1000)
+    int64_t integral = pid->integral + (((int64_t)pid->ki_q8 * error * (int64_t)dt_ms) >> 8);
+    int64_t i_max = (int64_t)pid->out_max * 1000;
+    int64_t i_min = (int64_t)pid->out_min * 1000;
+    if (integral > i_max) integral = i_max;
+    if (integral < i_min) integral = i_min;
+
+    int32_t unsaturated = p + (int32_t)(integral / 1000) + d;
+
+    // Anti-windup: no integrar si empuja más allá de la saturación
+    if ((unsaturated > pid->out_max && error > 0) ||
+        (unsaturated < pid->out_min && error < 0)) {
+        unsaturated = p + (int32_t)(pid->integral / 1000) + d;
+    } else {
+        pid->integral = integral;
+    }
+
+    int32_t target = clamp(unsaturated, pid->out_min, pid->out_max);
+
+    // Limitador de pendiente: menos ruido y picos de corriente
+    int32_t max_step = (int32_t)(((int64_t)pid->rate_limit * dt_ms) / 1000);
+    if (max_step < 1) {
+        max_step = 1;
+    }
+    pid->output += clamp(target - pid->output, -max_step, max_step);
+
+    return pid->output;
+}
@@ -0,0 +1,105 @@
+#include "fan_pwm.h"
+#include "fan_ramp.h"
+
+// TIM3 es de 16 bits; el 100 % de duty (CCR = ARR + 1) también debe caber en 16 bits
+#define FAN_PWM_MAX_PERIOD 65535u
+
+/**
+ * @brief Calcula PSC y ARR para una frecuencia PWM dada.
+ *
+ * Se usa el menor prescaler posible, que deja el periodo más largo y por
+ * lo tanto la mayor resolución de duty.
+ *
+ * @param timer_clock_hz Reloj de entrada del timer.
+ * @param frequency_hz Frecuencia PWM pedida.
+ * @param min_resolution_bits Resolución mínima aceptable.
+ * @param config Resultado (solo válido si retorna true).
+ * @return false si la frecuencia no es alcanzable con esa resolución.
+ */
+bool fan_pwm_compute(uint32_t timer_clock_hz, uint32_t frequency_hz,
+                     uint8_t min_resolution_bits, fan_pwm_config_t *config)
+{
+    if (frequency_hz == 0 || frequency_hz > timer_clock_hz) {
+        return false;
+    }
+
+    uint32_t ticks = timer_clock_hz / frequency_hz;
+    uint32_t prescaler = (ticks - 1) / FAN_PWM_MAX_PERIOD;
+    if (prescaler > 0xFFFF) {
+        return false;
+    }
+
+    // Redondeo al periodo más cercano a la frecuencia pedida
+    uint32_t divided = timer_clock_hz / (prescaler + 1);
+    uint32_t period = (divided + frequency_hz / 2) / frequency_hz;
+    if (period > FAN_PWM_MAX_PERIOD) {
+        period = FAN_PWM_MAX_PERIOD;
+    }
+    if (period < 2) {
+        return false;
+    }
+
+    uint8_t bits = 0;
+    while (bits < 16 && (1u << (bits + 1)) <= period) {
+        bits++;
+    }
+    if (bits < min_resolution_bits) {
+        return false;
+    }
+
+    config->prescaler = prescaler;
+    config->period = period;
+    config->frequency_hz = divided / period;
+    config->resolution_bits = bits;
+    return true;
+}
+
+/**
+ * @brief Reloj de TIM3: PCLK1, o el doble si APB1 tiene prescaler.
+ */
+uint32_t fan_pwm_timer_clock_hz(void)
+{
+    uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) {
+        return pclk1 * 2;
+    }
+    return pclk1;
+}
+
+/**
+ * @brief Reprograma la frecuencia PWM del ventilador en caliente.
+ *
+ * El duty se conserva: el CCR actual y el buffer de rampas se reescalan
+ * al nuevo periodo antes de forzar el update del timer.
+ */
+bool fan_pwm_configure(TIM_HandleTypeDef *htim, uint32_t frequency_hz, uint8_t min_resolution_bits)
+{
+    fan_pwm_config_t config;
+
+    if (!fan_pwm_compute(fan_pwm_timer_clock_hz(), frequency_hz, min_resolution_bits, &config)) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t old_period = __HAL_TIM_GET_AUTORELOAD(htim) + 1;
+
+    __HAL_TIM_SET_PRESCALER(htim, config.prescaler);
+    htim->Init.Prescaler = config.prescaler;
+    __HAL_TIM_SET_AUTORELOAD(htim, config.period - 1);
+    fan_ramp_rescale(old_period, config.period);
+
+    // Cargar PSC/ARR de inmediato en lugar de esperar al próximo update
+    htim->Instance->EGR = TIM_EGR_UG;
+
+    __set_PRIMASK(primask);
+    return true;
+}
+
+uint32_t fan_pwm_get_frequency(TIM_HandleTypeDef *htim)
+{
+    uint32_t ticks = (htim->Instance->PSC + 1) * (__HAL_TIM_GET_AUTORELOAD(htim) + 1);
+    return fan_pwm_timer_clock_hz() / ticks;
+}
@@ -0,0 +1,294 @@
+#include "fan_ramp.h"
+#include "fan_pwm.h"
+
+/*
+ * Motor de rampas del ventilador
+ *
+ * Un canal DMA en modo circular copia fan_ramp_buffer[] a TIM3->CCR1 en
+ * cada evento de update del timer (una muestra por periodo PWM). Mientras
+ * hay una rampa en curso, las interrupciones de media transferencia y
+ * transferencia completa rellenan la mitad que el DMA acaba de consumir.
+ * Cuando el buffer entero queda en el valor final se apagan esas
+ * interrupciones y el DMA sigue repitiendo el mismo CCR sin costo de CPU.
+ */
+
+#define Q15_ONE          32768u
+#define FAN_RAMP_HALF    (FAN_RAMP_BUFFER_LEN / 2)
+#define FAN_RAMP_MAX_MS  10000u
+
+// (1 - e^(-5t)) / (1 - e^(-5)) en Q15, t = 0, 1/16, ..., 1
+static const uint16_t exp_curve_q15[17] = {
+    0, 8854, 15332, 20071, 23538, 26075, 27931, 29289, 30282,
+    31009, 31541, 31930, 32214, 32423, 32575, 32686, 32768
+};
+
+typedef struct {
+    TIM_HandleTypeDef *htim;
+    DMA_HandleTypeDef *hdma;
+    bool dma_running;
+
+    fan_ramp_curve_t curve;
+    uint32_t duration_ms;
+
+    uint16_t start;        // CCR al inicio de la rampa
+    uint16_t target;       // CCR final
+    uint32_t elapsed;      // periodos PWM ya generados
+    uint32_t duration;     // periodos PWM totales de la rampa
+    uint8_t idle_halves;   // mitades seguidas rellenas solo con el valor final
+} fan_ramp_t;
+
+static fan_ramp_t ramp = {
+    .curve = FAN_RAMP_LINEAR,
+    .duration_ms = 200
+};
+
+static uint16_t fan_ramp_buffer[FAN_RAMP_BUFFER_LEN];
+
+static void fan_ramp_half_cplt(DMA_HandleTypeDef *hdma);
+static void fan_ramp_cplt(DMA_HandleTypeDef *hdma);
+
+/**
+ * @brief Forma de la curva de transición.
+ *
+ * @param curve Perfil seleccionado.
+ * @param progress_q15 Avance de la rampa, 0 (inicio) .. 32768 (fin).
+ * @return Fracción del recorrido en Q15, 0 .. 32768.
+ */
+uint16_t fan_ramp_curve(fan_ramp_curve_t curve, uint16_t progress_q15)
+{
+    uint32_t p = progress_q15;
+
+    if (p >= Q15_ONE) {
+        return Q15_ONE;
+    }
+
+    switch (curve) {
+        case FAN_RAMP_S_CURVE: {
+            // 3p^2 - 2p^3 = p^2 (3 - 2p), con un único redondeo al final
+            // para que la curva no retroceda por truncar p^2 y p^3 por separado
+            uint64_t p2 = (uint64_t)p * p;
+            return (uint16_t)((p2 * (3U * Q15_ONE - 2U * p)) >> 30);
+        }
+
+        case FAN_RAMP_EXPONENTIAL: {
+            // Interpolación lineal entre 16 tramos de la tabla
+            uint32_t idx = p >> 11;
+            uint32_t frac = p & 0x7FF;
+            uint32_t a = exp_curve_q15[idx];
+            uint32_t b = exp_curve_q15[idx + 1];
+            return (uint16_t)(a + (((b - a) * frac) >> 11));
+        }
+
+        case FAN_RAMP_LINEAR:
+        default:
+            return (uint16_t)p;
+    }
+}
+
+// Periodos PWM que dura una rampa con la configuración actual del timer
+static uint32_t fan_ramp_duration_periods(void)
+{
+    TIM_TypeDef *tim = ramp.htim->Instance;
+    uint32_t ticks_per_period = (tim->PSC + 1) * (tim->ARR + 1);
+    uint32_t pwm_hz = fan_pwm_timer_clock_hz() / ticks_per_period;
+    uint32_t periods = (uint32_t)(((uint64_t)ramp.duration_ms * pwm_hz) / 1000u);
+
+    return (periods > 0) ? periods : 1;
+}
+
+static uint16_t fan_ramp_next_sample(void)
+{
+    if (ramp.elapsed >= ramp.duration) {
+        return ramp.target;
+    }
+
+    ramp.elapsed++;
+    uint16_t progress = (uint16_t)(((uint64_t)ramp.elapsed << 15) / ramp.duration);
+    int32_t delta = (int32_t)ramp.target - (int32_t)ramp.start;
+    int32_t step = (int32_t)(((int64_t)delta * fan_ramp_curve(ramp.curve, progress)) / (int32_t)Q15_ONE);
+
+    return (uint16_t)((int32_t)ramp.start + step);
+}
+
+// Rellena una mitad del buffer; apaga las interrupciones cuando ya no hay rampa
+static void fan_ramp_fill(uint16_t *half)
+{
+    if (ramp.elapsed >= ramp.duration) {
+        ramp.idle_halves++;
+    } else {
+        ramp.idle_halves = 0;
+    }
+
+    for (uint32_t i = 0; i < FAN_RAMP_HALF; i++) {
+        half[i] = fan_ramp_next_sample();
+    }
+
+    if (ramp.idle_halves >= 2) {
+        __HAL_DMA_DISABLE_IT(ramp.hdma, DMA_IT_HT | DMA_IT_TC);
+    }
+}
+
+/**
+ * @brief Arranca el DMA circular sobre el CCR1 del timer del ventilador.
+ *
+ * El canal DMA se toma de htim->hdma[TIM_DMA_ID_UPDATE] (enlazado en el
+ * MSP). Si no hay DMA disponible los cambios de nivel se aplican directo.
+ */
+void fan_ramp_init(TIM_HandleTypeDef *htim)
+{
+    uint16_t ccr = (uint16_t)__HAL_TIM_GET_COMPARE(htim, TIM_CHANNEL_1);
+
+    ramp.htim = htim;
+    ramp.hdma = htim->hdma[TIM_DMA_ID_UPDATE];
+    ramp.dma_running = false;
+    ramp.start = ccr;
+    ramp.target = ccr;
+    ramp.elapsed = 0;
+    ramp.duration = 0;
+    ramp.idle_halves = 2;
+
+    for (uint32_t i = 0; i < FAN_RAMP_BUFFER_LEN; i++) {
+        fan_ramp_buffer[i] = ccr;
+    }
+
+    if (ramp.hdma == NULL) {
+        return;
+    }
+
+    ramp.hdma->XferHalfCpltCallback = fan_ramp_half_cplt;
+    ramp.hdma->XferCpltCallback = fan_ramp_cplt;
+
+    if (HAL_DMA_Start_IT(ramp.hdma,
+                         (uintptr_t)fan_ramp_buffer,
+                         (uintptr_t)&htim->Instance->CCR1,
+                         FAN_RAMP_BUFFER_LEN) != HAL_OK) {
+        return;
+    }
+
+    // Sin rampa en curso no hace falta rellenar el buffer
+    __HAL_DMA_DISABLE_IT(ramp.hdma, DMA_IT_HT | DMA_IT_TC);
+    __HAL_TIM_ENABLE_DMA(htim, TIM_DMA_UPDATE);
+    ramp.dma_running = true;
+}
+
+/**
+ * @brief Selecciona el perfil y la duración de las próximas rampas.
+ */
+void fan_ramp_configure(fan_ramp_curve_t curve, uint32_t duration_ms)
+{
+    if (duration_ms > FAN_RAMP_MAX_MS) {
+        duration_ms = FAN_RAMP_MAX_MS;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    ramp.curve = curve;
+    ramp.duration_ms = duration_ms;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Lleva el CCR del ventilador hacia un nuevo valor.
+ *
+ * Puede llamarse en medio de otra rampa: la nueva parte del último valor
+ * ya encolado en el DMA, así que no hay saltos ni se reinicia el canal.
+ */
+void fan_ramp_set_target(uint16_t ccr)
+{
+    if (!ramp.dma_running) {
+        __HAL_TIM_SET_COMPARE(ramp.htim, TIM_CHANNEL_1, ccr);
+        ramp.target = ccr;
+        return;
+    }
+
+    if (ccr == ramp.target) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // La mitad que el DMA no está leyendo se puede reescribir ya
+    uint32_t pos = FAN_RAMP_BUFFER_LEN - __HAL_DMA_GET_COUNTER(ramp.hdma);
+    uint16_t *playing = (pos < FAN_RAMP_HALF) ? &fan_ramp_buffer[0] : &fan_ramp_buffer[FAN_RAMP_HALF];
+    uint16_t *next = (pos < FAN_RAMP_HALF) ? &fan_ramp_buffer[FAN_RAMP_HALF] : &fan_ramp_buffer[0];
+
+    ramp.start = playing[FAN_RAMP_HALF - 1];
+    ramp.target = ccr;
+    ramp.elapsed = 0;
+    ramp.duration = fan_ramp_duration_periods();
+    ramp.idle_halves = 0;
+
+    fan_ramp_fill(next);
+
+    // Si el DMA pasó a la mitad recién escrita mientras se calculaba, la que
+    // dejó ya se puede reescribir: su interrupción se descarta abajo
+    uint32_t now = FAN_RAMP_BUFFER_LEN - __HAL_DMA_GET_COUNTER(ramp.hdma);
+    if ((now < FAN_RAMP_HALF) != (pos < FAN_RAMP_HALF)) {
+        fan_ramp_fill(playing);
+    }
+
+    // Descartar banderas viejas para que la próxima interrupción sea la de esta vuelta
+    __HAL_DMA_CLEAR_FLAG(ramp.hdma, __HAL_DMA_GET_HT_FLAG_INDEX(ramp.hdma) |
+                                    __HAL_DMA_GET_TC_FLAG_INDEX(ramp.hdma));
+    __HAL_DMA_ENABLE_IT(ramp.hdma, DMA_IT_HT | DMA_IT_TC);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Reescala CCR, rampa en curso y buffer DMA a un nuevo periodo PWM
+ * (cambio de frecuencia/resolución) conservando el duty y el avance.
+ * Debe llamarse con interrupciones deshabilitadas.
+ */
+void fan_ramp_rescale(uint32_t old_period, uint32_t new_period)
+{
+    if (old_period == 0 || old_period == new_period) {
+        return;
+    }
+
+#define FAN_RAMP_SCALE(v) ((uint16_t)(((uint32_t)(v) * new_period) / old_period))
+
+    for (uint32_t i = 0; i < FAN_RAMP_BUFFER_LEN; i++) {
+        fan_ramp_buffer[i] = FAN_RAMP_SCALE(fan_ramp_buffer[i]);
+    }
+    ramp.start = FAN_RAMP_SCALE(ramp.start);
+    ramp.target = FAN_RAMP_SCALE(ramp.target);
+
+    if (ramp.htim != NULL) {
+        __HAL_TIM_SET_COMPARE(ramp.htim, TIM_CHANNEL_1,
+                              FAN_RAMP_SCALE(__HAL_TIM_GET_COMPARE(ramp.htim, TIM_CHANNEL_1)));
+
+        // La rampa sigue en el mismo punto relativo con la nueva cantidad de periodos
+        if (ramp.elapsed < ramp.duration) {
+            uint32_t duration = fan_ramp_duration_periods();
+            ramp.elapsed = (uint32_t)(((uint64_t)ramp.elapsed * duration) / ramp.duration);
+            ramp.duration = duration;
+        }
+    }
+
+#undef FAN_RAMP_SCALE
+}
+
+uint16_t fan_ramp_get_target(void)
+{
+    return ramp.target;
+}
+
+bool fan_ramp_is_active(void)
+{
+    return ramp.elapsed < ramp.duration;
+}
+
+// Callbacks del DMA: el DMA terminó de leer una mitad, se rellena con lo que sigue
+static void fan_ramp_half_cplt(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    fan_ramp_fill(&fan_ramp_buffer[0]);
+}
+
+static void fan_ramp_cplt(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    fan_ramp_fill(&fan_ramp_buffer[FAN_RAMP_HALF]);
+}
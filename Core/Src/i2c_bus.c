@@ -0,0 +1,136 @@
+#include "i2c_bus.h"
+#include "ssd1306.h"
+
+// Valores de TIMINGR para un reloj de I2C1 = PCLK1 = 80 MHz (CubeMX)
+typedef struct {
+    uint32_t khz;
+    uint32_t timing;
+} i2c_bus_mode_t;
+
+static const i2c_bus_mode_t i2c_bus_modes[] = {
+    {  100, 0x10909CEC },   // Standard-mode
+    {  400, 0x00702991 },   // Fast-mode
+    { 1000, 0x00300F33 },   // Fast-mode Plus (requiere FMP en los pines)
+};
+
+#define I2C_BUS_MODE_COUNT  (sizeof(i2c_bus_modes) / sizeof(i2c_bus_modes[0]))
+#define I2C_BUS_NO_REQUEST  0xFFu
+
+// Errores que indican que el display no sigue la velocidad actual
+#define I2C_BUS_FALLBACK_ERRORS \
+    (HAL_I2C_ERROR_AF | HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_TIMEOUT)
+
+static struct {
+    I2C_HandleTypeDef *hi2c;
+    uint8_t mode;
+    volatile uint8_t requested;
+    uint32_t fallbacks;
+} bus = { .requested = I2C_BUS_NO_REQUEST };
+
+static bool i2c_bus_find(uint32_t khz, uint8_t *mode)
+{
+    for (uint8_t i = 0; i < I2C_BUS_MODE_COUNT; i++) {
+        if (i2c_bus_modes[i].khz == khz) {
+            *mode = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Reprograma TIMINGR; no se debe llamar con una transferencia en curso
+static void i2c_bus_apply(uint8_t mode)
+{
+    bus.hi2c->Init.Timing = i2c_bus_modes[mode].timing;
+    if (HAL_I2C_Init(bus.hi2c) != HAL_OK) {
+        Error_Handler();
+    }
+
+    if (i2c_bus_modes[mode].khz > 400) {
+        HAL_I2CEx_EnableFastModePlus(I2C_FASTMODEPLUS_I2C1);
+    } else {
+        HAL_I2CEx_DisableFastModePlus(I2C_FASTMODEPLUS_I2C1);
+    }
+    bus.mode = mode;
+}
+
+/**
+ * @brief Toma el handle ya inicializado por MX_I2C1_Init() y fija la velocidad.
+ *
+ * @param khz 100, 400 o 1000; otro valor deja la configuración de CubeMX.
+ */
+void i2c_bus_init(I2C_HandleTypeDef *hi2c, uint32_t khz)
+{
+    uint8_t mode = 0;
+
+    bus.hi2c = hi2c;
+    bus.mode = 0;
+    bus.requested = I2C_BUS_NO_REQUEST;
+    bus.fallbacks = 0;
+    if (i2c_bus_find(khz, &mode)) {
+        i2c_bus_apply(mode);
+    }
+}
+
+/**
+ * @brief Pide un cambio de velocidad (desde el parser, en contexto de ISR).
+ *
+ * El cambio se aplica en i2c_bus_poll() para no reprogramar el periférico
+ * en medio de una escritura del superloop.
+ *
+ * @return false si la velocidad no está soportada.
+ */
+bool i2c_bus_request_speed(uint32_t khz)
+{
+    uint8_t mode;
+
+    if (!i2c_bus_find(khz, &mode)) {
+        return false;
+    }
+    bus.requested = mode;
+    return true;
+}
+
+/**
+ * @brief Aplica un cambio de velocidad pendiente. Llamar desde el superloop.
+ */
+void i2c_bus_poll(void)
+{
+    uint8_t mode = bus.requested;
+
+    if (mode == I2C_BUS_NO_REQUEST || bus.hi2c == NULL) {
+        return;
+    }
+    bus.requested = I2C_BUS_NO_REQUEST;
+    if (mode != bus.mode) {
+        i2c_bus_apply(mode);
+    }
+}
+
+uint32_t i2c_bus_get_speed(void)
+{
+    return i2c_bus_modes[bus.mode].khz;
+}
+
+uint32_t i2c_bus_get_fallbacks(void)
+{
+    return bus.fallbacks;
+}
+
+/**
+ * @brief Hook del driver SSD1306 tras una transacción fallida: baja un
+ * escalón de velocidad y pide reintentar.
+ */
+uint8_t ssd1306_I2C_ErrorCallback(HAL_StatusTypeDef status, uint32_t error)
+{
+    if (bus.hi2c == NULL || bus.mode == 0) {
+        return 0;
+    }
+    if (status != HAL_TIMEOUT && (error & I2C_BUS_FALLBACK_ERRORS) == 0) {
+        return 0;
+    }
+
+    i2c_bus_apply(bus.mode - 1);
+    bus.fallbacks++;
+    return 1;
+}
@@ -0,0 +1,238 @@
+#include "loop_monitor.h"
+#include "prof.h"   // PROF_CYCLES(): contador de ciclos del DWT
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *const loop_section_names[LOOP_SEC_COUNT] = {
+    [LOOP_SEC_HEARTBEAT] = "heartbeat",
+    [LOOP_SEC_ROOM]      = "room",
+    [LOOP_SEC_KEYPAD]    = "keypad",
+    [LOOP_SEC_DEMO]      = "demo",
+    [LOOP_SEC_TEMP]      = "temp",
+    [LOOP_SEC_TELEMETRY] = "telemetry",
+    [LOOP_SEC_ALERTS]    = "alerts",
+    [LOOP_SEC_USERS]     = "users",
+    [LOOP_SEC_RTC]       = "rtc",
+    [LOOP_SEC_SCHEDULE]  = "schedule",
+    [LOOP_SEC_PUBLISH]   = "publish",
+    [LOOP_SEC_TLOG]      = "tlog",
+};
+
+static struct {
+    uint32_t cycles_per_us;
+    bool started;
+    uint32_t iteration_start;
+
+    // Sección en curso y tiempo acumulado por sección en esta vuelta
+    bool in_section;
+    loop_section_t section;
+    uint32_t section_start;
+    uint32_t section_cycles[LOOP_SEC_COUNT];
+
+    uint32_t alarm_us;
+    uint32_t alarms;
+    uint32_t alarms_suppressed;
+    uint32_t last_alarm_tick;
+
+    loop_histogram_t loop;
+    loop_histogram_t key;
+} mon;
+
+static uint32_t loop_monitor_to_us(uint32_t cycles)
+{
+    return cycles / mon.cycles_per_us;
+}
+
+static void loop_histogram_record(loop_histogram_t *h, uint32_t us)
+{
+    uint32_t bucket = (us == 0) ? 0 : 32u - (uint32_t)__builtin_clz(us);
+    if (bucket >= LOOP_MON_BUCKETS) {
+        bucket = LOOP_MON_BUCKETS - 1;
+    }
+
+    h->count++;
+    h->sum_us += us;
+    if (us > h->max_us) {
+        h->max_us = us;
+    }
+    h->buckets[bucket]++;
+}
+
+// Cota superior (µs) del intervalo donde cae el percentil pedido
+static uint32_t loop_histogram_percentile(const loop_histogram_t *h, uint32_t percent)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)h->count * percent + 99u) / 100u);
+    uint32_t seen = 0;
+
+    for (uint32_t b = 0; b < LOOP_MON_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank && seen > 0) {
+            uint32_t upper = (b == 0) ? 0 : (1u << b) - 1u;
+            return (upper < h->max_us) ? upper : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+static void loop_histogram_print(const char *name, const loop_histogram_t *h)
+{
+    if (h->count == 0) {
+        printf("LAT: %s n=0\r\n", name);
+        return;
+    }
+
+    printf("LAT: %s n=%lu avg=%luus p50=%luus p99=%luus max=%luus\r\n", name,
+           (unsigned long)h->count, (unsigned long)(h->sum_us / h->count),
+           (unsigned long)loop_histogram_percentile(h, 50),
+           (unsigned long)loop_histogram_percentile(h, 99),
+           (unsigned long)h->max_us);
+
+    // Histograma: "<cota µs>:<conteo>" solo para los intervalos con muestras
+    printf("LAT: %s hist", name);
+    for (uint32_t b = 0; b < LOOP_MON_BUCKETS; b++) {
+        if (h->buckets[b] != 0) {
+            printf(" <%lu:%lu", (unsigned long)(1u << b), (unsigned long)h->buckets[b]);
+        }
+    }
+    printf("\r\n");
+}
+
+static void loop_monitor_close_section(uint32_t now)
+{
+    if (mon.in_section) {
+        mon.section_cycles[mon.section] += now - mon.section_start;
+        mon.in_section = false;
+    }
+}
+
+static void loop_monitor_alarm(uint32_t total_us)
+{
+    loop_section_t culprit = LOOP_SEC_HEARTBEAT;
+    for (uint32_t s = 1; s < LOOP_SEC_COUNT; s++) {
+        if (mon.section_cycles[s] > mon.section_cycles[culprit]) {
+            culprit = (loop_section_t)s;
+        }
+    }
+
+    mon.alarms++;
+    telemetry_event(TLM_EVT_LOOP_ALARM);
+
+    // El printf bloquea varios ms: limitar la tasa para no provocar más alarmas
+    uint32_t now_ms = HAL_GetTick();
+    if (mon.alarms > 1 && now_ms - mon.last_alarm_tick < LOOP_MON_ALARM_HOLDOFF_MS) {
+        mon.alarms_suppressed++;
+        return;
+    }
+    mon.last_alarm_tick = now_ms;
+
+    printf("LAT ALARM: loop=%luus > %luus, seccion=%s (%luus), omitidas=%lu\r\n",
+           (unsigned long)total_us, (unsigned long)mon.alarm_us,
+           loop_section_names[culprit],
+           (unsigned long)loop_monitor_to_us(mon.section_cycles[culprit]),
+           (unsigned long)mon.alarms_suppressed);
+    mon.alarms_suppressed = 0;
+}
+
+/**
+ * @brief Habilita el contador de ciclos del DWT y limpia los histogramas.
+ */
+void loop_monitor_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    memset(&mon, 0, sizeof(mon));
+    mon.cycles_per_us = SystemCoreClock / 1000000u;
+    if (mon.cycles_per_us == 0) {
+        mon.cycles_per_us = 1;
+    }
+    mon.alarm_us = LOOP_MON_DEFAULT_ALARM_US;
+}
+
+/**
+ * @brief Marca el inicio de una vuelta del superloop (y el fin de la anterior).
+ */
+void loop_monitor_iteration(void)
+{
+    uint32_t now = PROF_CYCLES();
+
+    loop_monitor_close_section(now);
+
+    if (mon.started) {
+        uint32_t total_us = loop_monitor_to_us(now - mon.iteration_start);
+        loop_histogram_record(&mon.loop, total_us);
+
+        if (mon.alarm_us != 0 && total_us > mon.alarm_us) {
+            loop_monitor_alarm(total_us);
+            // No contar el propio aviso en la próxima vuelta
+            now = PROF_CYCLES();
+        }
+    }
+
+    memset(mon.section_cycles, 0, sizeof(mon.section_cycles));
+    mon.started = true;
+    mon.iteration_start = now;
+}
+
+/**
+ * @brief Cierra la sección anterior y empieza a contar section.
+ */
+void loop_monitor_section(loop_section_t section)
+{
+    uint32_t now = PROF_CYCLES();
+
+    loop_monitor_close_section(now);
+    mon.section = section;
+    mon.section_start = now;
+    mon.in_section = true;
+}
+
+/**
+ * @brief Marca de tiempo para medir latencias (se puede llamar desde una ISR).
+ */
+uint32_t loop_monitor_now(void)
+{
+    return PROF_CYCLES();
+}
+
+/**
+ * @brief Registra la latencia de una tecla desde su EXTI hasta ahora.
+ *
+ * @param exti_timestamp Valor de loop_monitor_now() tomado en la EXTI.
+ */
+void loop_monitor_key_latency(uint32_t exti_timestamp)
+{
+    loop_histogram_record(&mon.key, loop_monitor_to_us(PROF_CYCLES() - exti_timestamp));
+}
+
+/**
+ * @brief Umbral de alarma por vuelta del superloop (0 = deshabilitada).
+ */
+void loop_monitor_set_alarm(uint32_t threshold_us)
+{
+    mon.alarm_us = threshold_us;
+}
+
+uint32_t loop_monitor_get_alarm(void)
+{
+    return mon.alarm_us;
+}
+
+/**
+ * @brief Imprime los histogramas de loop y de teclas y los reinicia.
+ */
+void loop_monitor_dump(void)
+{
+    loop_histogram_print("loop", &mon.loop);
+    loop_histogram_print("key", &mon.key);
+    printf("LAT: alarm=%luus alarms=%lu\r\n",
+           (unsigned long)mon.alarm_us, (unsigned long)mon.alarms);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&mon.loop, 0, sizeof(mon.loop));
+    memset(&mon.key, 0, sizeof(mon.key));
+    mon.alarms = 0;
+    __set_PRIMASK(primask);
+}
@@ -21,16 +21,8 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-#include "led.h"
-#include "keypad.h"
-#include "ring_buffer.h"
-#include "room_control.h"
-#include <stdio.h>
-
-#include "ssd1306.h"
-#include "ssd1306_fonts.h"
-#include "temperature_sensor.h"
-#include "command_parser.h"
+#include "app.h"
+#include "tlog.h"
 
 /* USER CODE END Includes */
 
@@ -54,38 +46,16 @@ ADC_HandleTypeDef hadc1;
 
 I2C_HandleTypeDef hi2c1;
 
+RTC_HandleTypeDef hrtc;
+
 TIM_HandleTypeDef htim3;
-DMA_HandleTypeDef hdma_tim3_ch1_trig;
+DMA_HandleTypeDef hdma_tim3_up;
 
 UART_HandleTypeDef huart2;
 UART_HandleTypeDef huart3;
 
 /* USER CODE BEGIN PV */
-uint8_t button_pressed = 0; // Flag to indicate if the button is pressed
-
-led_handle_t heartbeat_led = {
-    .port = LD2_GPIO_Port,
-    .pin = LD2_Pin
-};
-
-uint8_t usart_2_rxbyte = 0; // Variable to hold received byte from UART3
-
-keypad_handle_t keypad = {
-    .row_ports = {KEYPAD_R1_GPIO_Port, KEYPAD_R2_GPIO_Port, KEYPAD_R3_GPIO_Port, KEYPAD_R4_GPIO_Port},
-    .row_pins  = {KEYPAD_R1_Pin, KEYPAD_R2_Pin, KEYPAD_R3_Pin, KEYPAD_R4_Pin},
-    .col_ports = {KEYPAD_C1_GPIO_Port, KEYPAD_C2_GPIO_Port, KEYPAD_C3_GPIO_Port, KEYPAD_C4_GPIO_Port},
-    .col_pins  = {KEYPAD_C1_Pin, KEYPAD_C2_Pin, KEYPAD_C3_Pin, KEYPAD_C4_Pin}
-};
-
-#define KEYPAD_BUFFER_LEN 16
-uint8_t keypad_buffer[KEYPAD_BUFFER_LEN];
-ring_buffer_t keypad_rb;
-
-volatile uint16_t keypad_interrupt_pin = 0;
-volatile uint16_t keypad_interrupt_time = 0; // Tiempo de la interrupción
 
-// Room control system instance
-room_control_t room_system;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -97,6 +67,7 @@ static void MX_I2C1_Init(void);
 static void MX_TIM3_Init(void);
 static void MX_ADC1_Init(void);
 static void MX_USART3_UART_Init(void);
+static void MX_RTC_Init(void);
 /* USER CODE BEGIN PFP */
 
 /* USER CODE END PFP */
@@ -109,48 +80,11 @@ static void MX_USART3_UART_Init(void);
 int _write(int file, char *ptr, int len)
 {
   (void)file;
+  tlog_flush();   // Tramas de TLOG() encoladas antes que este texto
   HAL_UART_Transmit(&huart2, (uint8_t *)ptr, len, HAL_MAX_DELAY);
   return len;
 }
 
-void write_to_oled(char *message, SSD1306_COLOR color, uint8_t x, uint8_t y)
-{
-  ssd1306_SetCursor(x, y); // Set cursor to the specified position
-  ssd1306_WriteString(message, Font_7x10, color);
-  ssd1306_UpdateScreen(); // Update the display to show the message
-}
-
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
-{
-  if (GPIO_Pin == B1_Pin) {
-    button_pressed = 1; // Set the flag when the button is pressed
-  } else {
-    keypad_interrupt_pin = GPIO_Pin;
-    keypad_interrupt_time = HAL_GetTick(); // Guardar el tiempo de la interrupción
-  }
-}
-
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
-{
-  if (huart->Instance == USART2) {
-    // Enviar el byte al parser de debug
-    command_parser_process_debug(usart_2_rxbyte);
-
-    // Re-armar recepción
-    HAL_UART_Receive_IT(&huart2, &usart_2_rxbyte, 1);
-  }
-  // USART3 lo usaremos en nivel intermedio
-}
-
-void heartbeat(void)
-{
-  static uint32_t last_toggle = 0;
-  if (HAL_GetTick() - last_toggle >= 500) { // Toggle every 500 ms
-    led_toggle(&heartbeat_led); // Toggle the heartbeat LED
-    last_toggle = HAL_GetTick();
-  }
-}
-
 /* USER CODE END 0 */
 
 /**
@@ -188,87 +122,17 @@ int main(void)
   MX_TIM3_Init();
   MX_ADC1_Init();
   MX_USART3_UART_Init();
+  MX_RTC_Init();
   /* USER CODE BEGIN 2 */
-  led_init(&heartbeat_led);
-  ssd1306_Init();
-  HAL_UART_Receive_IT(&huart2, &usart_2_rxbyte, 1);
-  
-  ring_buffer_init(&keypad_rb, keypad_buffer, KEYPAD_BUFFER_LEN);
-  keypad_init(&keypad);
-  
-  temperature_sensor_init();  // Inicializar módulo de temperatura (LM35)
-
-  // TODO: TAREA - Descomentar cuando implementen la lógica del sistema
-  room_control_init(&room_system);
+  app_init();
 
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
-  // Clear the display
-  ssd1306_Fill(Black);
-  // write_to_oled("Hello, 4100901!", White, 17, 17);
-  // printf("Hello, 4100901!\r\n");
-  printf("Sistema iniciado\r\n");
   while (1) {
-    heartbeat(); // Call the heartbeat function to toggle the LED
-
-    // TODO: TAREA - Descomentar cuando implementen la máquina de estados
-    room_control_update(&room_system);
-
-    // DEMO: Keypad functionality - Remove when implementing room control logic
-    static uint32_t last_key_time = 0;      // Guardar el tiempo de la última tecla
-    static char last_key_value = '\0';      // Guardar el valor de la última tecla
-
-    if (keypad_interrupt_pin != 0) {
-      uint32_t now = HAL_GetTick();
-
-      // Esperar un pequeño tiempo de estabilización del contacto (debounce)
-      if (now - keypad_interrupt_time >= 20) {   // ~20 ms de debounce
-
-        char key = keypad_scan(&keypad, keypad_interrupt_pin);
-        if (key != '\0') {
+    app_loop();
 
-          // Filtro extra: si es la misma tecla rebotando muy seguido, la ignoramos
-          if ((now - last_key_time > 150) || (key != last_key_value)) {
-
-            write_to_oled(&key, White, 31, 31);
-
-            // Debug: mostrar tecla y estado actual
-            printf("[KEYPAD] Tecla: %c, estado actual: %d\r\n",
-              key, room_control_get_state(&room_system));
-
-            // TODO: TAREA - Descomentar para enviar teclas al sistema de control
-            room_control_process_key(&room_system, key);
-
-            last_key_time = now;
-            last_key_value = key;
-          }
-        }
-
-        keypad_interrupt_pin = 0;
-      }
-    }
-
-    // DEMO: Button functionality - Remove when implementing room control logic  
-    if (button_pressed) {
-      write_to_oled("Button Pressed!", White, 17, 17); // Display message on OLED
-      button_pressed = 0; // Reset the flag
-    }
-
-    // DEMO: UART functionality - Remove when implementing room control logic
-    if (usart_2_rxbyte != 0) {
-      write_to_oled((char *)&usart_2_rxbyte, White, 31, 31); // Display received byte on OLED
-      usart_2_rxbyte = 0; // Reset the received byte variable
-    }
-
-    // TODO: TAREA - Implementar procesamiento de comandos remotos
-    // command_parser_process(); // Procesar comandos de UART2 y UART3
-    
-    // TODO: TAREA - Leer sensor de temperatura y actualizar sistema
-    float temperature = temperature_sensor_read();
-    room_control_set_temperature(&room_system, temperature);
-    
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -292,10 +156,16 @@ void SystemClock_Config(void)
     Error_Handler();
   }
 
+  /** Configure LSE Drive Capability
+  */
+  HAL_PWR_EnableBkUpAccess();
+  __HAL_RCC_LSEDRIVE_CONFIG(RCC_LSEDRIVE_LOW);
+
   /** Initializes the RCC Oscillators according to the specified parameters
   * in the RCC_OscInitTypeDef structure.
   */
-  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSE|RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.LSEState = RCC_LSE_ON;
   RCC_OscInitStruct.HSIState = RCC_HSI_ON;
   RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
   RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
@@ -459,9 +329,9 @@ static void MX_TIM3_Init(void)
 
   /* USER CODE END TIM3_Init 1 */
   htim3.Instance = TIM3;
-  htim3.Init.Prescaler = 8000 - 1;
+  htim3.Init.Prescaler = 0;
   htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim3.Init.Period = 100 - 1;
+  htim3.Init.Period = 3200 - 1;
   htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
   htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
   if (HAL_TIM_PWM_Init(&htim3) != HAL_OK)
@@ -559,6 +429,43 @@ static void MX_USART3_UART_Init(void)
 
 }
 
+/**
+  * @brief RTC Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_RTC_Init(void)
+{
+
+  /* USER CODE BEGIN RTC_Init 0 */
+
+  /* USER CODE END RTC_Init 0 */
+
+  /* USER CODE BEGIN RTC_Init 1 */
+  // El calendario no se inicializa acá: sigue contando tras un reset y lo
+  // pone en hora SET_TIME (rtc_clock.c). LSE / (127 + 1) / (255 + 1) = 1 Hz
+  /* USER CODE END RTC_Init 1 */
+
+  /** Initialize RTC Only
+  */
+  hrtc.Instance = RTC;
+  hrtc.Init.HourFormat = RTC_HOURFORMAT_24;
+  hrtc.Init.AsynchPrediv = 127;
+  hrtc.Init.SynchPrediv = 255;
+  hrtc.Init.OutPut = RTC_OUTPUT_DISABLE;
+  hrtc.Init.OutPutRemap = RTC_OUTPUT_REMAP_NONE;
+  hrtc.Init.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
+  hrtc.Init.OutPutType = RTC_OUTPUT_TYPE_OPENDRAIN;
+  if (HAL_RTC_Init(&hrtc) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN RTC_Init 2 */
+
+  /* USER CODE END RTC_Init 2 */
+
+}
+
 /**
   * Enable DMA controller clock
   */
@@ -569,9 +476,9 @@ static void MX_DMA_Init(void)
   __HAL_RCC_DMA1_CLK_ENABLE();
 
   /* DMA interrupt init */
-  /* DMA1_Channel6_IRQn interrupt configuration */
-  HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+  /* DMA1_Channel3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
 
 }
 
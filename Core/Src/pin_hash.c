@@ -0,0 +1,187 @@
+#include "pin_hash.h"
+#include "prof.h"
+#include <string.h>
+
+#define PIN_MSG_LEN     (PIN_HASH_SALT_LEN + 1U + PIN_LENGTH_MAX)
+
+_Static_assert(sizeof(pin_hash_t) == 16U, "pin_hash_t se guarda tal cual en la flash");
+
+// Semilla fija de la derivación; lo que hace única a la clave es el UID
+static const uint8_t PIN_KEY_SEED[16] = {
+    'r', 'o', 'o', 'm', '-', 'c', 'o', 'n', 't', 'r', 'o', 'l', '-', 'p', 'i', 'n'
+};
+
+static uint8_t device_key[16];
+static bool device_key_ready = false;
+static uint32_t salt_counter = 0;
+
+// Helpers privados
+
+#define SIP_ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIP_ROUND(v0, v1, v2, v3)                                        \
+    do {                                                                 \
+        v0 += v1; v1 = SIP_ROTL(v1, 13); v1 ^= v0; v0 = SIP_ROTL(v0, 32); \
+        v2 += v3; v3 = SIP_ROTL(v3, 16); v3 ^= v2;                       \
+        v0 += v3; v3 = SIP_ROTL(v3, 21); v3 ^= v0;                       \
+        v2 += v1; v1 = SIP_ROTL(v1, 17); v1 ^= v2; v2 = SIP_ROTL(v2, 32); \
+    } while (0)
+
+static uint64_t pin_load_le64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int8_t i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static void pin_store_le64(uint8_t *p, uint64_t v)
+{
+    for (uint8_t i = 0; i < 8U; i++) {
+        p[i] = (uint8_t)(v >> (8U * i));
+    }
+}
+
+// Clave del equipo a partir del UID; se calcula la primera vez que hace falta
+static const uint8_t *pin_device_key(void)
+{
+    if (!device_key_ready) {
+        uint32_t uid[3] = { HAL_GetUIDw0(), HAL_GetUIDw1(), HAL_GetUIDw2() };
+        uint8_t msg[sizeof(uid) + 1U];
+        memcpy(msg, uid, sizeof(uid));
+
+        msg[sizeof(uid)] = 1U;
+        pin_store_le64(&device_key[0], pin_hash_siphash(PIN_KEY_SEED, msg, sizeof(msg)));
+        msg[sizeof(uid)] = 2U;
+        pin_store_le64(&device_key[8], pin_hash_siphash(PIN_KEY_SEED, msg, sizeof(msg)));
+        device_key_ready = true;
+    }
+    return device_key;
+}
+
+// API pública
+
+/**
+ * @brief Hash de 64 bits de una clave con la sal dada. Siempre hashea el
+ * mismo bloque de largo fijo: sal | largo | dígitos | relleno.
+ */
+uint64_t pin_hash_digest(const uint8_t salt[PIN_HASH_SALT_LEN], const char *pin, uint8_t length)
+{
+    uint8_t msg[PIN_MSG_LEN];
+    memset(msg, 0, sizeof(msg));
+    memcpy(msg, salt, PIN_HASH_SALT_LEN);
+    msg[PIN_HASH_SALT_LEN] = length;
+    memcpy(&msg[PIN_HASH_SALT_LEN + 1U], pin, (length > PIN_LENGTH_MAX) ? PIN_LENGTH_MAX : length);
+
+    uint64_t hash = pin_hash_siphash(pin_device_key(), msg, sizeof(msg));
+    memset(msg, 0, sizeof(msg));
+    return hash;
+}
+
+/**
+ * @brief Sal nueva. No es secreta, solo distinta en cada uso: tick, ciclos
+ * y un contador.
+ */
+void pin_hash_new_salt(uint8_t salt[PIN_HASH_SALT_LEN])
+{
+    uint32_t seed[3] = { HAL_GetTick(), PROF_CYCLES(), ++salt_counter };
+    uint64_t value = pin_hash_siphash(pin_device_key(), (const uint8_t *)seed, sizeof(seed));
+    memcpy(salt, &value, PIN_HASH_SALT_LEN);
+}
+
+/**
+ * @brief SipHash-2-4 de 64 bits (Aumasson y Bernstein, implementación de
+ * referencia).
+ */
+uint64_t pin_hash_siphash(const uint8_t key[16], const uint8_t *data, uint32_t len)
+{
+    uint64_t k0 = pin_load_le64(&key[0]);
+    uint64_t k1 = pin_load_le64(&key[8]);
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+    uint32_t blocks = len / 8U;
+    for (uint32_t i = 0; i < blocks; i++) {
+        uint64_t m = pin_load_le64(&data[8U * i]);
+        v3 ^= m;
+        SIP_ROUND(v0, v1, v2, v3);
+        SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // Último bloque: bytes restantes y el largo en el byte alto
+    uint64_t b = (uint64_t)len << 56;
+    for (uint32_t i = 0; i < len % 8U; i++) {
+        b |= (uint64_t)data[8U * blocks + i] << (8U * i);
+    }
+    v3 ^= b;
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xFF;
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/**
+ * @brief Entre PIN_LENGTH_MIN y PIN_LENGTH_MAX dígitos.
+ */
+bool pin_hash_valid_pin(const char *pin, uint8_t length)
+{
+    if (length < PIN_LENGTH_MIN || length > PIN_LENGTH_MAX) {
+        return false;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        if (pin[i] < '0' || pin[i] > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Hash de una clave nueva con sal nueva.
+ */
+bool pin_hash_create(pin_hash_t *stored, const char *pin, uint8_t length)
+{
+    if (!pin_hash_valid_pin(pin, length)) {
+        return false;
+    }
+
+    memset(stored, 0, sizeof(*stored));
+    stored->length = length;
+    pin_hash_new_salt(stored->salt);
+    pin_store_le64(stored->hash, pin_hash_digest(stored->salt, pin, length));
+    return true;
+}
+
+/**
+ * @brief Compara en tiempo constante: mismo trabajo para cualquier entrada
+ * de hasta PIN_LENGTH_MAX dígitos, acierte o no.
+ */
+bool pin_hash_verify(const pin_hash_t *stored, const char *pin, uint8_t length)
+{
+    uint8_t hash[PIN_HASH_LEN];
+    pin_store_le64(hash, pin_hash_digest(stored->salt, pin, length));
+
+    uint8_t diff = (uint8_t)(length ^ stored->length);
+    for (uint8_t i = 0; i < PIN_HASH_LEN; i++) {
+        diff |= (uint8_t)(hash[i] ^ stored->hash[i]);
+    }
+    return diff == 0U;
+}
+
+/**
+ * @brief Registro leído de la flash con un largo posible.
+ */
+bool pin_hash_check_format(const pin_hash_t *stored)
+{
+    return stored->length >= PIN_LENGTH_MIN && stored->length <= PIN_LENGTH_MAX;
+}
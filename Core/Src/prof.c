@@ -0,0 +1,117 @@
+#include "prof.h"
+
+#ifdef PROF_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+
+prof_stats_t prof_stats[PROF_PROBE_COUNT];
+
+static const char *const prof_names[PROF_PROBE_COUNT] = {
+    [PROF_ROOM_UPDATE]    = "room_update",
+    [PROF_ROOM_DISPLAY]   = "room_display",
+    [PROF_SSD1306_UPDATE] = "ssd1306_update",
+    [PROF_TEMP_READ]      = "temp_read",
+    [PROF_PIN_VERIFY]     = "pin_verify",
+};
+
+/**
+ * @brief Habilita el contador de ciclos del DWT y limpia las estadísticas.
+ */
+void prof_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    prof_reset();
+}
+
+void prof_reset(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(prof_stats, 0, sizeof(prof_stats));
+    __set_PRIMASK(primask);
+}
+
+// Mayor duración que cae en el intervalo b del histograma
+static uint32_t prof_bucket_upper(uint32_t b)
+{
+    if (b < (1u << PROF_SUB_BITS)) {
+        return b;
+    }
+    uint32_t msb = (b >> PROF_SUB_BITS) + PROF_SUB_BITS - 1u;
+    uint32_t sub = b & ((1u << PROF_SUB_BITS) - 1u);
+    uint32_t width = 1u << (msb - PROF_SUB_BITS);
+    return (1u << msb) + sub * width + (width - 1u);
+}
+
+// Percentil sobre un conjunto de estadísticas (cota superior del intervalo)
+static uint32_t prof_stats_percentile(const prof_stats_t *s, uint32_t percent)
+{
+    if (s->count == 0) {
+        return 0;
+    }
+
+    // Rango (1..count) de la muestra buscada
+    uint32_t rank = (uint32_t)(((uint64_t)s->count * percent + 99u) / 100u);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < PROF_BUCKETS; b++) {
+        seen += s->buckets[b];
+        if (seen >= rank) {
+            uint32_t upper = prof_bucket_upper(b);
+            return (upper < s->max) ? upper : s->max;
+        }
+    }
+    return s->max;
+}
+
+/**
+ * @brief Percentil aproximado de una sonda.
+ *
+ * @param percent 0..100
+ * @return Ciclos, acotado por el máximo observado.
+ */
+uint32_t prof_percentile(prof_probe_t probe, uint32_t percent)
+{
+    return prof_stats_percentile(&prof_stats[probe], percent);
+}
+
+const char *prof_name(prof_probe_t probe)
+{
+    return (probe < PROF_PROBE_COUNT) ? prof_names[probe] : "?";
+}
+
+/**
+ * @brief Imprime una línea por sonda (en ciclos) y reinicia las estadísticas.
+ *
+ * Se llama desde el parser (ISR de UART), que no puede ser interrumpido por
+ * el superloop donde están las sondas, así que no hace falta copiar los datos.
+ */
+void prof_dump(void)
+{
+    for (uint32_t p = 0; p < PROF_PROBE_COUNT; p++) {
+        const prof_stats_t *s = &prof_stats[p];
+        if (s->count == 0) {
+            printf("PROF: %s n=0\r\n", prof_names[p]);
+            continue;
+        }
+
+        printf("PROF: %s n=%lu min=%lu avg=%lu p50=%lu p90=%lu p99=%lu max=%lu\r\n",
+               prof_names[p], (unsigned long)s->count, (unsigned long)s->min,
+               (unsigned long)(s->sum / s->count),
+               (unsigned long)prof_stats_percentile(s, 50),
+               (unsigned long)prof_stats_percentile(s, 90),
+               (unsigned long)prof_stats_percentile(s, 99),
+               (unsigned long)s->max);
+    }
+
+    prof_reset();
+}
+
+#endif // PROF_ENABLED
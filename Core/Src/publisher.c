@@ -0,0 +1,266 @@
+#include "publisher.h"
+#include "config_store.h"
+#include "sn_link.h"
+#include "rtc_clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PUBLISHER_SN_HEADER     7U      // largo, tipo, flags, tópico, msg id
+#define PUBLISHER_SN_DATA_HDR   9U      // seq, período, tiempo, n
+#define PUBLISHER_SAMPLE_SIZE   4U
+#define PUBLISHER_TXT_MAX       (64U + 18U * PUBLISHER_BATCH_MAX)
+
+extern UART_HandleTypeDef huart3;
+
+_Static_assert(1U + PUBLISHER_SN_HEADER + PUBLISHER_SN_DATA_HDR +
+               PUBLISHER_SAMPLE_SIZE * PUBLISHER_BATCH_MAX <= 255U, "largo de MQTT-SN en un byte");
+
+typedef struct {
+    int16_t temp_deci;
+    uint8_t duty;           // duty / 4, duty en por mil
+    uint8_t flags;          // Estado y puerta
+} publisher_sample_t;
+
+// Valor de CONFIG_KEY_PUBLISH
+typedef struct {
+    uint16_t interval_s;
+    uint8_t samples;
+    uint8_t format;
+} publisher_config_t;
+
+static struct {
+    publisher_config_t cfg;
+    uint32_t sample_ms;
+    uint32_t last_sample;
+    bool started;
+
+    publisher_sample_t batch[PUBLISHER_BATCH_MAX];
+    uint8_t count;
+    uint32_t batch_time;    // rtc_clock_timestamp() de la última muestra
+    uint16_t seq;
+
+    // Cambios pedidos desde la ISR de UART, los aplica publisher_poll()
+    publisher_config_t requested;
+    volatile bool config_requested;
+
+    uint32_t sent;
+    uint32_t bytes;
+    uint32_t busy;
+    uint32_t dropped;
+} pub;
+
+// El buffer no se toca mientras la UART lo transmite
+static uint8_t tx_frame[PUBLISHER_TXT_MAX];
+
+// Helpers privados
+
+static bool publisher_config_valid(const publisher_config_t *cfg)
+{
+    return cfg->interval_s <= PUBLISHER_INTERVAL_MAX_S &&
+           cfg->samples >= 1U && cfg->samples <= PUBLISHER_BATCH_MAX &&
+           cfg->format <= PUBLISHER_FORMAT_TXT &&
+           (cfg->interval_s == 0U || cfg->interval_s * 1000U / cfg->samples >= 100U);
+}
+
+static void publisher_apply(const publisher_config_t *cfg)
+{
+    pub.cfg = *cfg;
+    pub.sample_ms = (cfg->interval_s * 1000U) / cfg->samples;
+    pub.count = 0;
+    pub.started = false;
+}
+
+static int32_t publisher_round(float x)
+{
+    return (int32_t)(x >= 0.0f ? x + 0.5f : x - 0.5f);
+}
+
+static uint16_t publisher_build_sn(void)
+{
+    uint16_t period_ds = (uint16_t)(pub.sample_ms / 100U);
+    uint8_t *p = &tx_frame[1];
+
+    *p++ = (uint8_t)(PUBLISHER_SN_HEADER + PUBLISHER_SN_DATA_HDR + PUBLISHER_SAMPLE_SIZE * pub.count);
+    *p++ = SN_MSG_PUBLISH;
+    *p++ = SN_FLAG_QOS_M1 | SN_FLAG_TOPIC_PREDEF;
+    *p++ = (uint8_t)(PUBLISHER_TOPIC_ID >> 8);
+    *p++ = (uint8_t)PUBLISHER_TOPIC_ID;
+    *p++ = 0;   // Msg id: 0 con QoS -1
+    *p++ = 0;
+    *p++ = (uint8_t)(pub.seq >> 8);
+    *p++ = (uint8_t)pub.seq;
+    *p++ = (uint8_t)(period_ds >> 8);
+    *p++ = (uint8_t)period_ds;
+    *p++ = (uint8_t)(pub.batch_time >> 24);
+    *p++ = (uint8_t)(pub.batch_time >> 16);
+    *p++ = (uint8_t)(pub.batch_time >> 8);
+    *p++ = (uint8_t)pub.batch_time;
+    *p++ = pub.count;
+    for (uint8_t i = 0; i < pub.count; i++) {
+        *p++ = (uint8_t)((uint16_t)pub.batch[i].temp_deci >> 8);
+        *p++ = (uint8_t)pub.batch[i].temp_deci;
+        *p++ = pub.batch[i].duty;
+        *p++ = pub.batch[i].flags;
+    }
+    return sn_link_seal(tx_frame);
+}
+
+static uint16_t publisher_build_txt(void)
+{
+    char *out = (char *)tx_frame;
+    size_t size = sizeof(tx_frame);
+    int n = snprintf(out, size, "PUB %s seq=%u dt=%lu t=%lu ", PUBLISHER_TOPIC_NAME,
+                     (unsigned)pub.seq, (unsigned long)pub.sample_ms, (unsigned long)pub.batch_time);
+
+    for (uint8_t i = 0; i < pub.count && n > 0 && (size_t)n < size; i++) {
+        int32_t t = pub.batch[i].temp_deci;
+        int32_t t_abs = (t < 0) ? -t : t;
+        n += snprintf(&out[n], size - (size_t)n, "%s%s%ld.%ld,%u,%u,%u",
+                      (i > 0) ? ";" : "", (t < 0) ? "-" : "",
+                      (long)(t_abs / 10), (long)(t_abs % 10),
+                      (unsigned)pub.batch[i].duty * 4U,
+                      (unsigned)(pub.batch[i].flags >> 3) & 1U,
+                      (unsigned)pub.batch[i].flags & 0x7U);
+    }
+    if (n > 0 && (size_t)n < size) {
+        n += snprintf(&out[n], size - (size_t)n, "\r\n");
+    }
+    return (n > 0 && (size_t)n < size) ? (uint16_t)n : 0;
+}
+
+static void publisher_add_sample(room_control_t *room)
+{
+    if (pub.count == PUBLISHER_BATCH_MAX) {
+        // La UART no liberó el lote a tiempo: se pierde la muestra más vieja
+        memmove(&pub.batch[0], &pub.batch[1], sizeof(pub.batch) - sizeof(pub.batch[0]));
+        pub.count--;
+        pub.dropped++;
+    }
+
+    int32_t temp = publisher_round(room_control_get_temperature(room) * 10.0f);
+    temp = (temp > INT16_MAX) ? INT16_MAX : (temp < INT16_MIN) ? INT16_MIN : temp;
+    uint16_t duty = room_control_get_fan_duty(room) / 4U;
+
+    pub.batch_time = rtc_clock_timestamp();
+    publisher_sample_t *s = &pub.batch[pub.count++];
+    s->temp_deci = (int16_t)temp;
+    s->duty = (duty > 250U) ? 250U : (uint8_t)duty;
+    s->flags = (uint8_t)(((uint8_t)room_control_get_state(room) & 0x7U) |
+                         (room_control_is_door_locked(room) ? 0x8U : 0U));
+}
+
+static void publisher_send(void)
+{
+    if (huart3.gState != HAL_UART_STATE_READY) {
+        pub.busy++;   // Se reintenta en la próxima vuelta
+        return;
+    }
+
+    uint16_t len = (pub.cfg.format == PUBLISHER_FORMAT_TXT) ? publisher_build_txt() : publisher_build_sn();
+    if (len == 0 || HAL_UART_Transmit_IT(&huart3, tx_frame, len) != HAL_OK) {
+        pub.busy++;
+        return;
+    }
+    pub.sent++;
+    pub.bytes += len;
+    pub.seq++;
+    pub.count = 0;
+}
+
+// API pública
+
+/**
+ * @brief Carga la configuración guardada (después de config_store_init()).
+ */
+void publisher_init(void)
+{
+    memset(&pub, 0, sizeof(pub));
+
+    publisher_config_t cfg;
+    if (!config_store_get(CONFIG_KEY_PUBLISH, &cfg, sizeof(cfg)) || !publisher_config_valid(&cfg)) {
+        cfg.interval_s = PUBLISHER_DEFAULT_INTERVAL;
+        cfg.samples = PUBLISHER_DEFAULT_SAMPLES;
+        cfg.format = PUBLISHER_FORMAT_SN;
+    }
+    publisher_apply(&cfg);
+}
+
+/**
+ * @brief Cambia intervalo y muestras por mensaje; se aplica y se guarda en
+ * la próxima publisher_poll() (se puede llamar desde la ISR de UART).
+ *
+ * @param interval_s Segundos entre mensajes, 0 deshabilita.
+ * @param samples Muestras por mensaje (1..PUBLISHER_BATCH_MAX).
+ * @return false si los valores están fuera de rango.
+ */
+bool publisher_configure(uint32_t interval_s, uint32_t samples)
+{
+    publisher_config_t cfg = pub.config_requested ? pub.requested : pub.cfg;
+    cfg.interval_s = (uint16_t)((interval_s > UINT16_MAX) ? UINT16_MAX : interval_s);
+    cfg.samples = (uint8_t)((samples > UINT8_MAX) ? UINT8_MAX : samples);
+    if (!publisher_config_valid(&cfg)) {
+        return false;
+    }
+    pub.requested = cfg;
+    pub.config_requested = true;
+    return true;
+}
+
+/**
+ * @brief Cambia el formato de los mensajes (igual que publisher_configure()).
+ */
+void publisher_set_format(publisher_format_t format)
+{
+    publisher_config_t cfg = pub.config_requested ? pub.requested : pub.cfg;
+    cfg.format = (uint8_t)format;
+    pub.requested = cfg;
+    pub.config_requested = true;
+}
+
+/**
+ * @brief Toma las muestras que tocan y publica el lote completo sin
+ * bloquear. Llamar en cada vuelta del superloop.
+ */
+void publisher_poll(room_control_t *room)
+{
+    if (pub.config_requested) {
+        pub.config_requested = false;
+        publisher_config_t cfg = pub.requested;
+        if (memcmp(&cfg, &pub.cfg, sizeof(cfg)) != 0) {
+            publisher_apply(&cfg);
+            config_store_set(CONFIG_KEY_PUBLISH, &cfg, sizeof(cfg));
+        }
+    }
+    if (pub.cfg.interval_s == 0U) {
+        return;
+    }
+
+    uint32_t now = HAL_GetTick();
+    if (!pub.started) {
+        pub.started = true;
+        pub.last_sample = now;
+        publisher_add_sample(room);
+    } else if (now - pub.last_sample >= pub.sample_ms) {
+        // Período fijo; tras una vuelta muy larga no se acumulan muestras atrasadas
+        pub.last_sample += pub.sample_ms;
+        if (now - pub.last_sample >= pub.sample_ms) {
+            pub.last_sample = now;
+        }
+        publisher_add_sample(room);
+    }
+
+    if (pub.count >= pub.cfg.samples) {
+        publisher_send();
+    }
+}
+
+void publisher_get_stats(publisher_stats_t *stats)
+{
+    stats->interval_s = pub.cfg.interval_s;
+    stats->samples = pub.cfg.samples;
+    stats->format = (publisher_format_t)pub.cfg.format;
+    stats->sent = pub.sent;
+    stats->bytes = pub.bytes;
+    stats->busy = pub.busy;
+    stats->dropped = pub.dropped;
+}
@@ -1,35 +1,185 @@
 #include "room_control.h"
 #include "ssd1306.h"
 #include "ssd1306_fonts.h"
+#include "fan_ramp.h"
+#include "prof.h"
+#include "config_store.h"
+#include "telemetry.h"
+#include "tlog.h"
+#include "alert.h"
+#include "rtc_clock.h"
 #include <string.h>
 #include <stdio.h>
 
 // Default password
 static const char DEFAULT_PASSWORD[] = "2222";
 
-// Temperature thresholds for automatic fan control
-static const float TEMP_THRESHOLD_LOW = 25.0f;
-static const float TEMP_THRESHOLD_MED = 28.0f;  
-static const float TEMP_THRESHOLD_HIGH = 31.0f;
+// Umbrales por defecto del control por niveles (centésimas de °C)
+static const int16_t DEFAULT_THRESHOLDS[ROOM_THRESHOLD_COUNT] = { 2500, 2800, 3100 };
+
+// Setpoint inicial del modo PID
+static const float DEFAULT_SETPOINT = 25.0f;
 
 // Timeouts in milliseconds
 static const uint32_t INPUT_TIMEOUT_MS = 10000;  // 10 seconds
 static const uint32_t ACCESS_DENIED_TIMEOUT_MS = 3000;  // 3 seconds
 
-// Control suave del ventilador con DMA (bonus) 
-#define FAN_FADE_STEPS 20
-
-static uint16_t fan_dma_buffer[FAN_FADE_STEPS];
-static uint32_t fan_current_pwm_value = 0;
-static uint8_t  fan_dma_in_progress = 0;
-
 // Private function prototypes
 static void room_control_change_state(room_control_t *room, room_state_t new_state);
+static void room_control_dispatch(room_control_t *room, const room_event_t *event);
 static void room_control_update_display(room_control_t *room); 
 static void room_control_update_door(room_control_t *room);
 static void room_control_update_fan(room_control_t *room);
-static fan_level_t room_control_calculate_fan_level(float temperature);
+static fan_level_t room_control_calculate_fan_level(const room_control_t *room, float temperature);
+static void room_control_load_config(room_control_t *room);
+static void room_control_stored_profile(room_profile_t *profile);
+static void room_control_use_profile(room_control_t *room, const room_profile_t *profile);
 static void room_control_clear_input(room_control_t *room);
+static void room_control_arm_timeout(room_control_t *room, uint32_t start, uint32_t timeout_ms);
+static bool room_control_next_event(room_control_t *room, room_event_t *event);
+static float room_control_filtered_temperature(room_control_t *room);
+static bool room_control_run_pid(room_control_t *room);
+static uint16_t room_control_fan_duty(room_control_t *room);
+static void room_control_force_level_now(room_control_t *room, fan_level_t level);
+static void room_control_record_attempt(room_control_t *room, bool success);
+static void room_control_start_lockout(room_control_t *room, uint32_t now);
+static bool room_control_update_lockout(room_control_t *room, uint32_t now);
+static void room_control_draw_clock(void);
+
+/*
+ * Máquina de estados por tabla
+ *
+ * Cada evento de la cola se traduce a una entrada (room_input_t) y la
+ * transición se obtiene indexando room_transitions[estado][entrada].
+ * Una acción puede devolver una entrada interna (p. ej. resultado de la
+ * verificación de clave) que se despacha antes de tomar el siguiente evento.
+ */
+typedef enum {
+    ROOM_IN_NONE = 0,       // Tecla sin función
+    ROOM_IN_DIGIT,          // '0'..'9'
+    ROOM_IN_CLEAR,          // 'C'
+    ROOM_IN_CANCEL,         // '*'
+    ROOM_IN_CONFIRM,        // '#'
+    ROOM_IN_KEY_A,
+    ROOM_IN_KEY_B,
+    ROOM_IN_KEY_D,
+    ROOM_IN_TEMPERATURE,
+    ROOM_IN_TIMEOUT,
+    ROOM_IN_COMMAND,
+    ROOM_IN_PASSWORD_OK,    // Internas: resultado de comparar la clave
+    ROOM_IN_PASSWORD_BAD,
+    ROOM_IN_COUNT
+} room_input_t;
+
+typedef bool (*room_guard_fn)(const room_control_t *room, const room_event_t *event);
+typedef room_input_t (*room_action_fn)(room_control_t *room, const room_event_t *event);
+typedef void (*room_state_fn)(room_control_t *room);
+
+typedef struct {
+    room_guard_fn guard;    // NULL: siempre se cumple
+    room_action_fn action;  // NULL: sin acción
+    uint8_t next;           // STAY o GOTO(estado)
+} room_transition_t;
+
+#define STAY        0
+#define GOTO(state) ((uint8_t)((state) + 1))
+
+// Guardas
+static bool guard_input_complete(const room_control_t *room, const room_event_t *event);
+static bool guard_fan_key(const room_control_t *room, const room_event_t *event);
+static bool guard_timeout_current(const room_control_t *room, const room_event_t *event);
+static bool guard_keypad_free(const room_control_t *room, const room_event_t *event);
+
+// Acciones
+static room_input_t action_start_input(room_control_t *room, const room_event_t *event);
+static room_input_t action_append_digit(room_control_t *room, const room_event_t *event);
+static room_input_t action_erase_digit(room_control_t *room, const room_event_t *event);
+static room_input_t action_touch_input(room_control_t *room, const room_event_t *event);
+static room_input_t action_verify_password(room_control_t *room, const room_event_t *event);
+static room_input_t action_manual_fan(room_control_t *room, const room_event_t *event);
+static room_input_t action_auto_fan(room_control_t *room, const room_event_t *event);
+static room_input_t action_temperature(room_control_t *room, const room_event_t *event);
+static room_input_t action_record_temperature(room_control_t *room, const room_event_t *event);
+static room_input_t action_command(room_control_t *room, const room_event_t *event);
+
+// Acciones de entrada / salida de estado
+static void enter_locked(room_control_t *room);
+static void enter_input_password(room_control_t *room);
+static void enter_unlocked(room_control_t *room);
+static void enter_access_denied(room_control_t *room);
+static void enter_emergency(room_control_t *room);
+static void exit_input_password(room_control_t *room);
+static void exit_emergency(room_control_t *room);
+
+// Eventos que se tratan igual en todos los estados
+#define COMMON_TRANSITIONS \
+    [ROOM_IN_TEMPERATURE] = { NULL, action_temperature, STAY }, \
+    [ROOM_IN_COMMAND]     = { NULL, action_command,     STAY }
+
+static const room_transition_t room_transitions[ROOM_STATE_COUNT][ROOM_IN_COUNT] = {
+    [ROOM_STATE_LOCKED] = {
+        [ROOM_IN_DIGIT]        = { guard_keypad_free, action_start_input, GOTO(ROOM_STATE_INPUT_PASSWORD) },
+        [ROOM_IN_CLEAR]        = { guard_keypad_free, action_start_input, GOTO(ROOM_STATE_INPUT_PASSWORD) },
+        COMMON_TRANSITIONS,
+    },
+    [ROOM_STATE_INPUT_PASSWORD] = {
+        [ROOM_IN_DIGIT]        = { NULL, action_append_digit, STAY },
+        [ROOM_IN_CLEAR]        = { NULL, action_erase_digit,  STAY },
+        [ROOM_IN_CANCEL]       = { NULL, NULL,                GOTO(ROOM_STATE_LOCKED) },
+        [ROOM_IN_CONFIRM]      = { guard_input_complete, action_verify_password, STAY },
+        [ROOM_IN_KEY_A]        = { NULL, action_touch_input,  STAY },
+        [ROOM_IN_KEY_B]        = { NULL, action_touch_input,  STAY },
+        [ROOM_IN_KEY_D]        = { NULL, action_touch_input,  STAY },
+        [ROOM_IN_TIMEOUT]      = { guard_timeout_current, NULL, GOTO(ROOM_STATE_LOCKED) },
+        [ROOM_IN_PASSWORD_OK]  = { NULL, NULL,                GOTO(ROOM_STATE_UNLOCKED) },
+        [ROOM_IN_PASSWORD_BAD] = { NULL, NULL,                GOTO(ROOM_STATE_ACCESS_DENIED) },
+        COMMON_TRANSITIONS,
+    },
+    [ROOM_STATE_UNLOCKED] = {
+        [ROOM_IN_DIGIT]        = { guard_fan_key, action_manual_fan, STAY },
+        [ROOM_IN_KEY_A]        = { NULL, action_auto_fan,     STAY },
+        [ROOM_IN_KEY_B]        = { NULL, NULL,                GOTO(ROOM_STATE_LOCKED) },
+        [ROOM_IN_KEY_D]        = { NULL, NULL,                GOTO(ROOM_STATE_EMERGENCY) },
+        COMMON_TRANSITIONS,
+    },
+    [ROOM_STATE_ACCESS_DENIED] = {
+        [ROOM_IN_TIMEOUT]      = { NULL, NULL,                GOTO(ROOM_STATE_LOCKED) },
+        COMMON_TRANSITIONS,
+    },
+    [ROOM_STATE_EMERGENCY] = {
+        [ROOM_IN_CONFIRM]      = { NULL, NULL,                GOTO(ROOM_STATE_LOCKED) },
+        // En emergencia el ventilador queda al máximo: solo se registra la lectura
+        [ROOM_IN_TEMPERATURE]  = { NULL, action_record_temperature, STAY },
+        [ROOM_IN_COMMAND]      = { NULL, action_command,      STAY },
+    },
+};
+
+static const room_state_fn room_state_entry[ROOM_STATE_COUNT] = {
+    [ROOM_STATE_LOCKED]         = enter_locked,
+    [ROOM_STATE_UNLOCKED]       = enter_unlocked,
+    [ROOM_STATE_INPUT_PASSWORD] = enter_input_password,
+    [ROOM_STATE_ACCESS_DENIED]  = enter_access_denied,
+    [ROOM_STATE_EMERGENCY]      = enter_emergency,
+};
+
+static const room_state_fn room_state_exit[ROOM_STATE_COUNT] = {
+    [ROOM_STATE_INPUT_PASSWORD] = exit_input_password,
+    [ROOM_STATE_EMERGENCY]      = exit_emergency,
+};
+
+// Traducción de tecla a entrada de la máquina de estados
+static const uint8_t room_key_inputs[128] = {
+    ['0'] = ROOM_IN_DIGIT, ['1'] = ROOM_IN_DIGIT, ['2'] = ROOM_IN_DIGIT,
+    ['3'] = ROOM_IN_DIGIT, ['4'] = ROOM_IN_DIGIT, ['5'] = ROOM_IN_DIGIT,
+    ['6'] = ROOM_IN_DIGIT, ['7'] = ROOM_IN_DIGIT, ['8'] = ROOM_IN_DIGIT,
+    ['9'] = ROOM_IN_DIGIT,
+    ['C'] = ROOM_IN_CLEAR,  ['c'] = ROOM_IN_CLEAR,
+    ['*'] = ROOM_IN_CANCEL,
+    ['#'] = ROOM_IN_CONFIRM,
+    ['A'] = ROOM_IN_KEY_A,  ['a'] = ROOM_IN_KEY_A,
+    ['B'] = ROOM_IN_KEY_B,  ['b'] = ROOM_IN_KEY_B,
+    ['D'] = ROOM_IN_KEY_D,  ['d'] = ROOM_IN_KEY_D,
+};
 
 // Periféricos externos usados (*)
 extern TIM_HandleTypeDef htim3;   // PWM TIM3 CH1 (PA6)
@@ -38,10 +188,19 @@ extern UART_HandleTypeDef huart3; // ESP-01 (USART3)
 void room_control_init(room_control_t *room) {
     // Initialize room control structure
     room->current_state = ROOM_STATE_LOCKED;
-    strcpy(room->password, DEFAULT_PASSWORD);
+    pin_hash_create(&room->password, DEFAULT_PASSWORD, (uint8_t)strlen(DEFAULT_PASSWORD));
     room_control_clear_input(room);
+    room->user = (user_t){ .id = USER_ID_MASTER, .role = USER_ROLE_NONE };
     room->last_input_time = 0;
     room->state_enter_time = HAL_GetTick();
+    room->timeout_armed = false;
+    room->timeout_deadline = 0;
+
+    // Sin bloqueo hasta leer el contador guardado
+    room->failed_attempts = 0;
+    room->lockout_active = false;
+    room->lockout_until = 0;
+    room->lockout_shown_s = 0;
     
     // Initialize door control
     room->door_locked = true;
@@ -50,9 +209,31 @@ void room_control_init(room_control_t *room) {
     room->current_temperature = 22.0f;  // Default room temperature
     room->current_fan_level = FAN_LEVEL_OFF;
     room->manual_fan_override = false;
+    room->fan_duty = 0;
+
+    // Filtro y lazo PID (arranca en modo por niveles)
+    room->temp_count = 0;
+    room->temp_index = 0;
+    room->fan_mode = FAN_MODE_LEVELS;
+    room->setpoint = (int32_t)(DEFAULT_SETPOINT * 100.0f);
+    memcpy(room->thresholds, DEFAULT_THRESHOLDS, sizeof(room->thresholds));
+    fan_pid_init(&room->pid);
+    room->next_control_time = HAL_GetTick();
+    room->profile_active = false;
+    room->fan_min = 0;
+    room->fan_max = FAN_DUTY_MAX;
     
     // Display
     room->display_update_needed = true;
+
+    // Cola de eventos vacía
+    room->event_head = 0;
+    room->event_tail = 0;
+    room->events_dropped = 0;
+
+    // Lo guardado en la flash reemplaza a los valores por defecto
+    room_control_load_config(room);
+
     // TODO: TAREA - Initialize hardware (door lock, fan PWM, etc.)  (*)
     
     // Ejemplo: HAL_GPIO_WritePin(DOOR_STATUS_GPIO_Port, DOOR_STATUS_Pin, GPIO_PIN_RESET);
@@ -61,40 +242,51 @@ void room_control_init(room_control_t *room) {
     // Inicializar PWM en 0 (*)
     __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, 0);
     HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+    fan_ramp_init(&htim3);
 
     room_control_change_state(room, ROOM_STATE_LOCKED);
 }
 
 void room_control_update(room_control_t *room) {
 
+    PROF_SCOPE(PROF_ROOM_UPDATE);
+
     uint32_t current_time = HAL_GetTick();
 
-    switch (room->current_state) {
+    // El plazo del estado se convierte en un evento más de la cola
+    if (room->timeout_armed && (int32_t)(current_time - room->timeout_deadline) > 0) {
+        room->timeout_armed = false;
 
-        case ROOM_STATE_LOCKED:
-            room->door_locked = true;
-            break;
+        room_event_t timeout = {
+            .type = ROOM_EVENT_TIMEOUT,
+            .timestamp = current_time
+        };
+        room_control_post_event(room, &timeout);
+    }
 
-        case ROOM_STATE_INPUT_PASSWORD:
-            if (current_time - room->last_input_time > INPUT_TIMEOUT_MS) {
-                room_control_change_state(room, ROOM_STATE_LOCKED);
-            }
-            break;
+    // Fin del bloqueo o un segundo menos en la cuenta regresiva
+    bool processed = room_control_update_lockout(room, current_time);
 
-        case ROOM_STATE_UNLOCKED:
-            room->door_locked = false;
-            break;
+    // Sin eventos no hay trabajo que hacer
+    room_event_t event;
 
-        case ROOM_STATE_ACCESS_DENIED:
-            if (current_time - room->state_enter_time > ACCESS_DENIED_TIMEOUT_MS) {
-                room_control_change_state(room, ROOM_STATE_LOCKED);
-            }
-            break;
+    while (room_control_next_event(room, &event)) {
+        room_control_dispatch(room, &event);
+        processed = true;
+    }
 
-        case ROOM_STATE_EMERGENCY:
-            room->door_locked = false;
-            room->current_fan_level = FAN_LEVEL_HIGH;
-            break;
+    // Lazo PID a periodo fijo (sin deriva: el plazo avanza en pasos exactos)
+    if (room->fan_mode == FAN_MODE_PID &&
+        (int32_t)(current_time - room->next_control_time) >= 0) {
+        room->next_control_time += FAN_PID_PERIOD_MS;
+        if (room_control_run_pid(room)) {
+            processed = true;
+        }
+    }
+
+    // Nada que hacer, salvo el primer dibujo tras room_control_init()
+    if (!processed && !room->display_update_needed) {
+        return;
     }
 
     // Actualizar puerta física
@@ -110,155 +302,125 @@ void room_control_update(room_control_t *room) {
     }
 }
 
+/**
+ * @brief Encola un evento para la máquina de estados.
+ *
+ * Puede llamarse desde el superloop o desde una ISR: la sección crítica
+ * es de unas pocas instrucciones. Muestras de temperatura consecutivas se
+ * fusionan para que un sensor rápido no llene la cola.
+ *
+ * @return false si la cola estaba llena y el evento se descartó.
+ */
+bool room_control_post_event(room_control_t *room, const room_event_t *event) {
+    bool queued = true;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint8_t count = (uint8_t)(room->event_head - room->event_tail);
+
+    if (event->type == ROOM_EVENT_TEMPERATURE && count > 0 &&
+        room->event_queue[(uint8_t)(room->event_head - 1) % ROOM_EVENT_QUEUE_LEN].type == ROOM_EVENT_TEMPERATURE) {
+        room->event_queue[(uint8_t)(room->event_head - 1) % ROOM_EVENT_QUEUE_LEN] = *event;
+    } else if (count < ROOM_EVENT_QUEUE_LEN) {
+        room->event_queue[room->event_head % ROOM_EVENT_QUEUE_LEN] = *event;
+        room->event_head++;
+    } else {
+        room->events_dropped++;
+        telemetry_event(TLM_EVT_QUEUE_FULL);
+        queued = false;
+    }
 
-void room_control_process_key(room_control_t *room, char key) {
-    room->last_input_time = HAL_GetTick();
-    
-    switch (room->current_state) {
-        case ROOM_STATE_LOCKED:
-            // Start password input
-            if ((key >= '0' && key <= '9') || key == 'C' || key == 'c') {  // aceptar solo números y borrar
-                room_control_clear_input(room);
-                room->input_buffer[0] = key;
-                room->input_index = 1;
-                room_control_change_state(room, ROOM_STATE_INPUT_PASSWORD);
-            }
-            break;
-            
-        case ROOM_STATE_INPUT_PASSWORD:
-            // TODO: TAREA - Implementar lógica de entrada de teclas (*)
-
-            // Tecla '*' = cancelar ingreso y volver a sistema bloqueado
-            if (key == '*') {
-                room_control_change_state(room, ROOM_STATE_LOCKED);
-                break;
-            }
-
-            // Borrar ultimo digito ingresado 
-            if (key == 'C' || key == 'c') { // borrar último dígito
-                if (room->input_index > 0) {
-                    room->input_index--;
-                    room->input_buffer[room->input_index] = '\0';
-                }
-
-                // Actualizar display   
-                room->display_update_needed = true;
-                break;
-            }
-
-            // Solo se aceptan números
-            if (key >= '0' && key <= '9') {
-                
-                // - Agregar tecla al buffer de entrada
-                if (room->input_index < PASSWORD_LENGTH) {
-                    room->input_buffer[room->input_index++] = key;
-                }
-
-                // - Verificar si se completaron 4 dígitos
-                if (room->input_index == PASSWORD_LENGTH) {
-                    
-                    // - Comparar con contraseña guardada
-                    if (strncmp(room->input_buffer, room->password, PASSWORD_LENGTH) == 0) {
-                        // - Cambiar a UNLOCKED o ACCESS_DENIED según resultado
-                        room_control_change_state(room, ROOM_STATE_UNLOCKED);
-                    } else {
-                        room_control_change_state(room, ROOM_STATE_ACCESS_DENIED);
-                    }
-                }
-            }
-            
-            // Tecla '#' = confirmar contraseña si ya hay 4 dígitos
-            if (key == '#') {
-                if (room->input_index == PASSWORD_LENGTH) {
-                    if (strncmp(room->input_buffer, room->password, PASSWORD_LENGTH) == 0) {
-                        room_control_change_state(room, ROOM_STATE_UNLOCKED);
-                    } else {
-                        room_control_change_state(room, ROOM_STATE_ACCESS_DENIED);
-                    }
-                }
-                room->display_update_needed = true;
-                break;
-            }
-
-            // Actualizar display en cada tecla
-            room->display_update_needed = true;
-
-            break;
-            
-        case ROOM_STATE_UNLOCKED:
-            // TODO: TAREA - Manejar comandos en estado desbloqueado (opcional)
-
-            // Salir de modo manual y volver a automático
-            if (key == 'A' || key == 'a') {
-                room->manual_fan_override = false;
-                room->current_fan_level = room_control_calculate_fan_level(room->current_temperature);
-            }
+    __set_PRIMASK(primask);
+    return queued;
+}
 
-            // Tecla 'B' para volver a bloquear
-            else if (key == 'B' || key == 'b') {
-                room_control_change_state(room, ROOM_STATE_LOCKED);
-            }
+void room_control_set_setpoint(room_control_t *room, float setpoint) {
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = ROOM_CMD_SET_SETPOINT, .setpoint = (int32_t)(setpoint * 100.0f) }
+    };
+    room_control_post_event(room, &event);
+}
 
-            // Control manual del ventilador
-            else if (key == '0') { // Apagar ventilador
-                room_control_force_fan_level(room, FAN_LEVEL_OFF);
-            } else if (key == '1') { // Ventilador bajo
-                room_control_force_fan_level(room, FAN_LEVEL_LOW);
-            } else if (key == '2') { // Ventilador medio
-                room_control_force_fan_level(room, FAN_LEVEL_MED);
-            } else if (key == '3') { // Ventilador alto
-                room_control_force_fan_level(room, FAN_LEVEL_HIGH);
-            }
+void room_control_set_fan_mode(room_control_t *room, fan_mode_t mode) {
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = ROOM_CMD_SET_FAN_MODE, .fan_mode = mode }
+    };
+    room_control_post_event(room, &event);
+}
 
-            // Entrar en modo EMERGENCIA (extra)
-            else if (key == 'D' || key == 'd') {
-                room_control_change_state(room, ROOM_STATE_EMERGENCY);
-            }
+// Umbrales en °C; se rechazan si no son estrictamente ascendentes
+bool room_control_set_thresholds(room_control_t *room, float low, float med, float high) {
+    if (!(low < med && med < high) || low < -20.0f || high > 80.0f) {
+        return false;
+    }
 
-            room->display_update_needed = true;
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = ROOM_CMD_SET_THRESHOLDS,
+                     .thresholds = { (int16_t)(low * 100.0f),
+                                     (int16_t)(med * 100.0f),
+                                     (int16_t)(high * 100.0f) } }
+    };
+    return room_control_post_event(room, &event);
+}
 
-            break;
-            
-        case ROOM_STATE_EMERGENCY:
-            if (key == '#') {   // tecla para salir de emergencia y IMPLEMENTAR entrar en emergencia 
-                room_control_change_state(room, ROOM_STATE_LOCKED);
-            }
-            break;
+// Perfil de la programación horaria; NULL vuelve a la configuración guardada
+void room_control_apply_profile(room_control_t *room, const room_profile_t *profile) {
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = (profile != NULL) ? ROOM_CMD_APPLY_PROFILE : ROOM_CMD_CLEAR_PROFILE }
+    };
+    if (profile != NULL) {
+        event.command.profile = *profile;
     }
-            
-    room->display_update_needed = true;
-}   
+    room_control_post_event(room, &event);
+}
 
-void room_control_set_temperature(room_control_t *room, float temperature) {
-    room->current_temperature = temperature;
-    
-    // Update fan level automatically if not in manual override
-    if (!room->manual_fan_override) {
-        fan_level_t new_level = room_control_calculate_fan_level(temperature);
-        if (new_level != room->current_fan_level) {
-            room->current_fan_level = new_level;
-            room->display_update_needed = true;
+void room_control_process_key(room_control_t *room, char key) {
+    room_event_t event = {
+        .type = ROOM_EVENT_KEY,
+        .timestamp = HAL_GetTick(),
+        .key = key
+    };
+    room_control_post_event(room, &event);
+}
 
-            // Debug: cambio de nivel de ventilador en modo AUTO
-            printf("AUTO: temp=%.1f -> nivel=%d\r\n",
-                   temperature, new_level);
-        }
-    }
-}   
+void room_control_set_temperature(room_control_t *room, float temperature) {
+    room_event_t event = {
+        .type = ROOM_EVENT_TEMPERATURE,
+        .timestamp = HAL_GetTick(),
+        .temperature = temperature
+    };
+    room_control_post_event(room, &event);
+}
 
 void room_control_force_fan_level(room_control_t *room, fan_level_t level) {
-    room->manual_fan_override = true;
-    room->current_fan_level = level;
-    room->display_update_needed = true;
-
-    // Debug: forzado manual de ventilador
-    printf("MANUAL: nivel=%d\r\n", level);
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = ROOM_CMD_FORCE_FAN, .fan_level = level }
+    };
+    room_control_post_event(room, &event);
 }
 
 void room_control_change_password(room_control_t *room, const char *new_password) {
-    if (strlen(new_password) == PASSWORD_LENGTH) {
-        strcpy(room->password, new_password);
+    if (!pin_hash_valid_pin(new_password, (uint8_t)strnlen(new_password, PIN_LENGTH_MAX + 1))) {
+        return;
     }
+
+    room_event_t event = {
+        .type = ROOM_EVENT_COMMAND,
+        .timestamp = HAL_GetTick(),
+        .command = { .id = ROOM_CMD_SET_PASSWORD }
+    };
+    strcpy(event.command.password, new_password);
+    room_control_post_event(room, &event);
 }
 
 // Status getters
@@ -278,6 +440,65 @@ float room_control_get_temperature(room_control_t *room) {
     return room->current_temperature;
 }
 
+uint16_t room_control_get_fan_duty(room_control_t *room) {
+    return room->fan_duty;
+}
+
+fan_mode_t room_control_get_fan_mode(room_control_t *room) {
+    return room->fan_mode;
+}
+
+float room_control_get_setpoint(room_control_t *room) {
+    return (float)room->setpoint / 100.0f;
+}
+
+float room_control_get_threshold(room_control_t *room, uint8_t index) {
+    if (index >= ROOM_THRESHOLD_COUNT) {
+        return 0.0f;
+    }
+    return (float)room->thresholds[index] / 100.0f;
+}
+
+uint8_t room_control_get_failed_attempts(room_control_t *room) {
+    return room->failed_attempts;
+}
+
+user_t room_control_get_user(room_control_t *room) {
+    return room->user;
+}
+
+/**
+ * @brief Dueño de una clave: la maestra (id 0, admin) o una de la tabla de
+ * usuarios. Se consultan las dos siempre y ninguna corta antes de tiempo
+ * (user_table_lookup() recorre max_probe ranuras), para que el tiempo no
+ * diga si hubo coincidencia ni cuál. La usan el keypad y LOGIN (desde la ISR).
+ */
+bool room_control_identify(room_control_t *room, const char *pin, uint8_t length, user_t *user) {
+    user_t found;
+    bool master = pin_hash_verify(&room->password, pin, length);
+    bool listed = user_table_lookup(pin, length, &found);
+
+    if (master) {
+        *user = (user_t){ .id = USER_ID_MASTER, .role = USER_ROLE_ADMIN };
+    } else if (listed) {
+        *user = found;
+    }
+    return master || listed;
+}
+
+// Milisegundos que faltan para volver a aceptar el keypad (0 = sin bloqueo)
+uint32_t room_control_get_lockout_remaining(room_control_t *room) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t remaining = 0;
+    if (room->lockout_active) {
+        int32_t left = (int32_t)(room->lockout_until - HAL_GetTick());
+        remaining = (left > 0) ? (uint32_t)left : 0U;
+    }
+    __set_PRIMASK(primask);
+    return remaining;
+}
+
 // Para debug: convertir estado a string
 static const char* room_state_to_str(room_state_t state) {
     switch (state) {
@@ -290,44 +511,476 @@ static const char* room_state_to_str(room_state_t state) {
     }
 }
 
+// Despacho de un evento a través de la tabla de transiciones
+static void room_control_dispatch(room_control_t *room, const room_event_t *event) {
+    room_input_t input = ROOM_IN_NONE;
+
+    switch (event->type) {
+        case ROOM_EVENT_KEY:
+            input = (room_input_t)room_key_inputs[(uint8_t)event->key & 0x7F];
+            break;
+        case ROOM_EVENT_TEMPERATURE: input = ROOM_IN_TEMPERATURE; break;
+        case ROOM_EVENT_TIMEOUT:     input = ROOM_IN_TIMEOUT;     break;
+        case ROOM_EVENT_COMMAND:     input = ROOM_IN_COMMAND;     break;
+        default:                     break;
+    }
+
+    while (input != ROOM_IN_NONE) {
+        const room_transition_t *t = &room_transitions[room->current_state][input];
+
+        if (t->guard != NULL && !t->guard(room, event)) {
+            break;
+        }
+
+        room_input_t follow_up = ROOM_IN_NONE;
+        if (t->action != NULL) {
+            follow_up = t->action(room, event);
+        }
+        if (t->next != STAY) {
+            room_control_change_state(room, (room_state_t)(t->next - 1));
+        }
+
+        input = follow_up;
+    }
+}
+
+/**
+ * @brief Revisa una matriz de destinos: estados inalcanzables desde LOCKED,
+ * estados sin salida y destinos fuera de rango.
+ *
+ * next[s * inputs + in] es el destino de la transición (STAY o GOTO(estado))
+ * con states <= ROOM_STATE_COUNT. Separada de la tabla real para que los
+ * tests de host puedan pasarle tablas rotas.
+ *
+ * @return Número de problemas encontrados (0 = tabla consistente).
+ */
+int room_control_check_transitions(const uint8_t *next, size_t states, size_t inputs) {
+    bool reachable[ROOM_STATE_COUNT] = { [ROOM_STATE_LOCKED] = true };
+    bool changed = true;
+    int problems = 0;
+
+    if (states == 0 || states > ROOM_STATE_COUNT) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < states * inputs; i++) {
+        if (next[i] != STAY && next[i] > states) {
+            printf("FSM: destino %u fuera de rango en %s\r\n", (unsigned)next[i],
+                   room_state_to_str((room_state_t)(i / inputs)));
+            problems++;
+        }
+    }
+
+    while (changed) {
+        changed = false;
+        for (size_t s = 0; s < states; s++) {
+            if (!reachable[s]) {
+                continue;
+            }
+            for (size_t in = 0; in < inputs; in++) {
+                uint8_t to = next[s * inputs + in];
+                if (to != STAY && to <= states && !reachable[to - 1]) {
+                    reachable[to - 1] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (size_t s = 0; s < states; s++) {
+        bool has_exit = false;
+        for (size_t in = 0; in < inputs; in++) {
+            if (next[s * inputs + in] != STAY) {
+                has_exit = true;
+            }
+        }
+        if (!reachable[s]) {
+            printf("FSM: estado %s inalcanzable\r\n", room_state_to_str((room_state_t)s));
+            problems++;
+        }
+        if (!has_exit) {
+            printf("FSM: estado %s sin salida\r\n", room_state_to_str((room_state_t)s));
+            problems++;
+        }
+    }
+
+    return problems;
+}
+
+/**
+ * @brief Revisa room_transitions[][] con room_control_check_transitions().
+ * No depende del hardware: la corre el test de host test_room_transitions.
+ */
+int room_control_validate_transitions(void) {
+    uint8_t next[ROOM_STATE_COUNT][ROOM_IN_COUNT];
+
+    for (size_t s = 0; s < ROOM_STATE_COUNT; s++) {
+        for (size_t in = 0; in < ROOM_IN_COUNT; in++) {
+            next[s][in] = room_transitions[s][in].next;
+        }
+    }
+    return room_control_check_transitions(&next[0][0], ROOM_STATE_COUNT, ROOM_IN_COUNT);
+}
+
+// Guardas
+
+// '#' verifica desde PIN_LENGTH_MIN dígitos (un largo distinto del guardado falla)
+static bool guard_input_complete(const room_control_t *room, const room_event_t *event) {
+    (void)event;
+    return room->input_index >= PIN_LENGTH_MIN;
+}
+
+// En UNLOCKED solo '0'..'3' seleccionan nivel de ventilador, y solo un admin
+static bool guard_fan_key(const room_control_t *room, const room_event_t *event) {
+    return event->key <= '3' && room->user.role == USER_ROLE_ADMIN;
+}
+
+// Un plazo re-armado por una tecla posterior invalida el evento
+static bool guard_timeout_current(const room_control_t *room, const room_event_t *event) {
+    (void)event;
+    return !room->timeout_armed;
+}
+
+// Durante el bloqueo las teclas de LOCKED se ignoran: no se puede empezar otra clave
+static bool guard_keypad_free(const room_control_t *room, const room_event_t *event) {
+    (void)event;
+    return !room->lockout_active;
+}
+
+// Acciones
+
+static room_input_t action_start_input(room_control_t *room, const room_event_t *event) {
+    room->last_input_time = event->timestamp;
+    room_control_clear_input(room);
+    if (event->key >= '0' && event->key <= '9') {
+        room->input_buffer[0] = event->key;
+        room->input_index = 1;
+    }
+    return ROOM_IN_NONE;
+}
+
+// Cualquier tecla en INPUT_PASSWORD extiende el plazo y refresca la pantalla
+static room_input_t action_touch_input(room_control_t *room, const room_event_t *event) {
+    room->last_input_time = event->timestamp;
+    room_control_arm_timeout(room, room->last_input_time, INPUT_TIMEOUT_MS);
+    room->display_update_needed = true;
+    return ROOM_IN_NONE;
+}
+
+// Largo con el que se verifica sola la clave; 0 si hay usuarios en la tabla,
+// porque las claves tienen largos distintos y se confirman con '#'
+static uint8_t room_control_expected_length(const room_control_t *room) {
+    user_table_stats_t users;
+    user_table_get_stats(&users);
+    return (users.users == 0U) ? room->password.length : 0U;
+}
+
+static room_input_t action_append_digit(room_control_t *room, const room_event_t *event) {
+    action_touch_input(room, event);
+
+    if (room->input_index < PIN_LENGTH_MAX) {
+        room->input_buffer[room->input_index++] = event->key;
+    }
+
+    // Al completar el largo de la clave (o el máximo) se verifica automáticamente
+    if (room->input_index == room_control_expected_length(room) || room->input_index == PIN_LENGTH_MAX) {
+        return action_verify_password(room, event);
+    }
+    return ROOM_IN_NONE;
+}
+
+static room_input_t action_erase_digit(room_control_t *room, const room_event_t *event) {
+    action_touch_input(room, event);
+
+    if (room->input_index > 0) {
+        room->input_index--;
+        room->input_buffer[room->input_index] = '\0';
+    }
+    return ROOM_IN_NONE;
+}
+
+// Única comparación de la clave (hash, tiempo constante): el resultado se
+// despacha como entrada interna
+static room_input_t action_verify_password(room_control_t *room, const room_event_t *event) {
+    (void)event;
+    user_t user;
+    PROF_BEGIN(PROF_PIN_VERIFY);
+    bool ok = room_control_identify(room, room->input_buffer, room->input_index, &user);
+    PROF_END(PROF_PIN_VERIFY);
+
+    if (ok) {
+        room->user = user;
+        room_control_record_attempt(room, true);
+        TLOG("ACCESO: usuario=%u rol=%{NONE|USER|ADMIN}\r\n", user.id, user.role);
+        return ROOM_IN_PASSWORD_OK;
+    }
+    room_control_record_attempt(room, false);
+    return ROOM_IN_PASSWORD_BAD;
+}
+
+static room_input_t action_manual_fan(room_control_t *room, const room_event_t *event) {
+    static const fan_level_t key_levels[] = {
+        FAN_LEVEL_OFF, FAN_LEVEL_LOW, FAN_LEVEL_MED, FAN_LEVEL_HIGH
+    };
+
+    room_control_force_level_now(room, key_levels[event->key - '0']);
+    return ROOM_IN_NONE;
+}
+
+// Salir de modo manual y volver a automático
+static room_input_t action_auto_fan(room_control_t *room, const room_event_t *event) {
+    (void)event;
+    room->manual_fan_override = false;
+    room->current_fan_level = room_control_calculate_fan_level(room, room->current_temperature);
+    room->display_update_needed = true;
+    return ROOM_IN_NONE;
+}
+
+static room_input_t action_temperature(room_control_t *room, const room_event_t *event) {
+    action_record_temperature(room, event);
+
+    // Update fan level automatically if not in manual override
+    if (!room->manual_fan_override && room->fan_mode == FAN_MODE_LEVELS) {
+        fan_level_t new_level = room_control_calculate_fan_level(room, event->temperature);
+        if (new_level != room->current_fan_level) {
+            room->current_fan_level = new_level;
+            room->display_update_needed = true;
+
+            // Debug: cambio de nivel de ventilador en modo AUTO
+            TLOG("AUTO: temp=%.1f -> nivel=%d\r\n",
+                 event->temperature, new_level);
+        }
+    }
+    return ROOM_IN_NONE;
+}
+
+static room_input_t action_record_temperature(room_control_t *room, const room_event_t *event) {
+    room->current_temperature = event->temperature;
+
+    // Ventana del promedio móvil que alimenta al PID
+    room->temp_readings[room->temp_index] = event->temperature;
+    room->temp_index = (room->temp_index + 1) % MAX_TEMP_READINGS;
+    if (room->temp_count < MAX_TEMP_READINGS) {
+        room->temp_count++;
+    }
+    return ROOM_IN_NONE;
+}
+
+static room_input_t action_command(room_control_t *room, const room_event_t *event) {
+    telemetry_event(TLM_EVT_COMMAND);
+    if (event->command.id == ROOM_CMD_FORCE_FAN) {
+        room_control_force_level_now(room, event->command.fan_level);
+    } else if (event->command.id == ROOM_CMD_SET_PASSWORD) {
+        pin_hash_t password;
+        if (pin_hash_create(&password, event->command.password,
+                            (uint8_t)strnlen(event->command.password, PIN_LENGTH_MAX + 1))) {
+            // LOGIN la lee desde la ISR: se reemplaza de una vez
+            uint32_t primask = __get_PRIMASK();
+            __disable_irq();
+            room->password = password;
+            __set_PRIMASK(primask);
+            config_store_set(CONFIG_KEY_PASSWORD, &room->password, sizeof(room->password));
+            alert_raise(ALERT_PASSWORD_CHANGED);
+        }
+    } else if (event->command.id == ROOM_CMD_SET_SETPOINT) {
+        room->setpoint = event->command.setpoint;
+        config_store_set(CONFIG_KEY_SETPOINT, &room->setpoint, sizeof(room->setpoint));
+        room->display_update_needed = true;
+    } else if (event->command.id == ROOM_CMD_SET_THRESHOLDS) {
+        memcpy(room->thresholds, event->command.thresholds, sizeof(room->thresholds));
+        config_store_set(CONFIG_KEY_THRESHOLDS, room->thresholds, sizeof(room->thresholds));
+        if (!room->manual_fan_override && room->fan_mode == FAN_MODE_LEVELS) {
+            room->current_fan_level = room_control_calculate_fan_level(room, room->current_temperature);
+        }
+        room->display_update_needed = true;
+    } else if (event->command.id == ROOM_CMD_SET_FAN_MODE &&
+               event->command.fan_mode != room->fan_mode) {
+        room->fan_mode = event->command.fan_mode;
+        uint8_t stored_mode = (uint8_t)room->fan_mode;
+        config_store_set(CONFIG_KEY_FAN_MODE, &stored_mode, sizeof(stored_mode));
+        room->manual_fan_override = false;
+        room->current_fan_level = room_control_calculate_fan_level(room, room->current_temperature);
+
+        // Transferencia sin saltos: el PID parte del duty actual
+        fan_pid_reset(&room->pid, room->fan_duty);
+        room->next_control_time = HAL_GetTick();
+        room->display_update_needed = true;
+    } else if (event->command.id == ROOM_CMD_APPLY_PROFILE) {
+        room_control_use_profile(room, &event->command.profile);
+        room->profile_active = true;
+    } else if (event->command.id == ROOM_CMD_CLEAR_PROFILE && room->profile_active) {
+        room_profile_t stored;
+        room_control_stored_profile(&stored);
+        room_control_use_profile(room, &stored);
+        room->profile_active = false;
+    }
+    return ROOM_IN_NONE;
+}
+
+// Acciones de entrada / salida
+
+static void enter_locked(room_control_t *room) {
+    room->door_locked = true;
+    room_control_clear_input(room);
+}
+
+static void enter_input_password(room_control_t *room) {
+    room_control_arm_timeout(room, room->last_input_time, INPUT_TIMEOUT_MS);
+}
+
+static void enter_unlocked(room_control_t *room) {
+    room->door_locked = false;
+    room->manual_fan_override = false;  // Reset manual override
+}
+
+static void enter_access_denied(room_control_t *room) {
+    room_control_arm_timeout(room, room->state_enter_time, ACCESS_DENIED_TIMEOUT_MS);
+    alert_raise(ALERT_ACCESS_DENIED);
+}
+
+// Presion de botón en una emergencia (extra)
+static void enter_emergency(room_control_t *room) {
+    room->door_locked = false;
+    room->current_fan_level = FAN_LEVEL_HIGH;
+    alert_raise(ALERT_EMERGENCY);
+}
+
+static void exit_input_password(room_control_t *room) {
+    room_control_clear_input(room);
+}
+
+// Al salir de emergencia el ventilador vuelve al nivel automático
+static void exit_emergency(room_control_t *room) {
+    if (!room->manual_fan_override) {
+        room->current_fan_level = room_control_calculate_fan_level(room, room->current_temperature);
+    }
+}
+
 // Private functions
 static void room_control_change_state(room_control_t *room, room_state_t new_state) {
 
-    // Debug: log de cambio de estado
-    printf("Estado -> %s (temp=%.1f, fan=%d, manual=%d)\r\n",
-           room_state_to_str(new_state),
-           room->current_temperature,
-           room->current_fan_level,
-           room->manual_fan_override);
+    // Debug: log de cambio de estado (nombres en el mismo orden que room_state_t)
+    TLOG("Estado -> %{LOCKED|UNLOCKED|INPUT_PASSWORD|ACCESS_DENIED|EMERGENCY} "
+         "(temp=%.1f, fan=%d, manual=%d)\r\n",
+         new_state,
+         room->current_temperature,
+         room->current_fan_level,
+         room->manual_fan_override);
+
+    if (room_state_exit[room->current_state] != NULL) {
+        room_state_exit[room->current_state](room);
+    }
 
     room->current_state = new_state;
     room->state_enter_time = HAL_GetTick();
     room->display_update_needed = true;
-    
-    // State entry actions
-    switch (new_state) {
-        case ROOM_STATE_LOCKED:
-            room->door_locked = true;
-            room_control_clear_input(room);
-            break;
-            
-        case ROOM_STATE_UNLOCKED:
-            room->door_locked = false;
-            room->manual_fan_override = false;  // Reset manual override
-            break;
+    room->timeout_armed = false;
 
-        // Presion de botón en una emergencia (extra)
-        case ROOM_STATE_ACCESS_DENIED:
-            room_control_clear_input(room);
-            break;
-            
-        default:
-            break;
+    room_state_entry[new_state](room);
+}
+
+static void room_control_arm_timeout(room_control_t *room, uint32_t start, uint32_t timeout_ms) {
+    room->timeout_deadline = start + timeout_ms;
+    room->timeout_armed = true;
+}
+
+// Saca el evento más antiguo de la cola (false si está vacía)
+static bool room_control_next_event(room_control_t *room, room_event_t *event) {
+    bool available = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (room->event_head != room->event_tail) {
+        *event = room->event_queue[room->event_tail % ROOM_EVENT_QUEUE_LEN];
+        room->event_tail++;
+        available = true;
     }
+
+    __set_PRIMASK(primask);
+    return available;
+}
+
+static void room_control_force_level_now(room_control_t *room, fan_level_t level) {
+    room->manual_fan_override = true;
+    room->current_fan_level = level;
+    room->display_update_needed = true;
+
+    // Debug: forzado manual de ventilador
+    TLOG("MANUAL: nivel=%d\r\n", level);
+}
+
+/**
+ * @brief Espera que corresponde a tantos fallos consecutivos (0 = ninguna).
+ * También la usa LOGIN en la consola.
+ */
+uint32_t room_control_lockout_ms(uint8_t failed_attempts) {
+    if (failed_attempts < ROOM_LOCKOUT_ATTEMPTS) {
+        return 0;
+    }
+    uint32_t ms = ROOM_LOCKOUT_BASE_MS;
+    for (uint8_t i = ROOM_LOCKOUT_ATTEMPTS; i < failed_attempts && ms < ROOM_LOCKOUT_MAX_MS; i++) {
+        ms *= 2U;
+    }
+    return (ms > ROOM_LOCKOUT_MAX_MS) ? ROOM_LOCKOUT_MAX_MS : ms;
+}
+
+static void room_control_start_lockout(room_control_t *room, uint32_t now) {
+    uint32_t ms = room_control_lockout_ms(room->failed_attempts);
+    if (ms == 0) {
+        return;
+    }
+    room->lockout_until = now + ms;
+    room->lockout_shown_s = (ms + 999U) / 1000U;
+    room->lockout_active = true;
+    room->display_update_needed = true;
+
+    TLOG("BLOQUEO: intentos=%u espera=%ums\r\n", room->failed_attempts, (unsigned)ms);
+}
+
+// Cuenta los intentos fallidos; solo se escribe la flash cuando cambia el contador
+static void room_control_record_attempt(room_control_t *room, bool success) {
+    if (success) {
+        if (room->failed_attempts == 0) {
+            return;
+        }
+        room->failed_attempts = 0;
+    } else {
+        if (room->failed_attempts < UINT8_MAX) {
+            room->failed_attempts++;
+        }
+        room_control_start_lockout(room, HAL_GetTick());
+    }
+    config_store_set(CONFIG_KEY_FAILED_ATTEMPTS, &room->failed_attempts, sizeof(room->failed_attempts));
+}
+
+// Vence el bloqueo y refresca la cuenta regresiva de LOCKED una vez por
+// segundo; devuelve true si hay algo que mostrar
+static bool room_control_update_lockout(room_control_t *room, uint32_t now) {
+    if (!room->lockout_active) {
+        return false;
+    }
+
+    int32_t left = (int32_t)(room->lockout_until - now);
+    uint32_t shown_s = (left > 0) ? ((uint32_t)left + 999U) / 1000U : 0U;
+    if (shown_s == room->lockout_shown_s) {
+        return false;
+    }
+
+    room->lockout_shown_s = shown_s;
+    if (shown_s == 0) {
+        room->lockout_active = false;
+    }
+    if (room->current_state == ROOM_STATE_LOCKED) {
+        room->display_update_needed = true;
+        return true;
+    }
+    return false;
 }
 
 static void room_control_update_display(room_control_t *room) {
 
+    PROF_BEGIN(PROF_ROOM_DISPLAY);
+
     ssd1306_Fill(Black);
 
     switch (room->current_state) {
@@ -337,17 +990,29 @@ static void room_control_update_display(room_control_t *room) {
             ssd1306_WriteString("SISTEMA", Font_11x18, White);
             ssd1306_SetCursor(10, 30);
             ssd1306_WriteString("BLOQUEADO", Font_11x18, White);
+            room_control_draw_clock();
+
+            if (room->lockout_active) {
+                char wait_buffer[20];
+                snprintf(wait_buffer, sizeof(wait_buffer), "Espere %lus",
+                         (unsigned long)room->lockout_shown_s);
+                ssd1306_SetCursor(10, 50);
+                ssd1306_WriteString(wait_buffer, Font_7x10, White);
+            }
             break;
 
         case ROOM_STATE_INPUT_PASSWORD: {
             ssd1306_SetCursor(10, 10);
             ssd1306_WriteString("CLAVE:", Font_11x18, White);
 
-            char stars[PASSWORD_LENGTH + 1];
-            for (int i = 0; i < PASSWORD_LENGTH; i++)
+            // Guiones hasta el largo de la clave; más asteriscos si se pasa
+            uint8_t expected = room_control_expected_length(room);
+            uint8_t shown = (room->input_index > expected) ? room->input_index : expected;
+            char stars[PIN_LENGTH_MAX + 1];
+            for (int i = 0; i < shown; i++)
                 stars[i] = (i < room->input_index) ? '*' : '_';
 
-            stars[PASSWORD_LENGTH] = '\0';
+            stars[shown] = '\0';
 
             ssd1306_SetCursor(10, 35);
             ssd1306_WriteString(stars, Font_11x18, White);
@@ -370,11 +1035,20 @@ static void room_control_update_display(room_control_t *room) {
                 (room->current_fan_level == FAN_LEVEL_MED) ? "Vent: MEDIO" :
                                                              "Vent: ALTO";
 
+            // En modo PID el duty es continuo: se muestra en %
+            char duty_buffer[16];
+            if (room->fan_mode == FAN_MODE_PID && !room->manual_fan_override) {
+                snprintf(duty_buffer, sizeof(duty_buffer), "Vent: %u%%",
+                         (unsigned)(room_control_fan_duty(room) / 10));
+                fan_str = duty_buffer;
+            }
+
             ssd1306_SetCursor(5, 40);
             ssd1306_WriteString(fan_str, Font_11x18, White);
 
             const char *mode_str =
-                room->manual_fan_override ? "Modo: MANUAL" : "Modo: AUTO";
+                room->manual_fan_override     ? "Modo: MANUAL" :
+                room->fan_mode == FAN_MODE_PID ? "Modo: PID"    : "Modo: AUTO";
 
             ssd1306_SetCursor(10, 55);
             ssd1306_WriteString(mode_str, Font_11x18, White);
@@ -394,9 +1068,43 @@ static void room_control_update_display(room_control_t *room) {
             ssd1306_SetCursor(0, 35);
             ssd1306_WriteString("SALGA", Font_11x18, White);
             break;
+
+        default:
+            break;
     }
 
     ssd1306_UpdateScreen();
+
+    PROF_END(PROF_ROOM_DISPLAY);
+}
+
+/**
+ * @brief Hora local hh:mm:ss en la página 0 (filas 0-7), libre en LOCKED.
+ */
+static void room_control_draw_clock(void) {
+    if (!rtc_clock_is_set()) {
+        return;
+    }
+
+    uint32_t local = rtc_clock_local_seconds_of_day();
+    char clock_buffer[16];
+    snprintf(clock_buffer, sizeof(clock_buffer), "%02u:%02u:%02u",
+             (unsigned)(local / 3600U), (unsigned)(local / 60U % 60U), (unsigned)(local % 60U));
+    ssd1306_FillRectangle(0, 0, SSD1306_WIDTH - 1, 7, Black);
+    ssd1306_SetCursor(40, 0);
+    ssd1306_WriteString(clock_buffer, Font_6x8, White);
+}
+
+/**
+ * @brief Redibuja solo el reloj (alarma de 1 Hz del RTC): una página de
+ * 128 bytes por I2C en vez de la pantalla entera.
+ */
+void room_control_show_clock(room_control_t *room) {
+    if (room->current_state != ROOM_STATE_LOCKED || room->display_update_needed) {
+        return;     // Otra pantalla, o ya viene un redibujado completo
+    }
+    room_control_draw_clock();
+    ssd1306_UpdatePage(0);
 }
 
 static void room_control_update_door(room_control_t *room) {
@@ -412,102 +1120,169 @@ static void room_control_update_door(room_control_t *room) {
 }
 
 static void room_control_update_fan(room_control_t *room) {
-    // TODO: TAREA - Implementar control PWM del ventilador
-    // Calcular valor PWM basado en current_fan_level
-    // Ejemplo:
-    // uint32_t pwm_value = (room->current_fan_level * 99) / 100;  // 0-99 para period=99
-    uint32_t pwm_value = 0;
-    switch (room->current_fan_level) {
-        case FAN_LEVEL_OFF:
-            pwm_value = 0;
-            break;
-        case FAN_LEVEL_LOW:
-            pwm_value = 30; // 30% duty cycle
-            break;
-        case FAN_LEVEL_MED:
-            pwm_value = 70; // 70% duty cycle
-            break;
-        case FAN_LEVEL_HIGH:
-            pwm_value = 99; // 100% duty cycle
-            break;
-        default:
-            pwm_value = 0; 
-            break;
-    }
+    room->fan_duty = room_control_fan_duty(room);
 
-    // Si no hay cambio, solo asegurar el valor y salir
-    if (pwm_value == fan_current_pwm_value) {
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pwm_value); // Aplicar valor PWM
-        return;
-    }
+    // Duty en por mil escalado al periodo actual del timer (1000 = ARR + 1, siempre encendido)
+    uint32_t period = __HAL_TIM_GET_AUTORELOAD(&htim3) + 1;
+    uint32_t pwm_value = ((uint32_t)room->fan_duty * period) / FAN_DUTY_MAX;
 
-    // Si el DMA no está listo, caer a modo directo (sin fade)
-    if (htim3.hdma[TIM_DMA_ID_CC1] == NULL ||
-        htim3.hdma[TIM_DMA_ID_CC1]->State != HAL_DMA_STATE_READY) {
+    // La transición suave (DMA) la resuelve el motor de rampas
+    fan_ramp_set_target((uint16_t)pwm_value);
+}
 
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pwm_value); // Aplicar valor PWM directo
-        fan_current_pwm_value = pwm_value;
-        return;
+// Duty que corresponde al modo actual (manual y emergencia usan niveles)
+static uint16_t room_control_fan_duty(room_control_t *room) {
+    if (room->fan_mode == FAN_MODE_PID &&
+        !room->manual_fan_override &&
+        room->current_state != ROOM_STATE_EMERGENCY) {
+        return (uint16_t)room->pid.output;
+    }
+    uint16_t duty = (uint16_t)(room->current_fan_level * (FAN_DUTY_MAX / 100));
+    if (!room->manual_fan_override && room->current_state != ROOM_STATE_EMERGENCY) {
+        // Rango del perfil activo (el PID ya lo respeta con out_min/out_max)
+        duty = (duty < room->fan_min) ? room->fan_min : duty;
+        duty = (duty > room->fan_max) ? room->fan_max : duty;
+    }
+    return duty;
+}
+
+static float room_control_filtered_temperature(room_control_t *room) {
+    if (room->temp_count == 0) {
+        return room->current_temperature;
     }
 
-    // Preparar buffer de transición suave entre el valor actual y el nuevo
-    uint32_t start = fan_current_pwm_value;
-    int32_t delta = (int32_t)pwm_value - (int32_t)start;
+    float sum = 0.0f;
+    for (uint8_t i = 0; i < room->temp_count; i++) {
+        sum += room->temp_readings[i];
+    }
+    return sum / (float)room->temp_count;
+}
 
-    for (int i = 0; i < FAN_FADE_STEPS; i++) {
-        // i+1 para que el último valor sea exactamente pwm_value
-        fan_dma_buffer[i] = (uint16_t)(start + (delta * (i + 1) / FAN_FADE_STEPS));
+// Un paso del PID; devuelve true si cambió el duty a aplicar
+static bool room_control_run_pid(room_control_t *room) {
+    if (room->manual_fan_override || room->current_state == ROOM_STATE_EMERGENCY) {
+        // Seguir el duty real para retomar sin saltos
+        fan_pid_reset(&room->pid, room->fan_duty);
+        return false;
     }
 
-    fan_current_pwm_value = pwm_value;
-    fan_dma_in_progress = 1;
+    int32_t previous = room->pid.output;
+    int32_t measurement = (int32_t)(room_control_filtered_temperature(room) * 100.0f);
+    int32_t output = fan_pid_update(&room->pid, room->setpoint, measurement, FAN_PID_PERIOD_MS);
 
-    // Iniciar transferencia DMA sobre TIM3 CH1
-    if (HAL_TIM_PWM_Start_DMA(&htim3,
-                              TIM_CHANNEL_1,
-                              (uint32_t *)fan_dma_buffer,
-                              FAN_FADE_STEPS) != HAL_OK) {
+    if (output == previous) {
+        return false;
+    }
 
-        // Si falla, desactivar el flag y aplicar el valor directo
-        fan_dma_in_progress = 0;
-        __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, pwm_value);
+    // Cambios visibles en pantalla solo por pasos de 1 %
+    if (output / 10 != previous / 10) {
+        room->display_update_needed = true;
     }
+    return true;
 }
 
-static fan_level_t room_control_calculate_fan_level(float temperature) {
+static fan_level_t room_control_calculate_fan_level(const room_control_t *room, float temperature) {
     // TODO: TAREA - Implementar lógica de niveles de ventilador
 
     // Seguridad: si llega un número fuera de rango extremo, evitar comportamientos raros
     if (temperature < -20.0f || temperature > 80.0f) {
         return FAN_LEVEL_OFF;
     }
-    if (temperature < TEMP_THRESHOLD_LOW) {  
+    int32_t centi = (int32_t)(temperature * 100.0f);
+    if (centi < room->thresholds[0]) {
         return FAN_LEVEL_OFF;
-    } else if (temperature < TEMP_THRESHOLD_MED) {
+    } else if (centi < room->thresholds[1]) {
         return FAN_LEVEL_LOW;
-    } else if (temperature < TEMP_THRESHOLD_HIGH) {
+    } else if (centi < room->thresholds[2]) {
         return FAN_LEVEL_MED;
     } else {
         return FAN_LEVEL_HIGH;
     }
 }
 
-static void room_control_clear_input(room_control_t *room) {
-    memset(room->input_buffer, 0, sizeof(room->input_buffer));
-    room->input_index = 0;
+// Configuración persistente. Un valor fuera de rango (flash de otra versión
+// del firmware) se ignora y queda el valor por defecto.
+static void room_control_load_config(room_control_t *room) {
+    pin_hash_t stored;
+    char legacy[PIN_LENGTH_MIN];
+    if (config_store_get(CONFIG_KEY_PASSWORD, &stored, sizeof(stored))) {
+        if (pin_hash_check_format(&stored)) {
+            room->password = stored;
+        }
+    } else if (config_store_get(CONFIG_KEY_PASSWORD, legacy, sizeof(legacy))) {
+        // Clave en texto de una versión anterior: se reemplaza por su hash
+        if (pin_hash_create(&room->password, legacy, sizeof(legacy))) {
+            // El registro en texto sigue legible en su página hasta que se
+            // borre: compactar ya en lugar de esperar a que la rote el anillo
+            if (config_store_set(CONFIG_KEY_PASSWORD, &room->password, sizeof(room->password))) {
+                config_store_compact();
+            }
+        }
+        memset(legacy, 0, sizeof(legacy));
+    }
+
+    room_profile_t climate;
+    room_control_stored_profile(&climate);
+    room->fan_mode = (fan_mode_t)climate.fan_mode;
+    room->setpoint = climate.setpoint;
+    memcpy(room->thresholds, climate.thresholds, sizeof(room->thresholds));
+
+    // Un reset durante el bloqueo no lo levanta: la espera vuelve a empezar
+    uint8_t failed_attempts;
+    if (config_store_get(CONFIG_KEY_FAILED_ATTEMPTS, &failed_attempts, sizeof(failed_attempts))) {
+        room->failed_attempts = failed_attempts;
+        room_control_start_lockout(room, HAL_GetTick());
+    }
 }
 
-// Callback de HAL para cuando termina una transferencia PWM por DMA
-void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
-{
-    if (htim->Instance == TIM3) {
-        // Detener DMA para este canal
-        HAL_TIM_PWM_Stop_DMA(htim, TIM_CHANNEL_1);
+// Clima guardado (FAN_MODE, SET_POINT, SET_THRESH) como perfil, sin límites de duty
+static void room_control_stored_profile(room_profile_t *profile) {
+    memset(profile, 0, sizeof(*profile));
+    profile->fan_mode = FAN_MODE_LEVELS;
+    profile->fan_max = 100;
+    profile->setpoint = (int16_t)(DEFAULT_SETPOINT * 100.0f);
+    memcpy(profile->thresholds, DEFAULT_THRESHOLDS, sizeof(profile->thresholds));
+
+    int16_t thresholds[ROOM_THRESHOLD_COUNT];
+    if (config_store_get(CONFIG_KEY_THRESHOLDS, thresholds, sizeof(thresholds)) &&
+        thresholds[0] < thresholds[1] && thresholds[1] < thresholds[2]) {
+        memcpy(profile->thresholds, thresholds, sizeof(profile->thresholds));
+    }
+
+    uint8_t mode;
+    if (config_store_get(CONFIG_KEY_FAN_MODE, &mode, sizeof(mode)) && mode <= FAN_MODE_PID) {
+        profile->fan_mode = mode;
+    }
+
+    int32_t setpoint;
+    if (config_store_get(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint)) &&
+        setpoint >= 1000 && setpoint <= 4000) {
+        profile->setpoint = (int16_t)setpoint;
+    }
+}
 
-        // Marcar que ya no hay transición en curso
-        fan_dma_in_progress = 0;
+// Cambio de perfil: el PID sigue desde el duty actual, dentro del rango nuevo
+static void room_control_use_profile(room_control_t *room, const room_profile_t *profile) {
+    room->fan_mode = (fan_mode_t)profile->fan_mode;
+    room->setpoint = profile->setpoint;
+    memcpy(room->thresholds, profile->thresholds, sizeof(room->thresholds));
+    room->fan_min = (uint16_t)(profile->fan_min * (FAN_DUTY_MAX / 100));
+    room->fan_max = (uint16_t)(profile->fan_max * (FAN_DUTY_MAX / 100));
+    room->pid.out_min = room->fan_min;
+    room->pid.out_max = room->fan_max;
 
-        // Asegurar que el CCR queda exactamente en el valor objetivo final
-        __HAL_TIM_SET_COMPARE(htim, TIM_CHANNEL_1, fan_current_pwm_value);
+    if (!room->manual_fan_override) {
+        room->current_fan_level = room_control_calculate_fan_level(room, room->current_temperature);
     }
-}
\ No newline at end of file
+    fan_pid_reset(&room->pid, room->fan_duty);
+    room->next_control_time = HAL_GetTick();
+    room->display_update_needed = true;
+
+    TLOG("PERFIL: modo=%{AUTO|PID} sp=%d fan=%u-%u\r\n",
+         profile->fan_mode, profile->setpoint, profile->fan_min, profile->fan_max);
+}
+
+static void room_control_clear_input(room_control_t *room) {
+    memset(room->input_buffer, 0, sizeof(room->input_buffer));
+    room->input_index = 0;
+}
@@ -0,0 +1,419 @@
+#include "rtc_clock.h"
+#include "config_store.h"
+#include "tlog.h"
+#include <stdio.h>
+#include <string.h>
+
+#define RTC_CLOCK_CAL_SCALE     1048576LL     // 2^20 ciclos del LSE por ventana
+
+extern RTC_HandleTypeDef hrtc;
+
+// Así se guarda en config_store (CONFIG_KEY_RTC)
+typedef struct {
+    int16_t base_pulses;
+    int16_t tz_min;
+} rtc_clock_config_t;
+
+static const uint16_t RTC_DAYS_BEFORE_MONTH[12] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+};
+
+static struct {
+    bool set;
+    volatile uint32_t now_s;        // Unix, se actualiza en cada alarma
+    volatile bool second_pending;   // Alarma A sin atender
+    rtc_clock_config_t config;
+
+    // SET_TIME recibido en la ISR
+    volatile bool sync_pending;
+    uint32_t sync_s;
+    uint16_t sync_ms;
+    bool sync_has_tz;
+    int16_t sync_tz;
+    uint32_t sync_tick;             // Llegada, para descontar la demora
+
+    // Slewing en curso: slew_ms repartidos en slew_duration desde slew_start
+    int32_t slew_ms;
+    uint32_t slew_start;
+    uint32_t slew_duration;
+
+    // Referencia para medir la deriva: sincronización, diferencia que
+    // quedaba entonces y lo que el slewing corrigió desde ahí
+    bool ref_valid;
+    int64_t ref_ms;
+    int32_t ref_offset_ms;
+    int32_t corrected_ms;
+
+    uint32_t syncs;
+    uint32_t steps;
+    int32_t last_offset_ms;
+    uint32_t alarms;
+    uint32_t generation;            // Saltos y cambios de huso
+} rtc;
+
+// Helpers privados
+
+static bool rtc_clock_leap(uint32_t year)
+{
+    return (year % 4U) == 0U;   // 2000-2099: alcanza con esto
+}
+
+static uint32_t rtc_clock_to_unix(const RTC_DateTypeDef *date, const RTC_TimeTypeDef *time)
+{
+    uint32_t year = 2000U + date->Year;
+    uint32_t days = date->Year * 365U + (date->Year + 3U) / 4U +
+                    RTC_DAYS_BEFORE_MONTH[(date->Month - 1U) % 12U] + date->Date - 1U;
+    if (date->Month > 2U && rtc_clock_leap(year)) {
+        days++;
+    }
+    return RTC_CLOCK_UNIX_MIN + days * 86400U +
+           time->Hours * 3600U + time->Minutes * 60U + time->Seconds;
+}
+
+static void rtc_clock_from_unix(uint32_t unix_s, RTC_DateTypeDef *date, RTC_TimeTypeDef *time)
+{
+    uint32_t days = (unix_s - RTC_CLOCK_UNIX_MIN) / 86400U;
+    uint32_t of_day = (unix_s - RTC_CLOCK_UNIX_MIN) % 86400U;
+
+    memset(time, 0, sizeof(*time));
+    time->Hours = (uint8_t)(of_day / 3600U);
+    time->Minutes = (uint8_t)(of_day / 60U % 60U);
+    time->Seconds = (uint8_t)(of_day % 60U);
+    time->DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+    time->StoreOperation = RTC_STOREOPERATION_RESET;
+
+    date->WeekDay = (uint8_t)((days + 5U) % 7U + 1U);   // 2000-01-01 fue sábado
+    uint32_t year = 0;
+    for (;;) {
+        uint32_t in_year = rtc_clock_leap(2000U + year) ? 366U : 365U;
+        if (days < in_year) {
+            break;
+        }
+        days -= in_year;
+        year++;
+    }
+    uint32_t month = 12U;
+    uint32_t leap = rtc_clock_leap(2000U + year) ? 1U : 0U;
+    while (month > 1U && days < RTC_DAYS_BEFORE_MONTH[month - 1U] + ((month > 2U) ? leap : 0U)) {
+        month--;
+    }
+    days -= RTC_DAYS_BEFORE_MONTH[month - 1U] + ((month > 2U) ? leap : 0U);
+    date->Year = (uint8_t)year;
+    date->Month = (uint8_t)month;
+    date->Date = (uint8_t)(days + 1U);
+}
+
+// Hora del RTC en ms Unix (solo desde el superloop: GetDate libera los registros sombra)
+static int64_t rtc_clock_read_ms(void)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    HAL_RTC_GetTime(&hrtc, &time, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(&hrtc, &date, RTC_FORMAT_BIN);
+
+    // SSR cuenta hacia abajo; tras un corrimiento puede pasar de SecondFraction
+    int32_t fraction = ((int32_t)time.SecondFraction - (int32_t)time.SubSeconds) * 1000 /
+                       (int32_t)(time.SecondFraction + 1U);
+    return (int64_t)rtc_clock_to_unix(&date, &time) * 1000 + fraction;
+}
+
+// Calibración fina: pulsos positivos con CALP (+512) menos CALM
+static void rtc_clock_set_rate(int32_t pulses)
+{
+    uint32_t plus = (pulses > 0) ? RTC_SMOOTHCALIB_PLUSPULSES_SET : RTC_SMOOTHCALIB_PLUSPULSES_RESET;
+    uint32_t minus = (uint32_t)((pulses > 0) ? 512 - pulses : -pulses);
+    HAL_RTCEx_SetSmoothCalib(&hrtc, RTC_SMOOTHCALIB_PERIOD_32SEC, plus, minus);
+}
+
+// Parte del slewing que todavía no se aplicó
+static int32_t rtc_clock_slew_left(uint32_t now)
+{
+    uint32_t elapsed = now - rtc.slew_start;
+    if (rtc.slew_ms == 0 || elapsed >= rtc.slew_duration) {
+        return 0;
+    }
+    return (int32_t)((int64_t)rtc.slew_ms * (rtc.slew_duration - elapsed) / rtc.slew_duration);
+}
+
+static void rtc_clock_end_slew(uint32_t now)
+{
+    rtc.corrected_ms += rtc.slew_ms - rtc_clock_slew_left(now);
+    rtc.slew_ms = 0;
+    rtc_clock_set_rate(rtc.config.base_pulses);
+}
+
+static void rtc_clock_start_slew(int32_t offset_ms, uint32_t now)
+{
+    if (offset_ms == 0) {
+        return;
+    }
+    int32_t slew = (offset_ms > 0) ? RTC_CLOCK_SLEW_PULSES : -RTC_CLOCK_SLEW_PULSES;
+    rtc.slew_ms = offset_ms;
+    rtc.slew_start = now;
+    rtc.slew_duration = (uint32_t)((int64_t)offset_ms * RTC_CLOCK_CAL_SCALE / slew);
+    rtc_clock_set_rate(rtc.config.base_pulses + slew);
+}
+
+// Salto: calendario en el segundo y corrimiento hacia adelante por los ms
+static void rtc_clock_step(int64_t unix_ms)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    uint32_t ms = (uint32_t)(unix_ms % 1000);
+    rtc_clock_from_unix((uint32_t)(unix_ms / 1000), &date, &time);
+
+    HAL_RTC_SetTime(&hrtc, &time, RTC_FORMAT_BIN);
+    HAL_RTC_SetDate(&hrtc, &date, RTC_FORMAT_BIN);
+    if (ms != 0U) {
+        uint32_t prediv_s = hrtc.Init.SynchPrediv;
+        HAL_RTCEx_SetSynchroShift(&hrtc, RTC_SHIFTADD1S_SET, (1000U - ms) * (prediv_s + 1U) / 1000U);
+    }
+    HAL_RTCEx_BKUPWrite(&hrtc, RTC_BKP_DR0, RTC_CLOCK_BKP_MAGIC);
+}
+
+static void rtc_clock_apply_sync(void)
+{
+    uint32_t now = HAL_GetTick();
+    int64_t target = (int64_t)rtc.sync_s * 1000 + rtc.sync_ms + (now - rtc.sync_tick);
+    int64_t offset = target - rtc_clock_read_ms();
+    if (!rtc.set) {
+        offset = 0;     // Sin hora no hay diferencia que medir: salto
+    } else if (offset > INT32_MAX || offset < -INT32_MAX) {
+        offset = (offset > 0) ? INT32_MAX : -INT32_MAX;   // Solo para mostrarla: es un salto
+    }
+    bool step = !rtc.set || offset > RTC_CLOCK_STEP_MS || offset < -(int64_t)RTC_CLOCK_STEP_MS;
+
+    if (rtc.sync_has_tz && rtc.sync_tz != rtc.config.tz_min) {
+        rtc.config.tz_min = rtc.sync_tz;
+        rtc.generation++;
+    }
+
+    rtc_clock_end_slew(now);
+    if (step) {
+        rtc_clock_step(target);
+        rtc.set = true;
+        rtc.steps++;
+        rtc.generation++;
+        rtc.ref_valid = true;
+        rtc.ref_ms = target;
+        rtc.ref_offset_ms = 0;
+        rtc.corrected_ms = 0;
+    } else {
+        // Deriva: lo que se desvió desde la referencia más lo ya corregido
+        int64_t elapsed = target - rtc.ref_ms;
+        if (!rtc.ref_valid) {
+            rtc.ref_valid = true;
+            rtc.ref_ms = target;
+            rtc.ref_offset_ms = (int32_t)offset;
+            rtc.corrected_ms = 0;
+        } else if (elapsed >= RTC_CLOCK_DRIFT_MIN_MS) {
+            int64_t drift = offset - rtc.ref_offset_ms + rtc.corrected_ms;
+            int32_t base = rtc.config.base_pulses + (int32_t)(drift * RTC_CLOCK_CAL_SCALE / elapsed);
+            base = (base > RTC_CLOCK_CAL_MAX) ? RTC_CLOCK_CAL_MAX : base;
+            base = (base < -RTC_CLOCK_CAL_MAX) ? -RTC_CLOCK_CAL_MAX : base;
+            rtc.config.base_pulses = (int16_t)base;
+            rtc.ref_ms = target;
+            rtc.ref_offset_ms = (int32_t)offset;
+            rtc.corrected_ms = 0;
+        }
+        rtc_clock_start_slew((int32_t)offset, now);
+        if (rtc.slew_ms == 0) {
+            rtc_clock_set_rate(rtc.config.base_pulses);
+        }
+    }
+
+    config_store_set(CONFIG_KEY_RTC, &rtc.config, sizeof(rtc.config));
+    rtc.now_s = (uint32_t)(rtc_clock_read_ms() / 1000);
+    rtc.syncs++;
+    rtc.last_offset_ms = (int32_t)offset;
+
+    char text[RTC_CLOCK_TEXT_LEN];
+    rtc_clock_format(rtc.now_s, true, text, sizeof(text));
+    printf("OK: TIME %s offset=%ldms %s\r\n", text, (long)offset, step ? "salto" : "slew");
+    TLOG("RTC: unix=%u tick=%u offset=%dms\r\n", (unsigned)rtc.now_s, (unsigned)now, (int)offset);
+}
+
+// API pública
+
+/**
+ * @brief Retoma la hora si el dominio de backup la conservó, aplica la
+ * calibración guardada y arma la alarma de 1 Hz.
+ */
+void rtc_clock_init(void)
+{
+    memset(&rtc, 0, sizeof(rtc));
+    if (!config_store_get(CONFIG_KEY_RTC, &rtc.config, sizeof(rtc.config)) ||
+        rtc.config.base_pulses > RTC_CLOCK_CAL_MAX || rtc.config.base_pulses < -RTC_CLOCK_CAL_MAX) {
+        rtc.config = (rtc_clock_config_t){ 0 };
+    }
+    rtc_clock_set_rate(rtc.config.base_pulses);
+
+    rtc.set = HAL_RTCEx_BKUPRead(&hrtc, RTC_BKP_DR0) == RTC_CLOCK_BKP_MAGIC;
+    if (rtc.set) {
+        rtc.now_s = (uint32_t)(rtc_clock_read_ms() / 1000);
+    }
+
+    RTC_AlarmTypeDef alarm = { 0 };
+    alarm.AlarmMask = RTC_ALARMMASK_ALL;
+    alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+    alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+    alarm.AlarmDateWeekDay = 1;
+    alarm.Alarm = RTC_ALARM_A;
+    HAL_RTC_SetAlarm_IT(&hrtc, &alarm, RTC_FORMAT_BIN);
+}
+
+/**
+ * @brief Pide sincronizar con la hora dada. Desde la ISR; false si la hora
+ * está fuera del calendario del RTC o ya hay un pedido pendiente.
+ */
+bool rtc_clock_request_sync(uint32_t unix_s, uint16_t ms, bool has_tz, int16_t tz_min)
+{
+    if (rtc.sync_pending || unix_s < RTC_CLOCK_UNIX_MIN || unix_s >= RTC_CLOCK_UNIX_MAX || ms > 999U ||
+        (has_tz && (tz_min < RTC_CLOCK_TZ_MIN || tz_min > RTC_CLOCK_TZ_MAX))) {
+        return false;
+    }
+    rtc.sync_s = unix_s;
+    rtc.sync_ms = ms;
+    rtc.sync_has_tz = has_tz;
+    rtc.sync_tz = tz_min;
+    rtc.sync_tick = HAL_GetTick();
+    rtc.sync_pending = true;
+    return true;
+}
+
+/**
+ * @brief Aplica SET_TIME y atiende la alarma de 1 Hz. true cuando cambió
+ * el segundo (hay que redibujar el reloj).
+ */
+bool rtc_clock_poll(void)
+{
+    bool changed = false;
+
+    if (rtc.sync_pending) {
+        rtc_clock_apply_sync();
+        rtc.sync_pending = false;
+        changed = true;
+    }
+
+    if (rtc.second_pending) {
+        rtc.second_pending = false;
+        uint32_t now = HAL_GetTick();
+        if (rtc.slew_ms != 0 && rtc_clock_slew_left(now) == 0) {
+            rtc_clock_end_slew(now);
+        }
+        if (rtc.set) {
+            rtc.now_s = (uint32_t)(rtc_clock_read_ms() / 1000);
+        }
+        changed = true;
+    }
+    return changed && rtc.set;
+}
+
+/**
+ * @brief Alarma A (HAL_RTC_AlarmAEventCallback), una vez por segundo.
+ */
+void rtc_clock_on_alarm(void)
+{
+    rtc.second_pending = true;
+    rtc.alarms++;
+}
+
+bool rtc_clock_is_set(void)
+{
+    return rtc.set;
+}
+
+/**
+ * @brief Hora Unix del último segundo atendido (0 sin hora). No toca el RTC:
+ * se puede llamar desde una ISR.
+ */
+uint32_t rtc_clock_now(void)
+{
+    return rtc.set ? rtc.now_s : 0U;
+}
+
+/**
+ * @brief Marca de tiempo para logs, telemetría y alertas: hora Unix o, sin
+ * hora, segundos desde el arranque (siempre menores que RTC_CLOCK_UNIX_MIN).
+ */
+uint32_t rtc_clock_timestamp(void)
+{
+    return rtc.set ? rtc.now_s : HAL_GetTick() / 1000U;
+}
+
+uint32_t rtc_clock_local_seconds_of_day(void)
+{
+    return rtc_clock_local_now() % 86400U;
+}
+
+uint32_t rtc_clock_local_now(void)
+{
+    return (uint32_t)((int64_t)rtc.now_s + rtc.config.tz_min * 60);
+}
+
+/**
+ * @brief Cambia con cada salto de la hora o del huso: lo que se haya
+ * calculado a partir de la hora local (alarma B armada) ya no vale.
+ */
+uint32_t rtc_clock_generation(void)
+{
+    return rtc.generation;
+}
+
+/**
+ * @brief Arma la alarma B para la hora Unix dada (día del mes, hora,
+ * minuto y segundo, sin máscaras): HAL_RTCEx_AlarmBEventCallback().
+ */
+bool rtc_clock_arm_alarm_b(uint32_t unix_s)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    if (!rtc.set || unix_s < RTC_CLOCK_UNIX_MIN || unix_s >= RTC_CLOCK_UNIX_MAX) {
+        return false;
+    }
+    rtc_clock_from_unix(unix_s, &date, &time);
+
+    RTC_AlarmTypeDef alarm = { 0 };
+    alarm.AlarmTime = time;
+    alarm.AlarmMask = RTC_ALARMMASK_NONE;
+    alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+    alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+    alarm.AlarmDateWeekDay = date.Date;
+    alarm.Alarm = RTC_ALARM_B;
+    return HAL_RTC_SetAlarm_IT(&hrtc, &alarm, RTC_FORMAT_BIN) == HAL_OK;
+}
+
+void rtc_clock_disarm_alarm_b(void)
+{
+    HAL_RTC_DeactivateAlarm(&hrtc, RTC_ALARM_B);
+}
+
+/**
+ * @brief "AAAA-MM-DD hh:mm:ss", en UTC o en hora local.
+ */
+void rtc_clock_format(uint32_t unix_s, bool local, char *text, size_t len)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    if (local) {
+        unix_s = (uint32_t)((int64_t)unix_s + rtc.config.tz_min * 60);
+    }
+    if (unix_s < RTC_CLOCK_UNIX_MIN) {
+        unix_s = RTC_CLOCK_UNIX_MIN;
+    }
+    rtc_clock_from_unix(unix_s, &date, &time);
+    snprintf(text, len, "%04u-%02u-%02u %02u:%02u:%02u", 2000U + date.Year, (unsigned)date.Month,
+             (unsigned)date.Date, (unsigned)time.Hours, (unsigned)time.Minutes, (unsigned)time.Seconds);
+}
+
+void rtc_clock_get_stats(rtc_clock_stats_t *stats)
+{
+    stats->set = rtc.set;
+    stats->tz_min = rtc.config.tz_min;
+    stats->syncs = rtc.syncs;
+    stats->steps = rtc.steps;
+    stats->last_offset_ms = rtc.last_offset_ms;
+    stats->slew_left_ms = rtc_clock_slew_left(HAL_GetTick());
+    stats->base_pulses = rtc.config.base_pulses;
+    stats->alarms = rtc.alarms;
+}
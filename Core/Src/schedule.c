@@ -0,0 +1,523 @@
+#include "schedule.h"
+#include "config_store.h"
+#include "rtc_clock.h"
+#include "tlog.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SCHEDULE_PROFILES_PER_KEY   2U
+#define SCHEDULE_ENTRIES_PER_KEY    8U
+#define SCHEDULE_PROFILE_KEYS       (SCHEDULE_PROFILES / SCHEDULE_PROFILES_PER_KEY)
+#define SCHEDULE_ENTRY_KEYS         (SCHEDULE_ENTRIES / SCHEDULE_ENTRIES_PER_KEY)
+#define SCHEDULE_TRANSITIONS        (SCHEDULE_ENTRIES * 7U)
+#define SCHEDULE_DAY_MIN            1440U
+#define SCHEDULE_LIST_PER_POLL      4U
+
+_Static_assert(sizeof(room_profile_t) * SCHEDULE_PROFILES_PER_KEY <= CONFIG_STORE_VALUE_MAX, "perfiles por clave");
+_Static_assert(sizeof(schedule_entry_t) * SCHEDULE_ENTRIES_PER_KEY <= CONFIG_STORE_VALUE_MAX, "entradas por clave");
+_Static_assert(CONFIG_KEY_PROFILES_0 + SCHEDULE_PROFILE_KEYS - 1U == CONFIG_KEY_PROFILES_1, "claves de perfiles");
+_Static_assert(CONFIG_KEY_SCHEDULE_0 + SCHEDULE_ENTRY_KEYS - 1U == CONFIG_KEY_SCHEDULE_1, "claves de la programación");
+_Static_assert(SCHEDULE_TRANSITIONS <= 255U, "índice de 8 bits");
+
+// Lunes a domingo
+static const char SCHEDULE_DAY_LETTERS[] = "LMXJVSD";
+
+// Perfil sin configurar: el control por niveles de fábrica, sin límites
+static const room_profile_t SCHEDULE_DEFAULT_PROFILE = {
+    .fan_mode = FAN_MODE_LEVELS,
+    .fan_min = 0,
+    .fan_max = 100,
+    .setpoint = 2500,
+    .thresholds = { 2500, 2800, 3100 }
+};
+
+typedef enum {
+    SCHED_REQ_NONE = 0,
+    SCHED_REQ_PID,
+    SCHED_REQ_LEVELS,
+    SCHED_REQ_FAN,
+    SCHED_REQ_ADD,
+    SCHED_REQ_DELETE,
+    SCHED_REQ_CLEAR,
+    SCHED_REQ_LIST
+} schedule_request_t;
+
+// Cambio de perfil en un minuto de la semana (lunes 00:00 = 0)
+typedef struct {
+    uint16_t minute;
+    uint8_t profile;
+} schedule_transition_t;
+
+static struct {
+    room_profile_t profiles[SCHEDULE_PROFILES];
+    schedule_entry_t entries[SCHEDULE_ENTRIES];     // Las libres al final
+    uint8_t entry_count;
+
+    // Programación compilada y posición actual
+    schedule_transition_t table[SCHEDULE_TRANSITIONS];
+    uint8_t count;
+    uint8_t index;              // Cambio vigente
+    uint8_t active;             // Su perfil, o SCHEDULE_NO_PROFILE
+    bool evaluated;             // index y next_unix valen para clock_generation
+    uint32_t clock_generation;
+    uint32_t next_unix;
+    volatile bool alarm_pending;
+
+    // Pedido de la ISR; lo aplica schedule_poll()
+    volatile schedule_request_t request;
+    uint8_t req_profile;
+    room_profile_t req_values;
+    schedule_entry_t req_entry;
+    uint8_t req_index;
+    uint8_t list_pos;
+
+    uint32_t alarms;
+    uint32_t searches;
+} sch = { .active = SCHEDULE_NO_PROFILE };
+
+// Helpers privados
+
+static bool schedule_valid_thresholds(const int16_t thresholds[ROOM_THRESHOLD_COUNT])
+{
+    return thresholds[0] < thresholds[1] && thresholds[1] < thresholds[2] &&
+           thresholds[0] >= -2000 && thresholds[2] <= 8000;
+}
+
+static bool schedule_valid_profile(const room_profile_t *profile)
+{
+    return profile->fan_mode <= FAN_MODE_PID && profile->fan_min <= profile->fan_max &&
+           profile->fan_max <= 100U && profile->setpoint >= 1000 && profile->setpoint <= 4000 &&
+           schedule_valid_thresholds(profile->thresholds);
+}
+
+static bool schedule_valid_entry(const schedule_entry_t *entry)
+{
+    return entry->days != 0U && entry->days <= SCHEDULE_ALL_DAYS &&
+           entry->profile < SCHEDULE_PROFILES && entry->minute < SCHEDULE_DAY_MIN;
+}
+
+static bool schedule_save(void)
+{
+    bool ok = true;
+    for (uint8_t k = 0; k < SCHEDULE_PROFILE_KEYS; k++) {
+        ok = config_store_set((config_key_t)(CONFIG_KEY_PROFILES_0 + k), &sch.profiles[k * SCHEDULE_PROFILES_PER_KEY],
+                              (uint16_t)(sizeof(room_profile_t) * SCHEDULE_PROFILES_PER_KEY)) && ok;
+    }
+    for (uint8_t k = 0; k < SCHEDULE_ENTRY_KEYS; k++) {
+        ok = config_store_set((config_key_t)(CONFIG_KEY_SCHEDULE_0 + k), &sch.entries[k * SCHEDULE_ENTRIES_PER_KEY],
+                              (uint16_t)(sizeof(schedule_entry_t) * SCHEDULE_ENTRIES_PER_KEY)) && ok;
+    }
+    return ok;
+}
+
+// Tabla ordenada de cambios; solo al editar la programación
+static void schedule_compile(void)
+{
+    sch.count = 0;
+    for (uint8_t e = 0; e < sch.entry_count; e++) {
+        const schedule_entry_t *entry = &sch.entries[e];
+        for (uint8_t day = 0; day < 7U; day++) {
+            if ((entry->days & (1U << day)) == 0U) {
+                continue;
+            }
+            uint16_t minute = (uint16_t)(day * SCHEDULE_DAY_MIN + entry->minute);
+            uint8_t pos = sch.count;
+            while (pos > 0U && sch.table[pos - 1U].minute > minute) {
+                pos--;
+            }
+            if (pos > 0U && sch.table[pos - 1U].minute == minute) {
+                sch.table[pos - 1U].profile = entry->profile;   // Gana la entrada posterior
+                continue;
+            }
+            memmove(&sch.table[pos + 1U], &sch.table[pos], (sch.count - pos) * sizeof(sch.table[0]));
+            sch.table[pos] = (schedule_transition_t){ .minute = minute, .profile = entry->profile };
+            sch.count++;
+        }
+    }
+
+    // Sin cambios que repitan el perfil que ya rige (la semana es circular)
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < sch.count; i++) {
+        if (kept == 0U || sch.table[i].profile != sch.table[kept - 1U].profile) {
+            sch.table[kept++] = sch.table[i];
+        }
+    }
+    if (kept > 1U && sch.table[0].profile == sch.table[kept - 1U].profile) {
+        memmove(&sch.table[0], &sch.table[1], (kept - 1U) * sizeof(sch.table[0]));
+        kept--;
+    }
+    sch.count = kept;
+    sch.evaluated = false;
+}
+
+// Minutos desde `minute` hasta el cambio siguiente al vigente
+static uint32_t schedule_minutes_to_next(uint16_t minute)
+{
+    uint8_t next = (uint8_t)((sch.index + 1U) % sch.count);
+    uint32_t delta = (sch.table[next].minute + SCHEDULE_WEEK_MIN - minute) % SCHEDULE_WEEK_MIN;
+    return (delta == 0U) ? SCHEDULE_WEEK_MIN : delta;   // Un solo cambio: la semana que viene
+}
+
+static void schedule_set_active(uint8_t profile, bool *changed)
+{
+    if (profile != sch.active) {
+        sch.active = profile;
+        *changed = true;
+        TLOG("SCHED: perfil=%d\r\n", (profile == SCHEDULE_NO_PROFILE) ? -1 : (int)profile);
+    }
+}
+
+// Búsqueda del cambio vigente a la hora actual y alarma B al siguiente
+static void schedule_evaluate(bool *changed)
+{
+    sch.searches++;
+    sch.evaluated = true;
+    sch.clock_generation = rtc_clock_generation();
+    sch.alarm_pending = false;
+
+    if (sch.count == 0U) {
+        sch.next_unix = 0;
+        rtc_clock_disarm_alarm_b();
+        schedule_set_active(SCHEDULE_NO_PROFILE, changed);
+        return;
+    }
+
+    // 1970-01-01 fue jueves: el lunes es (días + 3) % 7 == 0
+    uint32_t local = rtc_clock_local_now();
+    uint16_t now_min = (uint16_t)((local / 86400U + 3U) % 7U * SCHEDULE_DAY_MIN + local % 86400U / 60U);
+
+    // Último cambio en o antes de ahora; antes del primero rige el último
+    uint8_t lo = 0, hi = sch.count;
+    while (lo < hi) {
+        uint8_t mid = (uint8_t)((lo + hi) / 2U);
+        if (sch.table[mid].minute <= now_min) {
+            lo = (uint8_t)(mid + 1U);
+        } else {
+            hi = mid;
+        }
+    }
+    sch.index = (lo == 0U) ? (uint8_t)(sch.count - 1U) : (uint8_t)(lo - 1U);
+
+    sch.next_unix = rtc_clock_now() - local % 60U + schedule_minutes_to_next(now_min) * 60U;
+    rtc_clock_arm_alarm_b(sch.next_unix);
+    schedule_set_active(sch.table[sch.index].profile, changed);
+}
+
+// Alarma B: el cambio que se armó pasa a ser el vigente y se arma el siguiente
+static void schedule_advance(bool *changed)
+{
+    sch.alarms++;
+    sch.index = (uint8_t)((sch.index + 1U) % sch.count);
+    sch.next_unix += schedule_minutes_to_next(sch.table[sch.index].minute) * 60U;
+    rtc_clock_arm_alarm_b(sch.next_unix);
+    schedule_set_active(sch.table[sch.index].profile, changed);
+}
+
+static void schedule_print_profile(const char *prefix, uint8_t index)
+{
+    const room_profile_t *p = &sch.profiles[index];
+    if (p->fan_mode == FAN_MODE_PID) {
+        printf("%s %u PID sp=%.1f fan=%u-%u%%\r\n", prefix, (unsigned)index,
+               (float)p->setpoint / 100.0f, (unsigned)p->fan_min, (unsigned)p->fan_max);
+    } else {
+        printf("%s %u AUTO %.1f,%.1f,%.1f fan=%u-%u%%\r\n", prefix, (unsigned)index,
+               (float)p->thresholds[0] / 100.0f, (float)p->thresholds[1] / 100.0f,
+               (float)p->thresholds[2] / 100.0f, (unsigned)p->fan_min, (unsigned)p->fan_max);
+    }
+}
+
+static void schedule_print_entry(const char *prefix, uint8_t index)
+{
+    const schedule_entry_t *entry = &sch.entries[index];
+    char days[8];
+    schedule_format_days(entry->days, days);
+    printf("%s #%u %s %02u:%02u -> %u\r\n", prefix, (unsigned)index, days,
+           (unsigned)(entry->minute / 60U), (unsigned)(entry->minute % 60U), (unsigned)entry->profile);
+}
+
+// Perfiles, entradas y resumen: hasta SCHEDULE_LIST_PER_POLL líneas por vuelta
+static bool schedule_continue_list(void)
+{
+    for (uint32_t printed = 0; printed < SCHEDULE_LIST_PER_POLL; printed++, sch.list_pos++) {
+        if (sch.list_pos < SCHEDULE_PROFILES) {
+            schedule_print_profile("SCHED: perfil", sch.list_pos);
+        } else if (sch.list_pos < SCHEDULE_PROFILES + sch.entry_count) {
+            schedule_print_entry("SCHED:", (uint8_t)(sch.list_pos - SCHEDULE_PROFILES));
+        } else {
+            char next[RTC_CLOCK_TEXT_LEN];
+            rtc_clock_format(sch.next_unix, true, next, sizeof(next));
+            printf("SCHED: entradas=%u cambios=%u activo=%d proximo=%s alarmas=%lu busquedas=%lu\r\n",
+                   (unsigned)sch.entry_count, (unsigned)sch.count,
+                   (sch.active == SCHEDULE_NO_PROFILE) ? -1 : (int)sch.active,
+                   (sch.next_unix != 0U) ? next : "-", (unsigned long)sch.alarms, (unsigned long)sch.searches);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Aplica el pedido de la ISR; true si cambió la programación o el perfil vigente
+static bool schedule_apply_request(bool *changed)
+{
+    room_profile_t *profile = &sch.profiles[sch.req_profile];
+
+    switch (sch.request) {
+        case SCHED_REQ_PID:
+            profile->fan_mode = FAN_MODE_PID;
+            profile->setpoint = sch.req_values.setpoint;
+            break;
+        case SCHED_REQ_LEVELS:
+            profile->fan_mode = FAN_MODE_LEVELS;
+            memcpy(profile->thresholds, sch.req_values.thresholds, sizeof(profile->thresholds));
+            break;
+        case SCHED_REQ_FAN:
+            profile->fan_min = sch.req_values.fan_min;
+            profile->fan_max = sch.req_values.fan_max;
+            break;
+        case SCHED_REQ_ADD:
+            if (sch.entry_count >= SCHEDULE_ENTRIES) {
+                printf("ERR: SCHED lleno (max %u)\r\n", (unsigned)SCHEDULE_ENTRIES);
+                return false;
+            }
+            sch.entries[sch.entry_count++] = sch.req_entry;
+            schedule_compile();
+            schedule_print_entry("OK: SCHED", (uint8_t)(sch.entry_count - 1U));
+            return true;
+        case SCHED_REQ_DELETE:
+            if (sch.req_index >= sch.entry_count) {
+                printf("ERR: SCHED_DEL arg\r\n");
+                return false;
+            }
+            memmove(&sch.entries[sch.req_index], &sch.entries[sch.req_index + 1U],
+                    (sch.entry_count - sch.req_index - 1U) * sizeof(sch.entries[0]));
+            sch.entry_count--;
+            memset(&sch.entries[sch.entry_count], 0, sizeof(sch.entries[0]));
+            schedule_compile();
+            printf("OK: SCHED_DEL %u\r\n", (unsigned)sch.req_index);
+            return true;
+        case SCHED_REQ_CLEAR:
+            memset(sch.entries, 0, sizeof(sch.entries));
+            sch.entry_count = 0;
+            schedule_compile();
+            printf("OK: SCHED_CLEAR\r\n");
+            return true;
+        default:
+            return false;
+    }
+
+    schedule_print_profile("OK: PROF", sch.req_profile);
+    if (sch.req_profile == sch.active) {
+        *changed = true;    // Se vuelve a aplicar con los valores nuevos
+    }
+    return true;
+}
+
+// API pública
+
+/**
+ * @brief Carga perfiles y entradas de config_store y compila la tabla. El
+ * perfil vigente se busca en el primer schedule_poll() con hora.
+ */
+void schedule_init(void)
+{
+    memset(&sch, 0, sizeof(sch));
+    sch.active = SCHEDULE_NO_PROFILE;
+
+    for (uint8_t k = 0; k < SCHEDULE_PROFILE_KEYS; k++) {
+        room_profile_t *profiles = &sch.profiles[k * SCHEDULE_PROFILES_PER_KEY];
+        if (!config_store_get((config_key_t)(CONFIG_KEY_PROFILES_0 + k), profiles,
+                              (uint16_t)(sizeof(room_profile_t) * SCHEDULE_PROFILES_PER_KEY))) {
+            memset(profiles, 0xFF, sizeof(room_profile_t) * SCHEDULE_PROFILES_PER_KEY);
+        }
+    }
+    for (uint8_t i = 0; i < SCHEDULE_PROFILES; i++) {
+        if (!schedule_valid_profile(&sch.profiles[i])) {
+            sch.profiles[i] = SCHEDULE_DEFAULT_PROFILE;
+        }
+    }
+
+    schedule_entry_t stored[SCHEDULE_ENTRIES];
+    for (uint8_t k = 0; k < SCHEDULE_ENTRY_KEYS; k++) {
+        if (!config_store_get((config_key_t)(CONFIG_KEY_SCHEDULE_0 + k), &stored[k * SCHEDULE_ENTRIES_PER_KEY],
+                              (uint16_t)(sizeof(schedule_entry_t) * SCHEDULE_ENTRIES_PER_KEY))) {
+            memset(&stored[k * SCHEDULE_ENTRIES_PER_KEY], 0, sizeof(schedule_entry_t) * SCHEDULE_ENTRIES_PER_KEY);
+        }
+    }
+    for (uint8_t i = 0; i < SCHEDULE_ENTRIES; i++) {
+        if (schedule_valid_entry(&stored[i])) {
+            sch.entries[sch.entry_count++] = stored[i];
+        }
+    }
+    schedule_compile();
+}
+
+/**
+ * @brief Pedidos de edición de un perfil. Desde la ISR; false si hay otro
+ * pedido en curso o los datos no valen.
+ */
+bool schedule_request_pid(uint8_t profile, int16_t setpoint)
+{
+    if (sch.request != SCHED_REQ_NONE || profile >= SCHEDULE_PROFILES || setpoint < 1000 || setpoint > 4000) {
+        return false;
+    }
+    sch.req_profile = profile;
+    sch.req_values.setpoint = setpoint;
+    sch.request = SCHED_REQ_PID;
+    return true;
+}
+
+bool schedule_request_levels(uint8_t profile, const int16_t thresholds[ROOM_THRESHOLD_COUNT])
+{
+    if (sch.request != SCHED_REQ_NONE || profile >= SCHEDULE_PROFILES || !schedule_valid_thresholds(thresholds)) {
+        return false;
+    }
+    sch.req_profile = profile;
+    memcpy(sch.req_values.thresholds, thresholds, sizeof(sch.req_values.thresholds));
+    sch.request = SCHED_REQ_LEVELS;
+    return true;
+}
+
+bool schedule_request_fan(uint8_t profile, uint8_t fan_min, uint8_t fan_max)
+{
+    if (sch.request != SCHED_REQ_NONE || profile >= SCHEDULE_PROFILES || fan_min > fan_max || fan_max > 100U) {
+        return false;
+    }
+    sch.req_profile = profile;
+    sch.req_values.fan_min = fan_min;
+    sch.req_values.fan_max = fan_max;
+    sch.request = SCHED_REQ_FAN;
+    return true;
+}
+
+/**
+ * @brief Pide agregar una entrada (queda última: en el mismo minuto gana
+ * sobre las anteriores). La respuesta sale de schedule_poll().
+ */
+bool schedule_request_add(uint8_t days, uint16_t minute, uint8_t profile)
+{
+    schedule_entry_t entry = { .days = days, .profile = profile, .minute = minute };
+    if (sch.request != SCHED_REQ_NONE || !schedule_valid_entry(&entry)) {
+        return false;
+    }
+    sch.req_entry = entry;
+    sch.request = SCHED_REQ_ADD;
+    return true;
+}
+
+bool schedule_request_delete(uint8_t index)
+{
+    if (sch.request != SCHED_REQ_NONE) {
+        return false;
+    }
+    sch.req_index = index;
+    sch.request = SCHED_REQ_DELETE;
+    return true;
+}
+
+bool schedule_request_clear(void)
+{
+    if (sch.request != SCHED_REQ_NONE) {
+        return false;
+    }
+    sch.request = SCHED_REQ_CLEAR;
+    return true;
+}
+
+bool schedule_request_list(void)
+{
+    if (sch.request != SCHED_REQ_NONE) {
+        return false;
+    }
+    sch.list_pos = 0;
+    sch.request = SCHED_REQ_LIST;
+    return true;
+}
+
+/**
+ * @brief Aplica el pedido pendiente y sigue la programación. Llamar en cada
+ * vuelta del superloop, después de rtc_clock_poll(). true cuando cambió el
+ * perfil vigente: hay que aplicar schedule_active_profile().
+ */
+bool schedule_poll(void)
+{
+    bool changed = false;
+
+    if (sch.request == SCHED_REQ_LIST) {
+        if (schedule_continue_list()) {
+            sch.request = SCHED_REQ_NONE;
+        }
+    } else if (sch.request != SCHED_REQ_NONE) {
+        if (schedule_apply_request(&changed) && !schedule_save()) {
+            printf("ERR: SCHED flash\r\n");
+        }
+        sch.request = SCHED_REQ_NONE;
+    }
+
+    if (!rtc_clock_is_set()) {
+        return changed;     // Sin hora no hay programación: rige la configuración guardada
+    }
+    if (!sch.evaluated || sch.clock_generation != rtc_clock_generation()) {
+        schedule_evaluate(&changed);
+    } else if (sch.alarm_pending) {
+        sch.alarm_pending = false;
+        schedule_advance(&changed);
+    }
+    return changed;
+}
+
+/**
+ * @brief Alarma B (HAL_RTCEx_AlarmBEventCallback): llegó la hora del
+ * próximo cambio.
+ */
+void schedule_on_alarm(void)
+{
+    sch.alarm_pending = true;
+}
+
+// Perfil vigente, NULL si rige la configuración guardada
+const room_profile_t *schedule_active_profile(void)
+{
+    return (sch.active == SCHEDULE_NO_PROFILE) ? NULL : &sch.profiles[sch.active];
+}
+
+void schedule_get_stats(schedule_stats_t *stats)
+{
+    stats->entries = sch.entry_count;
+    stats->transitions = sch.count;
+    stats->active = sch.active;
+    stats->next_unix = sch.next_unix;
+    stats->alarms = sch.alarms;
+    stats->searches = sch.searches;
+}
+
+/**
+ * @brief "LMXJVSD" (lunes a domingo, cualquier subconjunto) o "*" para
+ * todos los días.
+ */
+bool schedule_parse_days(const char *text, uint8_t *days)
+{
+    *days = 0;
+    if (strcmp(text, "*") == 0) {
+        *days = SCHEDULE_ALL_DAYS;
+        return true;
+    }
+    for (; *text != '\0'; text++) {
+        const char *letter = strchr(SCHEDULE_DAY_LETTERS, *text);
+        if (letter == NULL) {
+            return false;
+        }
+        *days |= (uint8_t)(1U << (letter - SCHEDULE_DAY_LETTERS));
+    }
+    return *days != 0U;
+}
+
+void schedule_format_days(uint8_t days, char text[8])
+{
+    uint8_t n = 0;
+    for (uint8_t day = 0; day < 7U; day++) {
+        if (days & (1U << day)) {
+            text[n++] = SCHEDULE_DAY_LETTERS[day];
+        }
+    }
+    text[n] = '\0';
+}
@@ -0,0 +1,96 @@
+#include "sn_link.h"
+#include "alert.h"
+
+// Trama en recepción
+static struct {
+    uint8_t msg[255];
+    uint8_t len;            // Largo del mensaje (primer byte); 0 = esperando el largo
+    uint8_t pos;
+    bool active;
+    uint32_t last_byte;
+} rx;
+
+static void sn_link_dispatch(const uint8_t *msg, uint8_t len)
+{
+    // PUBACK: largo 7 | 0x0D | tópico | msg id | código
+    if (len == 7 && msg[1] == SN_MSG_PUBACK) {
+        alert_on_puback((uint16_t)((msg[2] << 8) | msg[3]),
+                        (uint16_t)((msg[4] << 8) | msg[5]), msg[6]);
+    }
+}
+
+/**
+ * @brief CRC-8, polinomio 0x07, valor inicial 0.
+ */
+uint8_t sn_link_crc8(const uint8_t *data, uint16_t len)
+{
+    uint8_t crc = 0;
+    for (uint16_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Completa la trama: frame[1..] ya tiene el mensaje con su largo;
+ * escribe el STX y el CRC.
+ *
+ * @return Bytes de la trama a transmitir.
+ */
+uint16_t sn_link_seal(uint8_t *frame)
+{
+    uint8_t len = frame[1];
+    frame[0] = SN_LINK_STX;
+    frame[1U + len] = sn_link_crc8(&frame[1], len);
+    return (uint16_t)(len + 2U);
+}
+
+/**
+ * @brief Byte recibido por USART3 (desde la ISR).
+ *
+ * @return true si era parte de una trama; si no, es texto para el parser
+ * de comandos.
+ */
+bool sn_link_rx_byte(uint8_t byte)
+{
+    uint32_t now = HAL_GetTick();
+    if (rx.active && now - rx.last_byte > SN_LINK_RX_TIMEOUT_MS) {
+        rx.active = false;
+    }
+    rx.last_byte = now;
+
+    if (!rx.active) {
+        if (byte != SN_LINK_STX) {
+            return false;
+        }
+        rx.active = true;
+        rx.len = 0;
+        rx.pos = 0;
+        return true;
+    }
+
+    if (rx.len == 0) {
+        if (byte < 2U) {
+            rx.active = false;   // Largo imposible: no era una trama
+        } else {
+            rx.len = byte;
+            rx.msg[rx.pos++] = byte;
+        }
+        return true;
+    }
+
+    if (rx.pos < rx.len) {
+        rx.msg[rx.pos++] = byte;
+        return true;
+    }
+
+    // Byte de CRC
+    rx.active = false;
+    if (sn_link_crc8(rx.msg, rx.len) == byte) {
+        sn_link_dispatch(rx.msg, rx.len);
+    }
+    return true;
+}
@@ -0,0 +1,274 @@
+#include "telemetry.h"
+#include "rtc_clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TELEMETRY_MAGIC       0x544C4D31UL   // "TLM1"
+#define TELEMETRY_REPEAT_MAX  255U
+#define TELEMETRY_DUTY_MAX    250U           // duty / 4 con duty en por mil
+
+// Campos del registro
+#define TLM_REC_DELTA(r)      ((int8_t)((r) & 0xFFU))
+#define TLM_REC_REPEAT(r)     ((r) >> 24)
+#define TLM_REC_SAME_MASK     0x0007FF00UL   // duty + estado
+#define TLM_REC_REPEAT_ONE    (1UL << 24)
+
+typedef struct {
+    uint32_t time_s;        // rtc_clock_timestamp() de la primera muestra
+    int16_t temp_deci;      // Base de los deltas, décimas de °C
+    uint16_t seq;           // Número de bloque, crece en cada bloque abierto
+    uint32_t records[TELEMETRY_BLOCK_RECORDS];
+} telemetry_block_t;
+
+_Static_assert(sizeof(telemetry_block_t) == TELEMETRY_BLOCK_SIZE, "bloque de telemetría");
+
+// Anillo en SRAM2: solo la cabecera se valida al arrancar, el resto se recalcula
+static struct {
+    uint32_t magic;
+    uint16_t head;          // Bloque en escritura
+    uint16_t count;         // Bloques con datos (0..TELEMETRY_BLOCKS)
+    uint16_t seq;           // seq del bloque head
+    telemetry_block_t blocks[TELEMETRY_BLOCKS];
+} ring TELEMETRY_SECTION;
+
+// Estado en RAM normal
+static struct {
+    uint16_t fill;          // Registros usados en el bloque head
+    int32_t temp_deci;      // Temperatura reconstruida tras el último registro
+    bool open;              // Hay un bloque head donde seguir escribiendo
+    bool restored;
+    uint32_t records;
+    uint32_t periods;
+    volatile uint8_t pending_events;
+
+    // Pedidos desde la ISR de UART, los atiende telemetry_poll()
+    volatile bool clear_requested;
+    volatile bool dump_requested;
+
+    // Volcado en curso
+    bool dumping;
+    uint16_t dump_next;
+    uint16_t dump_total;
+    uint16_t dump_first;
+} tlm;
+
+static char dump_line[2 * TELEMETRY_BLOCK_SIZE + 1];
+
+// Helpers privados
+
+static int32_t telemetry_round(float x)
+{
+    return (int32_t)(x >= 0.0f ? x + 0.5f : x - 0.5f);
+}
+
+// Cuenta registros y períodos de un bloque y reconstruye su última temperatura
+static uint16_t telemetry_scan_block(const telemetry_block_t *block, uint32_t *periods, int32_t *temp_deci)
+{
+    uint16_t n = 0;
+    int32_t temp = block->temp_deci;
+
+    while (n < TELEMETRY_BLOCK_RECORDS && block->records[n] != TELEMETRY_RECORD_FREE) {
+        temp += TLM_REC_DELTA(block->records[n]);
+        *periods += 1U + TLM_REC_REPEAT(block->records[n]);
+        n++;
+    }
+    if (temp_deci != NULL) {
+        *temp_deci = temp;
+    }
+    return n;
+}
+
+static void telemetry_reset_ring(void)
+{
+    ring.magic = TELEMETRY_MAGIC;
+    ring.head = 0;
+    ring.count = 0;
+    ring.seq = 0;
+    tlm.open = false;
+    tlm.fill = 0;
+    tlm.records = 0;
+    tlm.periods = 0;
+    tlm.dumping = false;
+}
+
+static void telemetry_open_block(int32_t temp_deci)
+{
+    if (ring.count == 0) {
+        ring.head = 0;
+        ring.count = 1;
+    } else {
+        ring.head = (uint16_t)((ring.head + 1U) % TELEMETRY_BLOCKS);
+        if (ring.count < TELEMETRY_BLOCKS) {
+            ring.count++;
+        } else {
+            // Se pisa el bloque más viejo
+            uint32_t periods = 0;
+            tlm.records -= telemetry_scan_block(&ring.blocks[ring.head], &periods, NULL);
+            tlm.periods -= periods;
+        }
+    }
+
+    telemetry_block_t *block = &ring.blocks[ring.head];
+    memset(block->records, 0xFF, sizeof(block->records));
+    block->time_s = rtc_clock_timestamp();
+    block->temp_deci = (int16_t)temp_deci;
+    block->seq = ++ring.seq;
+
+    tlm.fill = 0;
+    tlm.temp_deci = temp_deci;
+    tlm.open = true;
+}
+
+static void telemetry_dump_block(const telemetry_block_t *block)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    const uint8_t *bytes = (const uint8_t *)block;
+
+    for (uint32_t i = 0; i < TELEMETRY_BLOCK_SIZE; i++) {
+        dump_line[2 * i] = hex[bytes[i] >> 4];
+        dump_line[2 * i + 1] = hex[bytes[i] & 0x0FU];
+    }
+    dump_line[2 * TELEMETRY_BLOCK_SIZE] = '\0';
+    printf("TLMB:%s\r\n", dump_line);
+}
+
+// API pública
+
+/**
+ * @brief Retoma el anillo de SRAM2 si sobrevivió al reset; si no, lo vacía.
+ * Las muestras siguientes van a un bloque nuevo (el tiempo vuelve a 0).
+ */
+void telemetry_init(void)
+{
+    memset(&tlm, 0, sizeof(tlm));
+
+    if (ring.magic == TELEMETRY_MAGIC && ring.head < TELEMETRY_BLOCKS &&
+        ring.count > 0 && ring.count <= TELEMETRY_BLOCKS) {
+        for (uint16_t i = 0; i < ring.count; i++) {
+            tlm.records += telemetry_scan_block(&ring.blocks[(ring.head + TELEMETRY_BLOCKS - i) % TELEMETRY_BLOCKS],
+                                                &tlm.periods, NULL);
+        }
+        tlm.restored = true;
+    } else {
+        telemetry_reset_ring();
+    }
+    tlm.pending_events = TLM_EVT_BOOT;
+}
+
+/**
+ * @brief Agrega la muestra del período. Llamar cada TELEMETRY_PERIOD_MS.
+ *
+ * @param temperature Temperatura en °C.
+ * @param fan_duty Duty aplicado al ventilador, en por mil.
+ * @param state Estado de room_control (0..7).
+ */
+void telemetry_sample(float temperature, uint16_t fan_duty, uint8_t state)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t events = tlm.pending_events;
+    tlm.pending_events = 0;
+    __set_PRIMASK(primask);
+
+    if (!tlm.open || tlm.fill == TELEMETRY_BLOCK_RECORDS) {
+        telemetry_open_block(telemetry_round(temperature * 10.0f));
+    }
+
+    // Histéresis de una décima: el ruido del ADC no rompe las repeticiones
+    int32_t delta = 0;
+    float diff = temperature * 10.0f - (float)tlm.temp_deci;
+    if (diff >= 1.0f || diff <= -1.0f) {
+        delta = telemetry_round(diff);
+        delta = (delta > INT8_MAX) ? INT8_MAX : (delta < INT8_MIN) ? INT8_MIN : delta;
+    }
+
+    uint32_t duty = fan_duty / 4U;
+    if (duty > TELEMETRY_DUTY_MAX) {
+        duty = TELEMETRY_DUTY_MAX;
+    }
+    uint32_t record = (uint32_t)(uint8_t)delta | (duty << 8) |
+                      ((uint32_t)(state & 0x7U) << 16) | ((events & 0x1FU) << 19);
+
+    uint32_t *records = ring.blocks[ring.head].records;
+    if (tlm.fill > 0 && delta == 0 && events == 0 &&
+        (records[tlm.fill - 1] & TLM_REC_SAME_MASK) == (record & TLM_REC_SAME_MASK) &&
+        TLM_REC_REPEAT(records[tlm.fill - 1]) < TELEMETRY_REPEAT_MAX) {
+        records[tlm.fill - 1] += TLM_REC_REPEAT_ONE;
+    } else {
+        records[tlm.fill++] = record;
+        tlm.records++;
+        tlm.temp_deci += delta;
+    }
+    tlm.periods++;
+}
+
+/**
+ * @brief Marca un evento en el período en curso (se puede llamar desde una ISR).
+ */
+void telemetry_event(telemetry_event_t event)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tlm.pending_events |= (uint8_t)event;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Pide un volcado; lo hace telemetry_poll() desde el superloop
+ * (se puede llamar desde la ISR de UART).
+ */
+void telemetry_request_dump(void)
+{
+    tlm.dump_requested = true;
+}
+
+/**
+ * @brief Vacía el anillo en la próxima telemetry_poll() (se puede llamar
+ * desde la ISR de UART).
+ */
+void telemetry_clear(void)
+{
+    tlm.clear_requested = true;
+}
+
+/**
+ * @brief Atiende los pedidos de TLM_CLEAR / TLM_DUMP. Envía un bloque del
+ * volcado por vuelta del superloop (~25 ms a 115200 baudios), del más
+ * viejo al más nuevo.
+ */
+void telemetry_poll(void)
+{
+    if (tlm.clear_requested) {
+        tlm.clear_requested = false;
+        telemetry_reset_ring();
+    }
+    if (tlm.dump_requested) {
+        tlm.dump_requested = false;
+        tlm.dumping = true;
+        tlm.dump_next = 0;
+        tlm.dump_total = ring.count;
+        tlm.dump_first = (uint16_t)((ring.head + TELEMETRY_BLOCKS + 1U - ring.count) % TELEMETRY_BLOCKS);
+        printf("TLM: dump blocks=%u block=%u period_ms=%u\r\n",
+               (unsigned)tlm.dump_total, (unsigned)TELEMETRY_BLOCK_SIZE, (unsigned)TELEMETRY_PERIOD_MS);
+        return;
+    }
+    if (!tlm.dumping) {
+        return;
+    }
+    if (tlm.dump_next < tlm.dump_total) {
+        telemetry_dump_block(&ring.blocks[(tlm.dump_first + tlm.dump_next) % TELEMETRY_BLOCKS]);
+        tlm.dump_next++;
+    } else {
+        printf("TLM: end\r\n");
+        tlm.dumping = false;
+    }
+}
+
+void telemetry_get_stats(telemetry_stats_t *stats)
+{
+    stats->blocks = ring.count;
+    stats->records = tlm.records;
+    stats->periods = tlm.periods;
+    stats->bytes = ring.count * TELEMETRY_BLOCK_SIZE;
+    stats->restored = tlm.restored;
+}
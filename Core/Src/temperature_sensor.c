@@ -1,5 +1,6 @@
 #include "temperature_sensor.h"
 #include "main.h"   // Para hadc1 y HAL
+#include "prof.h"
 
 extern ADC_HandleTypeDef hadc1;
 
@@ -25,6 +26,8 @@ void temperature_sensor_init(void)
  */
 float temperature_sensor_read(void)
 {
+    PROF_SCOPE(PROF_TEMP_READ);
+
     uint32_t adc_value = 0;
 
     if (HAL_ADC_Start(&hadc1) != HAL_OK) {
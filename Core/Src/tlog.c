@@ -0,0 +1,132 @@
+#include "tlog.h"
+#include <string.h>
+
+extern UART_HandleTypeDef huart2;
+
+// Buffer de TX: índices que solo crecen, posición = índice % TLOG_TX_BUFFER_LEN
+static struct {
+    uint8_t buf[TLOG_TX_BUFFER_LEN];
+    uint16_t head;
+    uint16_t tail;
+    bool ready;
+} tx;
+static uint32_t dropped;
+static volatile bool flushing;
+
+static void tlog_put(tlog_frame_t *frame, uint8_t byte)
+{
+    if (frame->len < TLOG_FRAME_MAX) {
+        frame->buf[frame->len] = byte;
+    }
+    frame->len++;   // Si pasa de TLOG_FRAME_MAX, tlog_frame_end() la descarta
+}
+
+static void tlog_put_varint(tlog_frame_t *frame, uint32_t value)
+{
+    while (value >= 0x80U) {
+        tlog_put(frame, (uint8_t)(value | 0x80U));
+        value >>= 7;
+    }
+    tlog_put(frame, (uint8_t)value);
+}
+
+/**
+ * @brief Prepara el buffer de TX. Llamar antes del primer TLOG().
+ */
+void tlog_init(void)
+{
+    tx.head = 0;
+    tx.tail = 0;
+    tx.ready = true;
+    dropped = 0;
+}
+
+void tlog_frame_begin(tlog_frame_t *frame, uint16_t id)
+{
+    frame->len = 0;
+    tlog_put(frame, TLOG_SYNC);
+    tlog_put(frame, 0);   // Largo, se completa al final
+    tlog_put(frame, (uint8_t)id);
+    tlog_put(frame, (uint8_t)(id >> 8));
+}
+
+void tlog_arg_int(tlog_frame_t *frame, int32_t value)
+{
+    // Zigzag: los negativos chicos también ocupan pocos bytes
+    tlog_put_varint(frame, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+void tlog_arg_float(tlog_frame_t *frame, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (uint8_t i = 0; i < 4; i++) {
+        tlog_put(frame, (uint8_t)(bits >> (8 * i)));
+    }
+}
+
+void tlog_arg_str(tlog_frame_t *frame, const char *value)
+{
+    size_t n = strlen(value);
+    if (n > TLOG_STR_MAX) {
+        n = TLOG_STR_MAX;
+    }
+    tlog_put_varint(frame, (uint32_t)n);
+    for (size_t i = 0; i < n; i++) {
+        tlog_put(frame, (uint8_t)value[i]);
+    }
+}
+
+/**
+ * @brief Encola la trama completa o, si no entra en el buffer, la descarta
+ * entera (se puede llamar desde una ISR).
+ */
+void tlog_frame_end(tlog_frame_t *frame)
+{
+    if (frame->len > TLOG_FRAME_MAX) {
+        dropped++;
+        return;
+    }
+    frame->buf[1] = (uint8_t)(frame->len - 2U);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!tx.ready || TLOG_TX_BUFFER_LEN - (uint16_t)(tx.head - tx.tail) < frame->len) {
+        dropped++;
+    } else {
+        // En dos partes si da la vuelta al final del buffer
+        uint16_t pos = tx.head % TLOG_TX_BUFFER_LEN;
+        uint16_t first = (frame->len < TLOG_TX_BUFFER_LEN - pos) ? frame->len : (uint16_t)(TLOG_TX_BUFFER_LEN - pos);
+        memcpy(&tx.buf[pos], frame->buf, first);
+        memcpy(tx.buf, &frame->buf[first], frame->len - first);
+        tx.head += frame->len;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Envía por USART2 lo encolado. Bloquea mientras transmite: se llama
+ * una vez por vuelta del superloop y desde _write() antes de cada printf.
+ */
+void tlog_flush(void)
+{
+    if (flushing || !tx.ready) {
+        return;   // Reentrada desde un printf en una ISR: lo envía el que ya está
+    }
+    flushing = true;
+
+    // Hasta el final del buffer en cada envío; las ISR solo agregan en head
+    uint16_t pending;
+    while ((pending = (uint16_t)(tx.head - tx.tail)) != 0) {
+        uint16_t pos = tx.tail % TLOG_TX_BUFFER_LEN;
+        uint16_t n = (pending < TLOG_TX_BUFFER_LEN - pos) ? pending : (uint16_t)(TLOG_TX_BUFFER_LEN - pos);
+        HAL_UART_Transmit(&huart2, &tx.buf[pos], n, HAL_MAX_DELAY);
+        tx.tail += n;
+    }
+    flushing = false;
+}
+
+uint32_t tlog_get_dropped(void)
+{
+    return dropped;
+}
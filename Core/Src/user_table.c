@@ -0,0 +1,467 @@
+#include "user_table.h"
+#include "config_store.h"   // FLASH_READ_PTR
+#include <stdio.h>
+#include <string.h>
+
+#define USER_TABLE_MAGIC        0x31545555u     // "UUT1"
+#define USER_TABLE_COPIES       2U
+#define USER_TAG_MASK           0xFFFFFFFFFFULL // 40 bits
+#define USER_SLOT_MASK          (USER_TABLE_SLOTS - 1U)
+#define USER_LIST_PER_POLL      16U
+
+_Static_assert((USER_TABLE_SLOTS & USER_SLOT_MASK) == 0U, "USER_TABLE_SLOTS debe ser potencia de 2");
+
+// Ranura de la tabla; role == USER_ROLE_NONE es una ranura libre
+typedef struct {
+    uint8_t tag[5];             // 40 bits bajos del hash de la clave
+    uint8_t role;
+    uint16_t id;
+} user_slot_t;
+
+// Cabecera de una copia, al final de la imagen (se programa última)
+typedef struct {
+    uint32_t magic;
+    uint32_t generation;
+    uint16_t users;
+    uint16_t crc;               // CRC-16/CCITT de generación, usuarios, sal y ranuras
+    uint8_t salt[PIN_HASH_SALT_LEN];
+} user_table_hdr_t;
+
+#define USER_IMAGE_SIZE (sizeof(user_slot_t) * USER_TABLE_SLOTS + sizeof(user_table_hdr_t))
+
+_Static_assert(sizeof(user_slot_t) == 8U, "ranura de 8 bytes");
+_Static_assert(sizeof(user_table_hdr_t) % 8U == 0U, "cabecera en palabras dobles");
+_Static_assert(USER_IMAGE_SIZE <= USER_TABLE_COPY_SIZE, "la tabla no entra en una copia");
+
+typedef enum {
+    USER_REQ_NONE = 0,
+    USER_REQ_ADD,
+    USER_REQ_DELETE,
+    USER_REQ_LIST
+} user_request_t;
+
+static struct {
+    user_slot_t slots[USER_TABLE_SLOTS];
+    uint8_t salt[PIN_HASH_SALT_LEN];
+    bool has_salt;              // Sin sal todavía: tabla nunca creada
+    uint16_t users;
+    uint8_t active;             // Copia vigente en la flash (USER_TABLE_COPIES = ninguna)
+    bool dirty;
+
+    // Pedido de la ISR; lo aplica user_table_poll()
+    volatile user_request_t request;
+    uint16_t req_id;
+    user_role_t req_role;
+    char req_pin[PIN_LENGTH_MAX];
+    uint8_t req_length;
+    uint16_t list_pos;
+
+    user_table_stats_t stats;
+} ut = { .active = USER_TABLE_COPIES };
+
+// Helpers privados
+
+static uint32_t user_copy_addr(uint8_t copy)
+{
+    return USER_TABLE_BASE + (uint32_t)copy * USER_TABLE_COPY_SIZE;
+}
+
+static uint64_t user_slot_tag(const user_slot_t *slot)
+{
+    uint64_t tag = 0;
+    for (int8_t i = 4; i >= 0; i--) {
+        tag = (tag << 8) | slot->tag[i];
+    }
+    return tag;
+}
+
+static uint16_t user_crc16(uint16_t crc, const uint8_t *data, uint32_t len)
+{
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t user_image_crc(const user_table_hdr_t *hdr, const user_slot_t *slots)
+{
+    uint16_t crc = user_crc16(0xFFFFu, (const uint8_t *)&hdr->generation, sizeof(hdr->generation));
+    crc = user_crc16(crc, (const uint8_t *)&hdr->users, sizeof(hdr->users));
+    crc = user_crc16(crc, hdr->salt, sizeof(hdr->salt));
+    return user_crc16(crc, (const uint8_t *)slots, sizeof(user_slot_t) * USER_TABLE_SLOTS);
+}
+
+// Cabecera válida de una copia (false si está borrada o a medio escribir)
+static bool user_copy_header(uint8_t copy, user_table_hdr_t *hdr)
+{
+    uint32_t base = user_copy_addr(copy);
+    memcpy(hdr, FLASH_READ_PTR(base + sizeof(user_slot_t) * USER_TABLE_SLOTS), sizeof(*hdr));
+    if (hdr->magic != USER_TABLE_MAGIC || hdr->users > USER_TABLE_MAX_USERS) {
+        return false;
+    }
+    return hdr->crc == user_image_crc(hdr, (const user_slot_t *)FLASH_READ_PTR(base));
+}
+
+static bool user_flash_erase(uint32_t address)
+{
+    uint32_t offset = address - FLASH_BASE;
+    uint32_t page_error = 0;
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_PAGES,
+        .Banks = (offset < FLASH_BANK_SIZE) ? FLASH_BANK_1 : FLASH_BANK_2,
+        .Page = (offset % FLASH_BANK_SIZE) / FLASH_PAGE_SIZE,
+        .NbPages = 1,
+    };
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    bool ok = (HAL_FLASHEx_Erase(&erase, &page_error) == HAL_OK);
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+static bool user_flash_program(uint32_t address, const uint8_t *data, uint32_t size)
+{
+    bool ok = true;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    for (uint32_t i = 0; ok && i < size; i += 8U) {
+        uint64_t word;
+        memcpy(&word, &data[i], sizeof(word));
+        ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address + i, word) == HAL_OK);
+    }
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+/**
+ * @brief Escribe la tabla en la copia que no está vigente: ranuras primero,
+ * cabecera al final. Bloquea ~110 ms (3 borrados de página y ~500
+ * palabras dobles); solo pasa con USER_ADD / USER_DEL.
+ */
+static bool user_table_save(void)
+{
+    uint8_t target = (ut.active == 0U) ? 1U : 0U;
+    uint32_t base = user_copy_addr(target);
+
+    user_table_hdr_t hdr = {
+        .magic = USER_TABLE_MAGIC,
+        .generation = ut.stats.generation + 1U,
+        .users = ut.users,
+    };
+    memcpy(hdr.salt, ut.salt, sizeof(hdr.salt));
+    hdr.crc = user_image_crc(&hdr, ut.slots);
+
+    bool ok = true;
+    for (uint32_t offset = 0; ok && offset < USER_IMAGE_SIZE; offset += FLASH_PAGE_SIZE) {
+        ok = user_flash_erase(base + offset);
+    }
+    ok = ok && user_flash_program(base, (const uint8_t *)ut.slots, sizeof(ut.slots));
+    ok = ok && user_flash_program(base + sizeof(ut.slots), (const uint8_t *)&hdr, sizeof(hdr));
+
+    if (!ok) {
+        ut.stats.write_errors++;
+        return false;
+    }
+    ut.active = target;
+    ut.stats.generation = hdr.generation;
+    return true;
+}
+
+static void user_table_update_probe(void)
+{
+    uint32_t max_probe = 0;
+    for (uint32_t i = 0; i < USER_TABLE_SLOTS; i++) {
+        if (ut.slots[i].role != USER_ROLE_NONE) {
+            uint32_t home = (uint32_t)user_slot_tag(&ut.slots[i]) & USER_SLOT_MASK;
+            uint32_t probe = ((i - home) & USER_SLOT_MASK) + 1U;
+            max_probe = (probe > max_probe) ? probe : max_probe;
+        }
+    }
+    ut.stats.max_probe = max_probe;
+}
+
+static int32_t user_find_id(uint16_t id)
+{
+    for (uint32_t i = 0; i < USER_TABLE_SLOTS; i++) {
+        if (ut.slots[i].role != USER_ROLE_NONE && ut.slots[i].id == id) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+static int32_t user_find_tag(uint64_t tag)
+{
+    for (uint32_t probe = 0; probe < USER_TABLE_SLOTS; probe++) {
+        uint32_t i = (uint32_t)(tag + probe) & USER_SLOT_MASK;
+        if (ut.slots[i].role == USER_ROLE_NONE) {
+            return -1;
+        }
+        if (user_slot_tag(&ut.slots[i]) == tag) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Para user_table_lookup(): recorre siempre max_probe ranuras desde la
+// inicial, sin cortar en la coincidencia ni en un hueco, y elige la ranura
+// con máscaras en lugar de saltos
+static int32_t user_match_tag(uint64_t tag)
+{
+    uint32_t home = (uint32_t)tag & USER_SLOT_MASK;
+    uint32_t found = 0;
+    uint32_t hit_any = 0;
+
+    for (uint32_t probe = 0; probe < ut.stats.max_probe; probe++) {
+        uint32_t i = (home + probe) & USER_SLOT_MASK;
+        uint64_t diff = user_slot_tag(&ut.slots[i]) ^ tag;
+        uint32_t hit = (uint32_t)(ut.slots[i].role != USER_ROLE_NONE) &
+                       (uint32_t)(((diff | (0U - diff)) >> 63) ^ 1U);
+        uint32_t mask = 0U - hit;
+        found = (found & ~mask) | (i & mask);
+        hit_any |= hit;
+    }
+    return hit_any ? (int32_t)found : -1;
+}
+
+// Baja con corrimiento hacia atrás: las ranuras siguientes del grupo que
+// quedarían inalcanzables ocupan el hueco
+static void user_remove_slot(uint32_t i)
+{
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1U) & USER_SLOT_MASK;
+        if (ut.slots[j].role == USER_ROLE_NONE) {
+            break;
+        }
+        uint32_t home = (uint32_t)user_slot_tag(&ut.slots[j]) & USER_SLOT_MASK;
+        bool stays = (j > i) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!stays) {
+            ut.slots[i] = ut.slots[j];
+            i = j;
+        }
+    }
+    memset(&ut.slots[i], 0, sizeof(ut.slots[i]));
+    ut.users--;
+}
+
+static void user_apply_add(void)
+{
+    if (!ut.has_salt) {
+        pin_hash_new_salt(ut.salt);
+        ut.has_salt = true;
+    }
+    uint64_t tag = pin_hash_digest(ut.salt, ut.req_pin, ut.req_length) & USER_TAG_MASK;
+    memset(ut.req_pin, 0, sizeof(ut.req_pin));
+
+    int32_t same_pin = user_find_tag(tag);
+    int32_t same_id = user_find_id(ut.req_id);
+    if (same_pin >= 0 && same_pin != same_id) {
+        printf("ERR: USER_ADD clave en uso\r\n");
+        return;
+    }
+    if (same_id < 0 && ut.users >= USER_TABLE_MAX_USERS) {
+        printf("ERR: USER_ADD tabla llena (%u)\r\n", (unsigned)USER_TABLE_MAX_USERS);
+        return;
+    }
+
+    // Sección crítica: LOGIN consulta la tabla desde la ISR
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (same_id >= 0) {
+        user_remove_slot((uint32_t)same_id);   // Cambio de clave o de rol
+    }
+    uint32_t i = (uint32_t)tag & USER_SLOT_MASK;
+    while (ut.slots[i].role != USER_ROLE_NONE) {
+        i = (i + 1U) & USER_SLOT_MASK;
+    }
+    for (uint8_t b = 0; b < 5U; b++) {
+        ut.slots[i].tag[b] = (uint8_t)(tag >> (8U * b));
+    }
+    ut.slots[i].id = ut.req_id;
+    ut.slots[i].role = (uint8_t)ut.req_role;
+    ut.users++;
+    __set_PRIMASK(primask);
+
+    ut.dirty = true;
+    printf("OK: USER_ADD id=%u role=%s\r\n", (unsigned)ut.req_id, user_role_name(ut.req_role));
+}
+
+static void user_apply_delete(void)
+{
+    int32_t i = user_find_id(ut.req_id);
+    if (i < 0) {
+        printf("ERR: USER_DEL id=%u no existe\r\n", (unsigned)ut.req_id);
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    user_remove_slot((uint32_t)i);
+    __set_PRIMASK(primask);
+
+    ut.dirty = true;
+    printf("OK: USER_DEL id=%u\r\n", (unsigned)ut.req_id);
+}
+
+// USER_LIST: hasta USER_LIST_PER_POLL líneas por vuelta; true al terminar
+static bool user_continue_list(void)
+{
+    uint32_t printed = 0;
+    for (; ut.list_pos < USER_TABLE_SLOTS && printed < USER_LIST_PER_POLL; ut.list_pos++) {
+        const user_slot_t *slot = &ut.slots[ut.list_pos];
+        if (slot->role != USER_ROLE_NONE) {
+            printf("USER: id=%u role=%s\r\n", (unsigned)slot->id, user_role_name((user_role_t)slot->role));
+            printed++;
+        }
+    }
+    if (ut.list_pos < USER_TABLE_SLOTS) {
+        return false;
+    }
+    printf("USER: %u/%u usuarios gen=%lu max_probe=%lu\r\n", (unsigned)ut.users,
+           (unsigned)USER_TABLE_MAX_USERS, (unsigned long)ut.stats.generation,
+           (unsigned long)ut.stats.max_probe);
+    return true;
+}
+
+// API pública
+
+/**
+ * @brief Carga la copia vigente de la flash (la de generación más nueva
+ * con CRC válido). Sin ninguna, la tabla arranca vacía.
+ */
+void user_table_init(void)
+{
+    memset(&ut, 0, sizeof(ut));
+    ut.active = USER_TABLE_COPIES;
+
+    user_table_hdr_t best = { 0 };
+    for (uint8_t copy = 0; copy < USER_TABLE_COPIES; copy++) {
+        user_table_hdr_t hdr;
+        if (user_copy_header(copy, &hdr) &&
+            (ut.active == USER_TABLE_COPIES || (int32_t)(hdr.generation - best.generation) > 0)) {
+            best = hdr;
+            ut.active = copy;
+        }
+    }
+    if (ut.active == USER_TABLE_COPIES) {
+        return;
+    }
+
+    memcpy(ut.slots, FLASH_READ_PTR(user_copy_addr(ut.active)), sizeof(ut.slots));
+    memcpy(ut.salt, best.salt, sizeof(ut.salt));
+    ut.has_salt = true;
+    ut.users = best.users;
+    ut.stats.generation = best.generation;
+    user_table_update_probe();
+}
+
+/**
+ * @brief Busca al dueño de una clave: siempre un hash y max_probe ranuras,
+ * haya o no coincidencia, para que el tiempo no diga si la clave existe.
+ * Puede llamarse desde la ISR (LOGIN) o desde el superloop (keypad).
+ */
+bool user_table_lookup(const char *pin, uint8_t length, user_t *user)
+{
+    ut.stats.lookups++;
+    bool valid = pin_hash_valid_pin(pin, length);
+
+    int32_t i = user_match_tag(pin_hash_digest(ut.salt, pin, length) & USER_TAG_MASK);
+    if (!valid || i < 0) {
+        return false;
+    }
+    user->id = ut.slots[i].id;
+    user->role = (user_role_t)ut.slots[i].role;
+    return true;
+}
+
+/**
+ * @brief Pide el alta (o el cambio de clave y rol) de un usuario. Desde la
+ * ISR; false si hay otro pedido en curso o los datos no valen.
+ */
+bool user_table_request_add(uint16_t id, user_role_t role, const char *pin, uint8_t length)
+{
+    if (ut.request != USER_REQ_NONE || id == USER_ID_MASTER || id > USER_ID_MAX ||
+        (role != USER_ROLE_USER && role != USER_ROLE_ADMIN) || !pin_hash_valid_pin(pin, length)) {
+        return false;
+    }
+    ut.req_id = id;
+    ut.req_role = role;
+    memcpy(ut.req_pin, pin, length);
+    ut.req_length = length;
+    ut.request = USER_REQ_ADD;
+    return true;
+}
+
+bool user_table_request_delete(uint16_t id)
+{
+    if (ut.request != USER_REQ_NONE || id == USER_ID_MASTER || id > USER_ID_MAX) {
+        return false;
+    }
+    ut.req_id = id;
+    ut.request = USER_REQ_DELETE;
+    return true;
+}
+
+bool user_table_request_list(void)
+{
+    if (ut.request != USER_REQ_NONE) {
+        return false;
+    }
+    ut.list_pos = 0;
+    ut.request = USER_REQ_LIST;
+    return true;
+}
+
+/**
+ * @brief Aplica el pedido pendiente, responde por USART2 y guarda la tabla
+ * si cambió. Llamar en cada vuelta del superloop.
+ */
+void user_table_poll(void)
+{
+    switch (ut.request) {
+        case USER_REQ_ADD:
+            user_apply_add();
+            break;
+        case USER_REQ_DELETE:
+            user_apply_delete();
+            break;
+        case USER_REQ_LIST:
+            if (!user_continue_list()) {
+                return;   // Sigue en la próxima vuelta
+            }
+            break;
+        default:
+            return;
+    }
+
+    if (ut.dirty) {
+        user_table_update_probe();
+        if (!user_table_save()) {
+            printf("ERR: USER flash\r\n");
+        }
+        ut.dirty = false;
+    }
+    ut.request = USER_REQ_NONE;
+}
+
+void user_table_get_stats(user_table_stats_t *stats)
+{
+    *stats = ut.stats;
+    stats->users = ut.users;
+}
+
+const char *user_role_name(user_role_t role)
+{
+    switch (role) {
+        case USER_ROLE_USER:  return "USER";
+        case USER_ROLE_ADMIN: return "ADMIN";
+        default:              return "NONE";
+    }
+}
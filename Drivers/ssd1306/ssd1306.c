@@ -1,4 +1,5 @@
 #include "ssd1306.h"
+#include "prof.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>  // For memcpy
@@ -9,14 +10,142 @@ void ssd1306_Reset(void) {
     /* for I2C - do nothing */
 }
 
+#if defined(SSD1306_TRACE)
+
+static struct {
+    ssd1306_TraceEntry_t ring[SSD1306_TRACE_LEN];
+    uint32_t head;          // Next slot to write
+    uint32_t stored;        // Valid entries in ring (<= SSD1306_TRACE_LEN)
+    uint32_t window_start;  // HAL_GetTick() at last reset
+    ssd1306_TraceStats_t totals;
+} ssd1306_trace;
+
+static void ssd1306_TraceRecord(uint8_t control, size_t size, uint32_t tick,
+                                uint32_t cycles, HAL_StatusTypeDef status) {
+    // address byte + control byte + payload
+    uint16_t bytes = (uint16_t)(size + 2);
+
+    // GET_I2C reads the trace from the UART ISR
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    ssd1306_TraceEntry_t *e = &ssd1306_trace.ring[ssd1306_trace.head];
+    e->tick = tick;
+    e->cycles = cycles;
+    e->bytes = bytes;
+    e->control = control;
+    e->status = (uint8_t)status;
+    e->error = (status == HAL_OK) ? 0 : SSD1306_I2C_PORT.ErrorCode;
+
+    ssd1306_trace.head = (ssd1306_trace.head + 1) % SSD1306_TRACE_LEN;
+    if (ssd1306_trace.stored < SSD1306_TRACE_LEN) {
+        ssd1306_trace.stored++;
+    }
+
+    ssd1306_TraceStats_t *t = &ssd1306_trace.totals;
+    t->transactions++;
+    t->bytes += bytes;
+    t->busy_cycles += cycles;
+    if (cycles > t->max_cycles) {
+        t->max_cycles = cycles;
+    }
+    if (status == HAL_TIMEOUT) {
+        t->timeouts++;
+    } else if (status != HAL_OK) {
+        t->errors++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void ssd1306_TraceGetStats(ssd1306_TraceStats_t *stats) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = ssd1306_trace.totals;
+    uint32_t window_ms = HAL_GetTick() - ssd1306_trace.window_start;
+    __set_PRIMASK(primask);
+
+    stats->window_ms = window_ms;
+    stats->bytes_per_s = 0;
+    stats->busy_permille = 0;
+    if (window_ms > 0) {
+        stats->bytes_per_s = (uint32_t)((uint64_t)stats->bytes * 1000u / window_ms);
+
+        uint64_t window_cycles = (uint64_t)window_ms * (SystemCoreClock / 1000u);
+        if (window_cycles > 0) {
+            uint64_t permille = stats->busy_cycles * 1000u / window_cycles;
+            stats->busy_permille = (permille > 1000u) ? 1000u : (uint32_t)permille;
+        }
+    }
+}
+
+uint32_t ssd1306_TraceRead(ssd1306_TraceEntry_t *out, uint32_t max) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t n = (ssd1306_trace.stored < max) ? ssd1306_trace.stored : max;
+    uint32_t idx = (ssd1306_trace.head + SSD1306_TRACE_LEN - n) % SSD1306_TRACE_LEN;
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = ssd1306_trace.ring[idx];
+        idx = (idx + 1) % SSD1306_TRACE_LEN;
+    }
+
+    __set_PRIMASK(primask);
+    return n;
+}
+
+void ssd1306_TraceReset(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&ssd1306_trace, 0, sizeof(ssd1306_trace));
+    ssd1306_trace.window_start = HAL_GetTick();
+    __set_PRIMASK(primask);
+}
+
+#endif // SSD1306_TRACE
+
+/**
+ * Called after a failed transaction. The application may change the bus
+ * configuration (e.g. lower the I2C speed) and return 1 to retry it.
+ */
+__attribute__((weak)) uint8_t ssd1306_I2C_ErrorCallback(HAL_StatusTypeDef status, uint32_t error) {
+    (void)status;
+    (void)error;
+    return 0;
+}
+
+// Blocking write of one command/data block; traced when SSD1306_TRACE is set
+static void ssd1306_I2C_Write(uint8_t control, const uint8_t* buffer, size_t buff_size) {
+    for (uint8_t attempt = 0; ; attempt++) {
+#if defined(SSD1306_TRACE)
+        uint32_t tick = HAL_GetTick();
+        uint32_t start = PROF_CYCLES();
+#endif
+        HAL_StatusTypeDef status = HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, control, 1,
+                                                     (uint8_t*)buffer, buff_size, SSD1306_I2C_TIMEOUT);
+#if defined(SSD1306_TRACE)
+        ssd1306_TraceRecord(control, buff_size, tick, PROF_CYCLES() - start, status);
+#endif
+        if (status == HAL_OK || attempt >= SSD1306_I2C_RETRIES ||
+            !ssd1306_I2C_ErrorCallback(status, SSD1306_I2C_PORT.ErrorCode)) {
+            return;
+        }
+    }
+}
+
 // Send a byte to the command register
 void ssd1306_WriteCommand(uint8_t byte) {
-    HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x00, 1, &byte, 1, HAL_MAX_DELAY);
+    ssd1306_I2C_Write(0x00, &byte, 1);
+}
+
+// Send several command bytes in one control stream (Co = 0, D/C# = 0)
+void ssd1306_WriteCommands(const uint8_t* cmds, size_t count) {
+    ssd1306_I2C_Write(0x00, cmds, count);
 }
 
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
-    HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x40, 1, buffer, buff_size, HAL_MAX_DELAY);
+    ssd1306_I2C_Write(0x40, buffer, buff_size);
 }
 
 #elif defined(SSD1306_USE_SPI)
@@ -40,6 +169,14 @@ void ssd1306_WriteCommand(uint8_t byte) {
     HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
 }
 
+// Send several command bytes with one chip select
+void ssd1306_WriteCommands(const uint8_t* cmds, size_t count) {
+    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
+    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_RESET); // command
+    HAL_SPI_Transmit(&SSD1306_SPI_PORT, (uint8_t *) cmds, count, HAL_MAX_DELAY);
+    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
+}
+
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
     HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
@@ -69,6 +206,11 @@ SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len) {
     return ret;
 }
 
+/* Read-only view of the screenbuffer (page layout, SSD1306_BUFFER_SIZE bytes) */
+const uint8_t* ssd1306_GetBuffer(void) {
+    return SSD1306_Buffer;
+}
+
 /* Initialize the oled screen */
 void ssd1306_Init(void) {
     // Reset OLED
@@ -176,8 +318,27 @@ void ssd1306_Fill(SSD1306_COLOR color) {
     memset(SSD1306_Buffer, (color == Black) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
 }
 
+/* Write one page (8 rows) of the screenbuffer to the screen */
+void ssd1306_UpdatePage(uint8_t page) {
+    // Horizontal addressing mode ignores the page-mode 0xB0/0x00/0x10
+    // commands: set the column and page window instead, so a single page
+    // lands in place and the pointer is left at the start of the next one
+    const uint8_t page_cmds[] = {
+        0x21, // Set column address
+        SSD1306_X_OFFSET_LOWER + (SSD1306_X_OFFSET_UPPER << 4),
+        SSD1306_X_OFFSET_LOWER + (SSD1306_X_OFFSET_UPPER << 4) + SSD1306_WIDTH - 1,
+        0x22, // Set page address
+        page,
+        SSD1306_HEIGHT/8 - 1,
+    };
+    ssd1306_WriteCommands(page_cmds, sizeof(page_cmds));
+    ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*page],SSD1306_WIDTH);
+}
+
 /* Write the screenbuffer with changed to the screen */
 void ssd1306_UpdateScreen(void) {
+    PROF_BEGIN(PROF_SSD1306_UPDATE);
+
     // Write data to each page of RAM. Number of pages
     // depends on the screen height:
     //
@@ -185,11 +346,10 @@ void ssd1306_UpdateScreen(void) {
     //  * 64px   ==  8 pages
     //  * 128px  ==  16 pages
     for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
-        ssd1306_WriteCommand(0xB0 + i); // Set the current RAM page address.
-        ssd1306_WriteCommand(0x00 + SSD1306_X_OFFSET_LOWER);
-        ssd1306_WriteCommand(0x10 + SSD1306_X_OFFSET_UPPER);
-        ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i],SSD1306_WIDTH);
+        ssd1306_UpdatePage(i);
     }
+
+    PROF_END(PROF_SSD1306_UPDATE);
 }
 
 /*
@@ -572,8 +732,8 @@ void ssd1306_DrawBitmap(uint8_t x, uint8_t y, const unsigned char* bitmap, uint8
 
 void ssd1306_SetContrast(const uint8_t value) {
     const uint8_t kSetContrastControlRegister = 0x81;
-    ssd1306_WriteCommand(kSetContrastControlRegister);
-    ssd1306_WriteCommand(value);
+    const uint8_t cmds[] = { kSetContrastControlRegister, value };
+    ssd1306_WriteCommands(cmds, sizeof(cmds));
 }
 
 void ssd1306_SetDisplayOn(const uint8_t on) {
@@ -122,6 +122,19 @@ extern SPI_HandleTypeDef SSD1306_SPI_PORT;
 #define SSD1306_BUFFER_SIZE   SSD1306_WIDTH * SSD1306_HEIGHT / 8
 #endif
 
+#ifndef SSD1306_I2C_TIMEOUT
+#define SSD1306_I2C_TIMEOUT   HAL_MAX_DELAY
+#endif
+
+// Retries of a failed transaction allowed by ssd1306_I2C_ErrorCallback()
+#ifndef SSD1306_I2C_RETRIES
+#define SSD1306_I2C_RETRIES   2
+#endif
+
+#ifndef SSD1306_TRACE_LEN
+#define SSD1306_TRACE_LEN     32
+#endif
+
 // Enumeration for screen colors
 typedef enum {
     Black = 0x00, // Black color, no pixel
@@ -158,6 +171,7 @@ typedef struct {
 void ssd1306_Init(void);
 void ssd1306_Fill(SSD1306_COLOR color);
 void ssd1306_UpdateScreen(void);
+void ssd1306_UpdatePage(uint8_t page);
 void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color);
 char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color);
 char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color);
@@ -208,8 +222,56 @@ uint8_t ssd1306_GetDisplayOn();
 // Low-level procedures
 void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
+void ssd1306_WriteCommands(const uint8_t* cmds, size_t count);
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size);
 SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len);
+const uint8_t* ssd1306_GetBuffer(void);
+
+#if defined(SSD1306_USE_I2C)
+/**
+ * @brief Hook called after a failed I2C transaction (weak, returns 0).
+ * @param status HAL status of the transaction.
+ * @param error  hi2c.ErrorCode (HAL_I2C_ERROR_*).
+ * @return 1 to retry the transaction, at most SSD1306_I2C_RETRIES times.
+ */
+uint8_t ssd1306_I2C_ErrorCallback(HAL_StatusTypeDef status, uint32_t error);
+#endif
+
+#if defined(SSD1306_USE_I2C) && defined(SSD1306_TRACE)
+/** One I2C transaction issued by ssd1306_WriteCommand/ssd1306_WriteData */
+typedef struct {
+    uint32_t tick;          /**< HAL_GetTick() at start */
+    uint32_t cycles;        /**< Duration in core cycles (DWT) */
+    uint16_t bytes;         /**< Bytes on the bus: address + control + payload */
+    uint8_t  control;       /**< 0x00 command, 0x40 data */
+    uint8_t  status;        /**< HAL_StatusTypeDef */
+    uint32_t error;         /**< hi2c.ErrorCode when status != HAL_OK */
+} ssd1306_TraceEntry_t;
+
+/** Aggregates since the last ssd1306_TraceReset() */
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t errors;        /**< HAL_ERROR / HAL_BUSY (NACK, arbitration...) */
+    uint32_t timeouts;      /**< HAL_TIMEOUT */
+    uint32_t max_cycles;
+    uint64_t busy_cycles;
+    uint32_t window_ms;
+    uint32_t bytes_per_s;
+    uint32_t busy_permille; /**< Share of the window spent inside HAL_I2C_Mem_Write */
+} ssd1306_TraceStats_t;
+
+void ssd1306_TraceGetStats(ssd1306_TraceStats_t *stats);
+
+/**
+ * @brief Copies the most recent transactions, oldest first.
+ * @return Number of entries written to out (<= max).
+ */
+uint32_t ssd1306_TraceRead(ssd1306_TraceEntry_t *out, uint32_t max);
+
+/** Clears the ring and starts a new measurement window */
+void ssd1306_TraceReset(void);
+#endif
 
 _END_STD_C
 
@@ -27,6 +27,14 @@
 #define SSD1306_I2C_PORT        hi2c1
 #define SSD1306_I2C_ADDR        (0x3C << 1)
 
+// I2C timeout per transaction in ms (default HAL_MAX_DELAY waits forever)
+#define SSD1306_I2C_TIMEOUT     100
+
+// Record byte count, duration and status of every I2C transaction
+// in a fixed ring (read with the GET_I2C console command)
+#define SSD1306_TRACE
+#define SSD1306_TRACE_LEN       32
+
 // SPI Configuration
 //#define SSD1306_SPI_PORT        hspi1
 //#define SSD1306_CS_Port         OLED_CS_GPIO_Port
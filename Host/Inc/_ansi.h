@@ -0,0 +1,16 @@
+/**
+ * @file _ansi.h
+ * @brief Sustituto en el host del _ansi.h de newlib (lo incluye ssd1306.h).
+ */
+#ifndef _ANSIDECL_H_
+#define _ANSIDECL_H_
+
+#ifdef __cplusplus
+#define _BEGIN_STD_C extern "C" {
+#define _END_STD_C   }
+#else
+#define _BEGIN_STD_C
+#define _END_STD_C
+#endif
+
+#endif /* _ANSIDECL_H_ */
@@ -0,0 +1,21 @@
+/**
+ * @file board_host.h
+ * @brief Equivalente en host de la inicialización de main.c (MX_*_Init).
+ */
+#ifndef BOARD_HOST_H
+#define BOARD_HOST_H
+
+#include "main.h"
+#include "app.h"   // room_system, keypad, app_init(), app_loop()
+
+extern ADC_HandleTypeDef hadc1;
+extern I2C_HandleTypeDef hi2c1;
+extern TIM_HandleTypeDef htim3;
+extern DMA_HandleTypeDef hdma_tim3_up;
+extern UART_HandleTypeDef huart2;
+extern UART_HandleTypeDef huart3;
+extern RTC_HandleTypeDef hrtc;
+
+void board_host_init(void);
+
+#endif // BOARD_HOST_H
@@ -0,0 +1,102 @@
+/**
+ * @file hal_host.h
+ * @brief Control de la HAL simulada desde benchmarks y simulaciones en host.
+ *
+ * El tiempo es virtual (solo avanza con hal_host_advance() o HAL_Delay()),
+ * las salidas se registran en un log de eventos y las entradas (pines,
+ * bytes de UART, lecturas del ADC, resultado de I2C) se inyectan aquí.
+ */
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include "stm32l4xx_hal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAL_HOST_LOG_LEN          1024   // Eventos guardados (se pisan los más viejos)
+#define HAL_HOST_UART_CAPTURE_LEN 4096   // Bytes de TX capturados por UART
+#define HAL_HOST_UART_COUNT       4      // UARTs distintas que se siguen
+
+typedef enum {
+    HAL_HOST_EV_GPIO_WRITE,
+    HAL_HOST_EV_UART_TX,
+    HAL_HOST_EV_UART_RX,
+    HAL_HOST_EV_I2C_WRITE,
+    HAL_HOST_EV_ADC_READ,
+    HAL_HOST_EV_TIM_START,
+    HAL_HOST_EV_DMA_START
+} hal_host_event_type_t;
+
+// Una llamada a la HAL, con el tick virtual en que ocurrió
+typedef struct {
+    hal_host_event_type_t type;
+    uint32_t tick;
+    const void *instance;   // Registro del periférico (GPIOA, USART2, ...)
+    uint32_t arg;           // Pin, dirección I2C, canal...
+    uint32_t value;         // Estado del pin, cantidad de bytes, lectura...
+} hal_host_event_t;
+
+typedef GPIO_PinState (*hal_host_gpio_read_fn)(GPIO_TypeDef *port, uint16_t pin);
+typedef void (*hal_host_i2c_write_fn)(uint16_t address, uint16_t mem_address,
+                                      const uint8_t *data, uint16_t size);
+typedef void (*hal_host_dma_counter_fn)(DMA_HandleTypeDef *hdma);
+
+// Estado general
+void hal_host_reset(void);
+void hal_host_set_tick(uint32_t tick);
+void hal_host_advance(uint32_t ms);
+void hal_host_set_pclk1(uint32_t hz);
+
+// Log de llamadas
+void hal_host_log_enable(bool enable);
+size_t hal_host_log_count(void);
+const hal_host_event_t *hal_host_log_get(size_t index);
+void hal_host_log_clear(void);
+
+// GPIO
+void hal_host_gpio_set_input(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+void hal_host_gpio_set_read_hook(hal_host_gpio_read_fn hook);
+GPIO_PinState hal_host_gpio_get_output(GPIO_TypeDef *port, uint16_t pin);
+
+// UART
+size_t hal_host_uart_inject(UART_HandleTypeDef *huart, const uint8_t *data, size_t len);
+size_t hal_host_uart_tx_size(const UART_HandleTypeDef *huart);
+const uint8_t *hal_host_uart_tx_data(const UART_HandleTypeDef *huart);
+void hal_host_uart_tx_clear(const UART_HandleTypeDef *huart);
+void hal_host_uart_set_echo(bool echo);
+
+// I2C
+void hal_host_i2c_set_result(HAL_StatusTypeDef result);
+void hal_host_i2c_set_write_hook(hal_host_i2c_write_fn hook);
+uint32_t hal_host_i2c_transactions(void);
+uint32_t hal_host_i2c_bytes(void);
+uint32_t hal_host_i2c_fast_mode_plus(void);
+
+// ADC
+void hal_host_adc_set_value(uint32_t raw);
+void hal_host_adc_set_result(HAL_StatusTypeDef result);
+
+// TIM + DMA: simula eventos de update del timer (y sus peticiones DMA).
+// Con PRIMASK en 1 las interrupciones HT/TC quedan pendientes hasta que se
+// vuelven a habilitar. El hook de CNDTR corre después de cada lectura con
+// __HAL_DMA_GET_COUNTER(): sirve para mover el DMA mientras el firmware
+// todavía usa el valor leído.
+void hal_host_tim_update(TIM_HandleTypeDef *htim, uint32_t events);
+void hal_host_dma_set_counter_hook(hal_host_dma_counter_fn hook);
+
+// RTC: calendario que avanza con el tick virtual, con el error del cristal
+// LSE (ppm, positivo = adelanta) más la calibración fina de RTC_CALR. La
+// alarma A dispara HAL_RTC_AlarmAEventCallback() desde hal_host_advance();
+// la B, HAL_RTCEx_AlarmBEventCallback() cuando coinciden día, hora y segundo.
+void hal_host_rtc_set_error_ppm(double ppm);
+uint64_t hal_host_rtc_epoch_ms(void);
+
+// FLASH: 1 MB borrado en 0xFF que sobrevive a hal_host_reset(). Con un
+// archivo asociado los cambios persisten entre ejecuciones.
+bool hal_host_flash_attach(const char *path);
+void hal_host_flash_erase_all(void);
+uint32_t hal_host_flash_programs(void);
+uint32_t hal_host_flash_page_erases(void);
+
+#endif // HAL_HOST_H
@@ -0,0 +1,23 @@
+/**
+ * @file pbm.h
+ * @brief Exportación de un framebuffer SSD1306 (organizado en páginas de 8
+ * filas, bit 0 arriba) como imagen PBM binaria (P4).
+ *
+ * En la imagen un píxel encendido del OLED se ve negro sobre blanco.
+ */
+#ifndef PBM_H
+#define PBM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+bool pbm_write(const char *path, const uint8_t *pages, uint16_t width, uint16_t height);
+
+// Lee un PBM P4 de las mismas dimensiones al formato de páginas
+bool pbm_read(const char *path, uint8_t *pages, uint16_t width, uint16_t height);
+
+// Cantidad de píxeles distintos entre dos framebuffers
+size_t pbm_diff(const uint8_t *a, const uint8_t *b, uint16_t width, uint16_t height);
+
+#endif // PBM_H
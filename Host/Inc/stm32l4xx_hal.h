@@ -0,0 +1,533 @@
+/**
+ * @file stm32l4xx_hal.h
+ * @brief HAL simulada para compilar los módulos en el host (x86/Linux).
+ *
+ * Reemplaza al stm32l4xx_hal.h real solo en la configuración Host: declara
+ * los tipos, registros y macros que usan Core/Src y Drivers/, con la misma
+ * forma que la HAL de ST. Los periféricos son structs en RAM y las funciones
+ * HAL_* están implementadas en hal_host.c, que registra cada llamada y deja
+ * inyectar entradas (ver hal_host.h).
+ */
+#ifndef STM32L4XX_HAL_H
+#define STM32L4XX_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Tipos comunes ------------------------------------------------------------*/
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    HAL_UNLOCKED = 0x00U,
+    HAL_LOCKED   = 0x01U
+} HAL_LockTypeDef;
+
+#define HAL_MAX_DELAY      0xFFFFFFFFU
+
+#define UNUSED(X) (void)X
+
+/* Registros ----------------------------------------------------------------*/
+
+typedef struct {
+    volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR, ASCR;
+} GPIO_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR;
+    volatile uint32_t CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR, OR1, CCMR3, CCR5, CCR6, OR2, OR3;
+} TIM_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1, CR2, CR3, BRR, GTPR, RTOR, RQR, ISR, ICR, RDR, TDR;
+} USART_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR1, CR2, OAR1, OAR2, TIMINGR, TIMEOUTR, ISR, ICR, PECR, RXDR, TXDR;
+} I2C_TypeDef;
+
+typedef struct {
+    volatile uint32_t ISR, IER, CR, CFGR, CFGR2, SMPR1, SMPR2, DR;
+} ADC_TypeDef;
+
+typedef struct {
+    volatile uint32_t CCR, CNDTR, CPAR, CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct {
+    volatile uint32_t ISR, IFCR;
+} DMA_TypeDef;
+
+typedef struct {
+    volatile uint32_t CR, ICSCR, CFGR, PLLCFGR;
+} RCC_TypeDef;
+
+extern GPIO_TypeDef hal_host_gpioa, hal_host_gpiob, hal_host_gpioc, hal_host_gpioh;
+extern TIM_TypeDef hal_host_tim3;
+extern USART_TypeDef hal_host_usart2, hal_host_usart3;
+extern I2C_TypeDef hal_host_i2c1;
+extern ADC_TypeDef hal_host_adc1;
+extern DMA_TypeDef hal_host_dma1;
+extern DMA_Channel_TypeDef hal_host_dma1_channel3;
+extern RCC_TypeDef hal_host_rcc;
+
+#define GPIOA              (&hal_host_gpioa)
+#define GPIOB              (&hal_host_gpiob)
+#define GPIOC              (&hal_host_gpioc)
+#define GPIOH              (&hal_host_gpioh)
+#define TIM3               (&hal_host_tim3)
+#define USART2             (&hal_host_usart2)
+#define USART3             (&hal_host_usart3)
+#define I2C1               (&hal_host_i2c1)
+#define ADC1               (&hal_host_adc1)
+#define DMA1               (&hal_host_dma1)
+#define DMA1_Channel3      (&hal_host_dma1_channel3)
+#define RCC                (&hal_host_rcc)
+
+#define RCC_CFGR_PPRE1         (0x7UL << 8)
+#define RCC_CFGR_PPRE1_DIV1    (0x0UL << 8)
+#define RCC_CFGR_PPRE1_DIV2    (0x4UL << 8)
+
+#define TIM_EGR_UG             (0x1UL << 0)
+
+/* IRQ numbers usados en main.h */
+typedef enum {
+    EXTI9_5_IRQn        = 23,
+    DMA1_Channel3_IRQn  = 13,
+    USART2_IRQn         = 38,
+    USART3_IRQn         = 39,
+    EXTI15_10_IRQn      = 40
+} IRQn_Type;
+
+/* Núcleo (CMSIS) -----------------------------------------------------------*/
+
+extern uint32_t hal_host_primask;
+
+// Entrega las interrupciones que quedaron pendientes mientras PRIMASK estaba en 1
+void hal_host_irq_unmask(void);
+
+static inline uint32_t __get_PRIMASK(void) { return hal_host_primask; }
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    hal_host_primask = primask;
+    if (primask == 0U) {
+        hal_host_irq_unmask();
+    }
+}
+static inline void __disable_irq(void) { hal_host_primask = 1U; }
+static inline void __enable_irq(void) { __set_PRIMASK(0U); }
+static inline void __NOP(void) { }
+
+extern uint32_t SystemCoreClock;
+
+/* DWT: en el host CYCCNT no avanza; PROF_CYCLES() usa hal_host_cycles() */
+typedef struct {
+    volatile uint32_t CTRL, CYCCNT, CPICNT, EXCCNT, SLEEPCNT, LSUCNT, FOLDCNT, PCSR;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DHCSR, DCRSR, DCRDR, DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type hal_host_dwt;
+extern CoreDebug_Type hal_host_coredebug;
+
+#define DWT                            (&hal_host_dwt)
+#define CoreDebug                      (&hal_host_coredebug)
+#define DWT_CTRL_CYCCNTENA_Msk         (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk     (1UL << 24)
+
+uint32_t hal_host_cycles(void);
+#define PROF_CYCLES() hal_host_cycles()
+
+/* GPIO ---------------------------------------------------------------------*/
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0         ((uint16_t)0x0001)
+#define GPIO_PIN_1         ((uint16_t)0x0002)
+#define GPIO_PIN_2         ((uint16_t)0x0004)
+#define GPIO_PIN_3         ((uint16_t)0x0008)
+#define GPIO_PIN_4         ((uint16_t)0x0010)
+#define GPIO_PIN_5         ((uint16_t)0x0020)
+#define GPIO_PIN_6         ((uint16_t)0x0040)
+#define GPIO_PIN_7         ((uint16_t)0x0080)
+#define GPIO_PIN_8         ((uint16_t)0x0100)
+#define GPIO_PIN_9         ((uint16_t)0x0200)
+#define GPIO_PIN_10        ((uint16_t)0x0400)
+#define GPIO_PIN_11        ((uint16_t)0x0800)
+#define GPIO_PIN_12        ((uint16_t)0x1000)
+#define GPIO_PIN_13        ((uint16_t)0x2000)
+#define GPIO_PIN_14        ((uint16_t)0x4000)
+#define GPIO_PIN_15        ((uint16_t)0x8000)
+#define GPIO_PIN_All       ((uint16_t)0xFFFF)
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+/* DMA ----------------------------------------------------------------------*/
+
+typedef enum {
+    HAL_DMA_STATE_RESET = 0x00U,
+    HAL_DMA_STATE_READY = 0x01U,
+    HAL_DMA_STATE_BUSY  = 0x02U
+} HAL_DMA_StateTypeDef;
+
+typedef struct {
+    uint32_t Request;
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef {
+    DMA_Channel_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+    HAL_LockTypeDef Lock;
+    volatile HAL_DMA_StateTypeDef State;
+    void *Parent;
+    void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+    void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+    void (*XferErrorCallback)(struct __DMA_HandleTypeDef *hdma);
+    void (*XferAbortCallback)(struct __DMA_HandleTypeDef *hdma);
+    volatile uint32_t ErrorCode;
+    DMA_TypeDef *DmaBaseAddress;
+    uint32_t ChannelIndex;
+} DMA_HandleTypeDef;
+
+#define DMA_REQUEST_5              5U
+#define DMA_MEMORY_TO_PERIPH       0x00000010U
+#define DMA_PINC_DISABLE           0x00000000U
+#define DMA_MINC_ENABLE            0x00000080U
+#define DMA_PDATAALIGN_HALFWORD    0x00000100U
+#define DMA_MDATAALIGN_BYTE        0x00000000U
+#define DMA_MDATAALIGN_HALFWORD    0x00000400U
+#define DMA_MDATAALIGN_WORD        0x00000800U
+#define DMA_PRIORITY_LOW           0x00000000U
+
+#define DMA_NORMAL         0x00000000U
+#define DMA_CIRCULAR       0x00000020U
+
+#define DMA_IT_TC          0x00000002U
+#define DMA_IT_HT          0x00000004U
+#define DMA_IT_TE          0x00000008U
+
+#define DMA_FLAG_TC3       0x00000200U
+#define DMA_FLAG_HT3       0x00000400U
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)              hal_host_dma_get_counter(__HANDLE__)
+#define __HAL_DMA_ENABLE_IT(__HANDLE__, __INT__)       \
+    ((__HANDLE__)->Instance->CCR |= (__INT__), hal_host_dma_irq(__HANDLE__))
+#define __HAL_DMA_DISABLE_IT(__HANDLE__, __INT__)      ((__HANDLE__)->Instance->CCR &= ~(__INT__))
+#define __HAL_DMA_GET_TC_FLAG_INDEX(__HANDLE__)        DMA_FLAG_TC3
+#define __HAL_DMA_GET_HT_FLAG_INDEX(__HANDLE__)        DMA_FLAG_HT3
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)     (DMA1->ISR &= ~(__FLAG__))
+
+// En el host las direcciones son de 64 bits: se reciben como uintptr_t
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+// Lectura de CNDTR y entrega de HT/TC pendientes (ver hal_host.h)
+uint32_t hal_host_dma_get_counter(DMA_HandleTypeDef *hdma);
+void hal_host_dma_irq(DMA_HandleTypeDef *hdma);
+
+/* TIM ----------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+#define TIM_DMA_ID_UPDATE      ((uint16_t)0x0000)
+#define TIM_DMA_ID_CC1         ((uint16_t)0x0001)
+#define TIM_DMA_ID_CC2         ((uint16_t)0x0002)
+#define TIM_DMA_ID_CC3         ((uint16_t)0x0003)
+#define TIM_DMA_ID_CC4         ((uint16_t)0x0004)
+#define TIM_DMA_ID_COMMUTATION ((uint16_t)0x0005)
+#define TIM_DMA_ID_TRIGGER     ((uint16_t)0x0006)
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+    DMA_HandleTypeDef *hdma[7];
+    HAL_LockTypeDef Lock;
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1          0x00000000U
+#define TIM_CHANNEL_2          0x00000004U
+#define TIM_CHANNEL_3          0x00000008U
+#define TIM_CHANNEL_4          0x0000000CU
+
+#define TIM_DMA_UPDATE         0x00000100U
+
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+    (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)) = (__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) \
+    (*(&((__HANDLE__)->Instance->CCR1) + ((__CHANNEL__) >> 2U)))
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+    do {                                                     \
+        (__HANDLE__)->Instance->ARR = (__AUTORELOAD__);      \
+        (__HANDLE__)->Init.Period = (__AUTORELOAD__);        \
+    } while (0)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)            ((__HANDLE__)->Instance->ARR)
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PRESC__)  ((__HANDLE__)->Instance->PSC = (__PRESC__))
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__) \
+    do {                                                              \
+        (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__);          \
+        (__DMA_HANDLE__).Parent = (__HANDLE__);                       \
+    } while (0)
+#define __HAL_TIM_ENABLE_DMA(__HANDLE__, __DMA__)       ((__HANDLE__)->Instance->DIER |= (__DMA__))
+#define __HAL_TIM_DISABLE_DMA(__HANDLE__, __DMA__)      ((__HANDLE__)->Instance->DIER &= ~(__DMA__))
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+
+/* UART ---------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+#define HAL_UART_STATE_READY    0x00000020U
+#define HAL_UART_STATE_BUSY_TX  0x00000021U
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    const uint8_t *pTxBuffPtr;
+    uint16_t TxXferSize;
+    volatile uint16_t TxXferCount;
+    uint8_t *pRxBuffPtr;
+    uint16_t RxXferSize;
+    volatile uint16_t RxXferCount;
+    HAL_LockTypeDef Lock;
+    volatile uint32_t gState;
+    volatile uint32_t RxState;
+    volatile uint32_t ErrorCode;
+} UART_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+
+/* I2C ----------------------------------------------------------------------*/
+
+typedef struct {
+    uint32_t Timing;
+    uint32_t OwnAddress1;
+    uint32_t AddressingMode;
+    uint32_t DualAddressMode;
+    uint32_t OwnAddress2;
+    uint32_t OwnAddress2Masks;
+    uint32_t GeneralCallMode;
+    uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct __I2C_HandleTypeDef {
+    I2C_TypeDef *Instance;
+    I2C_InitTypeDef Init;
+    HAL_LockTypeDef Lock;
+    volatile uint32_t State;
+    volatile uint32_t ErrorCode;
+} I2C_HandleTypeDef;
+
+#define HAL_I2C_ERROR_NONE     0x00000000U
+#define HAL_I2C_ERROR_BERR     0x00000001U
+#define HAL_I2C_ERROR_ARLO     0x00000002U
+#define HAL_I2C_ERROR_AF       0x00000004U
+#define HAL_I2C_ERROR_TIMEOUT  0x00000020U
+
+#define I2C_MEMADD_SIZE_8BIT   0x00000001U
+#define I2C_FASTMODEPLUS_I2C1  0x00010000U
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+void HAL_I2CEx_EnableFastModePlus(uint32_t ConfigFastModePlus);
+void HAL_I2CEx_DisableFastModePlus(uint32_t ConfigFastModePlus);
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                          uint16_t Size, uint32_t Timeout);
+
+/* ADC ----------------------------------------------------------------------*/
+
+typedef struct {
+    ADC_TypeDef *Instance;
+    volatile uint32_t State;
+    volatile uint32_t ErrorCode;
+} ADC_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+
+/* FLASH --------------------------------------------------------------------*/
+
+#define FLASH_BASE                     0x08000000UL
+#define FLASH_SIZE                     0x00100000UL   // STM32L476RG: 1 MB, 2 bancos
+#define FLASH_BANK_SIZE                (FLASH_SIZE >> 1)
+#define FLASH_PAGE_SIZE                0x800U
+#define FLASH_BANK_1                   0x01U
+#define FLASH_BANK_2                   0x02U
+#define FLASH_TYPEERASE_PAGES          0x00U
+#define FLASH_TYPEPROGRAM_DOUBLEWORD   0x00U
+#define FLASH_FLAG_ALL_ERRORS          0x0000C3FAU
+
+typedef struct {
+    uint32_t TypeErase;
+    uint32_t Banks;
+    uint32_t Page;
+    uint32_t NbPages;
+} FLASH_EraseInitTypeDef;
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError);
+
+#define __HAL_FLASH_CLEAR_FLAG(flags)  ((void)(flags))
+
+/* La flash no está mapeada en el host: las lecturas van a la flash emulada */
+const uint8_t *hal_host_flash_ptr(uint32_t address);
+#define FLASH_READ_PTR(address) hal_host_flash_ptr(address)
+
+/* tlog: la sección no empieza en 0; el id es el desplazamiento desde su inicio */
+extern const char __start_tlog[];
+#define TLOG_ID(fmt) ((uint16_t)((fmt) - __start_tlog))
+
+/* RTC ----------------------------------------------------------------------*/
+
+typedef struct {
+    volatile uint32_t TR, DR, CR, ISR, PRER, WUTR, RESERVED, ALRMAR, ALRMBR, WPR, SSR, SHIFTR;
+    volatile uint32_t TSTR, TSDR, TSSSR, CALR, TAMPCR, ALRMASSR, ALRMBSSR, OR;
+    volatile uint32_t BKPxR[32];
+} RTC_TypeDef;
+
+extern RTC_TypeDef hal_host_rtc;
+#define RTC                (&hal_host_rtc)
+
+typedef struct {
+    uint32_t HourFormat;
+    uint32_t AsynchPrediv;
+    uint32_t SynchPrediv;
+    uint32_t OutPut;
+    uint32_t OutPutRemap;
+    uint32_t OutPutPolarity;
+    uint32_t OutPutType;
+} RTC_InitTypeDef;
+
+typedef struct {
+    uint8_t Hours;
+    uint8_t Minutes;
+    uint8_t Seconds;
+    uint8_t TimeFormat;
+    uint32_t SubSeconds;          // Cuenta regresiva de SynchPrediv a 0
+    uint32_t SecondFraction;      // SynchPrediv
+    uint32_t DayLightSaving;
+    uint32_t StoreOperation;
+} RTC_TimeTypeDef;
+
+typedef struct {
+    uint8_t WeekDay;
+    uint8_t Month;
+    uint8_t Date;
+    uint8_t Year;                 // Desde 2000
+} RTC_DateTypeDef;
+
+typedef struct {
+    RTC_TimeTypeDef AlarmTime;
+    uint32_t AlarmMask;
+    uint32_t AlarmSubSecondMask;
+    uint32_t AlarmDateWeekDaySel;
+    uint8_t AlarmDateWeekDay;
+    uint32_t Alarm;
+} RTC_AlarmTypeDef;
+
+typedef struct __RTC_HandleTypeDef {
+    RTC_TypeDef *Instance;
+    RTC_InitTypeDef Init;
+    HAL_LockTypeDef Lock;
+    volatile uint32_t State;
+} RTC_HandleTypeDef;
+
+#define RTC_FORMAT_BIN                   0x00000000U
+#define RTC_HOURFORMAT_24                0x00000000U
+#define RTC_DAYLIGHTSAVING_NONE          0x00000000U
+#define RTC_STOREOPERATION_RESET         0x00000000U
+#define RTC_ALARMMASK_NONE               0x00000000U
+#define RTC_ALARMMASK_ALL                0x80808080U
+#define RTC_ALARMSUBSECONDMASK_ALL       0x00000000U
+#define RTC_ALARMDATEWEEKDAYSEL_DATE     0x00000000U
+#define RTC_ALARM_A                      0x00000100U
+#define RTC_ALARM_B                      0x00000200U
+#define RTC_SMOOTHCALIB_PERIOD_32SEC     0x00000000U
+#define RTC_SMOOTHCALIB_PLUSPULSES_SET   0x00008000U
+#define RTC_SMOOTHCALIB_PLUSPULSES_RESET 0x00000000U
+#define RTC_SHIFTADD1S_SET               0x80000000U
+#define RTC_SHIFTADD1S_RESET             0x00000000U
+#define RTC_BKP_DR0                      0x00000000U
+#define RTC_BKP_DR1                      0x00000001U
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm);
+HAL_StatusTypeDef HAL_RTCEx_SetSmoothCalib(RTC_HandleTypeDef *hrtc, uint32_t SmoothCalibPeriod,
+                                           uint32_t SmoothCalibPlusPulses, uint32_t SmoothCalibMinusPulsesValue);
+HAL_StatusTypeDef HAL_RTCEx_SetSynchroShift(RTC_HandleTypeDef *hrtc, uint32_t ShiftAdd1S, uint32_t ShiftSubFS);
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister, uint32_t Data);
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister);
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc);
+void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc);
+
+/* RCC / sistema ------------------------------------------------------------*/
+
+uint32_t HAL_RCC_GetSysClockFreq(void);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetUIDw0(void);
+uint32_t HAL_GetUIDw1(void);
+uint32_t HAL_GetUIDw2(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32L4XX_HAL_H */
@@ -0,0 +1,29 @@
+/**
+ * @file tlog_host.h
+ * @brief Decodificador de tramas TLOG() en el host.
+ *
+ * En el build de host los formatos están en la sección tlog del mismo
+ * ejecutable (__start_tlog / __stop_tlog), así que las tramas que salen por
+ * la USART2 simulada se convierten a texto sin leer el ELF.
+ */
+#ifndef TLOG_HOST_H
+#define TLOG_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Estado para separar tramas del texto de printf en un stream
+typedef struct {
+    uint8_t frame[260];
+    size_t len;
+    size_t expected;     // Largo total de la trama en curso (0 = leyendo texto)
+} tlog_host_stream_t;
+
+// Texto de una trama completa; -1 si no es válida
+int tlog_host_render(const uint8_t *frame, size_t len, char *out, size_t out_size);
+
+// Un byte del stream. Devuelve cuántos caracteres de texto quedan en out:
+// 1 para un byte de texto, 0 dentro de una trama y el texto entero al cerrarla
+size_t tlog_host_feed(tlog_host_stream_t *stream, uint8_t byte, char *out, size_t out_size);
+
+#endif // TLOG_HOST_H
@@ -0,0 +1,102 @@
+/**
+ * @file board_host.c
+ * @brief Handles de periféricos que en el target define main.c.
+ *
+ * La configuración replica la de CubeMX (TIM3 a 25 kHz con DMA de update en
+ * DMA1_Channel3, USART2 de debug, USART3 del ESP-01, I2C1 del display, RTC
+ * con LSE) para que los módulos corran en el host sin cambios.
+ */
+#define _GNU_SOURCE
+#include "board_host.h"
+#include "hal_host.h"
+#include "tlog.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+
+ADC_HandleTypeDef hadc1;
+I2C_HandleTypeDef hi2c1;
+TIM_HandleTypeDef htim3;
+DMA_HandleTypeDef hdma_tim3_up;
+UART_HandleTypeDef huart2;
+UART_HandleTypeDef huart3;
+RTC_HandleTypeDef hrtc;
+
+// Equivalente de _write() en main.c: printf() sale por USART2
+static ssize_t board_host_stdout_write(void *cookie, const char *buf, size_t size)
+{
+    (void)cookie;
+    size_t sent = 0;
+    tlog_flush();
+    while (sent < size) {
+        uint16_t chunk = (size - sent > 0xFFFF) ? 0xFFFF : (uint16_t)(size - sent);
+        HAL_UART_Transmit(&huart2, (const uint8_t *)&buf[sent], chunk, HAL_MAX_DELAY);
+        sent += chunk;
+    }
+    return (ssize_t)size;
+}
+
+static void board_host_retarget_stdout(void)
+{
+    static FILE *uart_stdout;
+
+    if (uart_stdout == NULL) {
+        cookie_io_functions_t io = { .write = board_host_stdout_write };
+        uart_stdout = fopencookie(NULL, "w", io);
+        if (uart_stdout == NULL) {
+            return;
+        }
+        setvbuf(uart_stdout, NULL, _IONBF, 0);
+        stdout = uart_stdout;
+    }
+}
+
+/**
+ * @brief Reinicia la HAL simulada y deja los periféricos como tras MX_*_Init().
+ */
+void board_host_init(void)
+{
+    hal_host_reset();
+
+    hadc1 = (ADC_HandleTypeDef){ .Instance = ADC1 };
+    hi2c1 = (I2C_HandleTypeDef){ .Instance = I2C1 };
+    hi2c1.Init.Timing = 0x10909CEC;
+    huart2 = (UART_HandleTypeDef){ .Instance = USART2 };
+    huart2.Init.BaudRate = 115200;
+    huart2.gState = HAL_UART_STATE_READY;
+    huart3 = (UART_HandleTypeDef){ .Instance = USART3 };
+    huart3.Init.BaudRate = 115200;
+    huart3.gState = HAL_UART_STATE_READY;
+
+    htim3 = (TIM_HandleTypeDef){ .Instance = TIM3 };
+    htim3.Init.Prescaler = 0;
+    htim3.Init.Period = 3200 - 1;
+    TIM3->PSC = htim3.Init.Prescaler;
+    TIM3->ARR = htim3.Init.Period;
+
+    // HAL_TIM_PWM_MspInit(): DMA circular memoria -> TIM3->CCR1 en cada update
+    hdma_tim3_up = (DMA_HandleTypeDef){ .Instance = DMA1_Channel3 };
+    hdma_tim3_up.Init.Request = DMA_REQUEST_5;
+    hdma_tim3_up.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_tim3_up.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_tim3_up.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_tim3_up.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_tim3_up.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_tim3_up.Init.Mode = DMA_CIRCULAR;
+    hdma_tim3_up.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_tim3_up.State = HAL_DMA_STATE_READY;
+    __HAL_LINKDMA(&htim3, hdma[TIM_DMA_ID_UPDATE], hdma_tim3_up);
+
+    // MX_RTC_Init(): LSE de 32768 Hz / 128 / 256 = 1 Hz
+    hrtc = (RTC_HandleTypeDef){ .Instance = RTC };
+    hrtc.Init.HourFormat = RTC_HOURFORMAT_24;
+    hrtc.Init.AsynchPrediv = 127;
+    hrtc.Init.SynchPrediv = 255;
+
+    board_host_retarget_stdout();
+}
+
+void Error_Handler(void)
+{
+    abort();
+}
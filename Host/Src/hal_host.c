@@ -0,0 +1,1106 @@
+/**
+ * @file hal_host.c
+ * @brief Implementación en host de las funciones HAL que usa el firmware.
+ *
+ * Cada llamada queda registrada en un log circular con el tick virtual en
+ * que ocurrió. Las entradas se inyectan con las funciones hal_host_*.
+ */
+#include "hal_host.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <time.h>
+
+// Registros de los periféricos simulados
+GPIO_TypeDef hal_host_gpioa, hal_host_gpiob, hal_host_gpioc, hal_host_gpioh;
+TIM_TypeDef hal_host_tim3;
+USART_TypeDef hal_host_usart2, hal_host_usart3;
+I2C_TypeDef hal_host_i2c1;
+ADC_TypeDef hal_host_adc1;
+DMA_TypeDef hal_host_dma1;
+DMA_Channel_TypeDef hal_host_dma1_channel3;
+RCC_TypeDef hal_host_rcc;
+RTC_TypeDef hal_host_rtc;
+DWT_Type hal_host_dwt;
+CoreDebug_Type hal_host_coredebug;
+uint32_t hal_host_primask;
+uint32_t SystemCoreClock = 1000000000U;   // Frecuencia de hal_host_cycles()
+
+#define HAL_HOST_DEFAULT_PCLK1  80000000U   // SYSCLK de main.c (HSI + PLL)
+#define HAL_HOST_DMA_CHANNELS   4
+
+// Tiempos típicos de la hoja de datos del STM32L476 (tprog 64 bits, tERASE)
+#define HAL_HOST_FLASH_PROGRAM_US  82U
+#define HAL_HOST_FLASH_ERASE_US    22000U
+
+// Calendario del RTC: 2000-01-01 (año 0 del RTC) en tiempo Unix
+#define HAL_HOST_RTC_EPOCH_DAYS    10957
+#define HAL_HOST_RTC_NS_PER_S      1000000000LL
+
+// Captura de TX y recepción pendiente de cada UART
+typedef struct {
+    const USART_TypeDef *instance;
+    uint8_t tx[HAL_HOST_UART_CAPTURE_LEN];
+    size_t tx_len;
+    UART_HandleTypeDef *tx_it;   // Transmisión de HAL_UART_Transmit_IT() en curso
+    uint32_t tx_it_done;         // Tick en que termina
+} hal_host_uart_t;
+
+// Transferencia DMA en curso (las direcciones reales no caben en CMAR/CPAR)
+typedef struct {
+    const DMA_Channel_TypeDef *instance;
+    DMA_HandleTypeDef *hdma;      // Para entregar HT/TC al habilitar interrupciones
+    const uint8_t *src;
+    volatile uint32_t *dst;
+    uint32_t length;
+} hal_host_dma_t;
+
+static struct {
+    uint32_t tick;
+    uint32_t pclk1;
+
+    hal_host_event_t log[HAL_HOST_LOG_LEN];
+    size_t log_next;
+    size_t log_count;
+    bool log_enabled;
+
+    hal_host_gpio_read_fn gpio_read_hook;
+
+    hal_host_uart_t uart[HAL_HOST_UART_COUNT];
+    bool uart_echo;
+
+    HAL_StatusTypeDef i2c_result;
+    hal_host_i2c_write_fn i2c_write_hook;
+    uint32_t i2c_transactions;
+    uint32_t i2c_bytes;
+    uint32_t i2c_fmp;       // Bits I2C_FASTMODEPLUS_* habilitados
+
+    uint32_t adc_value;
+    HAL_StatusTypeDef adc_result;
+
+    hal_host_dma_t dma[HAL_HOST_DMA_CHANNELS];
+    hal_host_dma_counter_fn dma_counter_hook;
+
+    // RTC: nanosegundos desde 2000-01-01 y resto de la última conversión
+    int64_t rtc_ns;
+    double rtc_rest_ns;
+    uint32_t rtc_tick;
+    double rtc_error_ppm;
+    int32_t rtc_cal_pulses;         // CALP * 512 - CALM, cada 2^20 ciclos
+    RTC_HandleTypeDef *rtc_alarm;   // Alarma A habilitada (máscara total: cada segundo)
+    int64_t rtc_alarm_second;
+    RTC_HandleTypeDef *rtc_alarm_b; // Alarma B habilitada (sin máscaras)
+    RTC_AlarmTypeDef rtc_alarm_b_at;
+} host;
+
+static void hal_host_rtc_update(void);
+static bool hal_host_rtc_alarm_b_match(void);
+
+static void hal_host_record(hal_host_event_type_t type, const void *instance,
+                            uint32_t arg, uint32_t value)
+{
+    if (!host.log_enabled) {
+        return;
+    }
+
+    hal_host_event_t *event = &host.log[host.log_next];
+    event->type = type;
+    event->tick = host.tick;
+    event->instance = instance;
+    event->arg = arg;
+    event->value = value;
+
+    host.log_next = (host.log_next + 1) % HAL_HOST_LOG_LEN;
+    if (host.log_count < HAL_HOST_LOG_LEN) {
+        host.log_count++;
+    }
+}
+
+static hal_host_uart_t *hal_host_uart_find(const USART_TypeDef *instance)
+{
+    for (size_t i = 0; i < HAL_HOST_UART_COUNT; i++) {
+        if (host.uart[i].instance == instance) {
+            return &host.uart[i];
+        }
+    }
+    for (size_t i = 0; i < HAL_HOST_UART_COUNT; i++) {
+        if (host.uart[i].instance == NULL) {
+            host.uart[i].instance = instance;
+            return &host.uart[i];
+        }
+    }
+    return NULL;
+}
+
+static hal_host_dma_t *hal_host_dma_find(const DMA_Channel_TypeDef *instance)
+{
+    for (size_t i = 0; i < HAL_HOST_DMA_CHANNELS; i++) {
+        if (host.dma[i].instance == instance) {
+            return &host.dma[i];
+        }
+    }
+    for (size_t i = 0; i < HAL_HOST_DMA_CHANNELS; i++) {
+        if (host.dma[i].instance == NULL) {
+            host.dma[i].instance = instance;
+            return &host.dma[i];
+        }
+    }
+    return NULL;
+}
+
+/* Estado general -----------------------------------------------------------*/
+
+/**
+ * @brief Deja periféricos, log e inyecciones como después de un reset.
+ */
+void hal_host_reset(void)
+{
+    memset(&host, 0, sizeof(host));
+    host.pclk1 = HAL_HOST_DEFAULT_PCLK1;
+    host.log_enabled = true;
+    host.i2c_result = HAL_OK;
+    host.adc_result = HAL_OK;
+
+    memset(&hal_host_gpioa, 0, sizeof(GPIO_TypeDef));
+    memset(&hal_host_gpiob, 0, sizeof(GPIO_TypeDef));
+    memset(&hal_host_gpioc, 0, sizeof(GPIO_TypeDef));
+    memset(&hal_host_gpioh, 0, sizeof(GPIO_TypeDef));
+    memset(&hal_host_tim3, 0, sizeof(TIM_TypeDef));
+    memset(&hal_host_dma1, 0, sizeof(DMA_TypeDef));
+    memset(&hal_host_dma1_channel3, 0, sizeof(DMA_Channel_TypeDef));
+    memset(&hal_host_rcc, 0, sizeof(RCC_TypeDef));
+    memset(&hal_host_rtc, 0, sizeof(RTC_TypeDef));
+    hal_host_primask = 0;
+
+    // Entradas en pull-up: columnas del keypad y botón sin presionar
+    hal_host_gpioa.IDR = 0xFFFF;
+    hal_host_gpiob.IDR = 0xFFFF;
+    hal_host_gpioc.IDR = 0xFFFF;
+}
+
+void hal_host_set_tick(uint32_t tick)
+{
+    host.tick = tick;
+}
+
+void hal_host_advance(uint32_t ms)
+{
+    host.tick += ms;
+
+    // Alarma A: una interrupción por cada cambio de segundo del calendario
+    hal_host_rtc_update();
+    int64_t second = host.rtc_ns / HAL_HOST_RTC_NS_PER_S;
+    if (second != host.rtc_alarm_second) {
+        host.rtc_alarm_second = second;
+        if (host.rtc_alarm != NULL) {
+            HAL_RTC_AlarmAEventCallback(host.rtc_alarm);
+        }
+        if (host.rtc_alarm_b != NULL && hal_host_rtc_alarm_b_match()) {
+            HAL_RTCEx_AlarmBEventCallback(host.rtc_alarm_b);
+        }
+    }
+
+    // Fin de las transmisiones por interrupción
+    for (size_t i = 0; i < HAL_HOST_UART_COUNT; i++) {
+        hal_host_uart_t *uart = &host.uart[i];
+        if (uart->tx_it != NULL && (int32_t)(host.tick - uart->tx_it_done) >= 0) {
+            UART_HandleTypeDef *huart = uart->tx_it;
+            uart->tx_it = NULL;
+            huart->gState = HAL_UART_STATE_READY;
+            HAL_UART_TxCpltCallback(huart);
+        }
+    }
+}
+
+void hal_host_set_pclk1(uint32_t hz)
+{
+    host.pclk1 = hz;
+}
+
+/* Log ----------------------------------------------------------------------*/
+
+void hal_host_log_enable(bool enable)
+{
+    host.log_enabled = enable;
+}
+
+size_t hal_host_log_count(void)
+{
+    return host.log_count;
+}
+
+/**
+ * @brief Evento número index, contando desde el más viejo que sigue en el log.
+ */
+const hal_host_event_t *hal_host_log_get(size_t index)
+{
+    if (index >= host.log_count) {
+        return NULL;
+    }
+    size_t first = (host.log_next + HAL_HOST_LOG_LEN - host.log_count) % HAL_HOST_LOG_LEN;
+    return &host.log[(first + index) % HAL_HOST_LOG_LEN];
+}
+
+void hal_host_log_clear(void)
+{
+    host.log_next = 0;
+    host.log_count = 0;
+}
+
+/* GPIO ---------------------------------------------------------------------*/
+
+void hal_host_gpio_set_input(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET) {
+        port->IDR |= pin;
+    } else {
+        port->IDR &= ~(uint32_t)pin;
+    }
+}
+
+/**
+ * @brief Reemplaza la lectura de IDR (p. ej. para simular la matriz del keypad,
+ * donde la columna depende de la fila que se está excitando).
+ */
+void hal_host_gpio_set_read_hook(hal_host_gpio_read_fn hook)
+{
+    host.gpio_read_hook = hook;
+}
+
+GPIO_PinState hal_host_gpio_get_output(GPIO_TypeDef *port, uint16_t pin)
+{
+    return (port->ODR & pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+    hal_host_record(HAL_HOST_EV_GPIO_WRITE, GPIOx, GPIO_Pin, PinState);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    if (host.gpio_read_hook != NULL) {
+        return host.gpio_read_hook(GPIOx, GPIO_Pin);
+    }
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    GPIOx->ODR ^= GPIO_Pin;
+    hal_host_record(HAL_HOST_EV_GPIO_WRITE, GPIOx, GPIO_Pin,
+                    (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+/* UART ---------------------------------------------------------------------*/
+
+/**
+ * @brief Entrega bytes como si llegaran por la línea RX.
+ *
+ * Cada byte completa la recepción armada con HAL_UART_Receive_IT() y se
+ * llama a HAL_UART_RxCpltCallback(). Si nadie re-arma la recepción los
+ * bytes restantes se pierden, igual que un overrun en el hardware.
+ *
+ * @return Bytes efectivamente recibidos.
+ */
+size_t hal_host_uart_inject(UART_HandleTypeDef *huart, const uint8_t *data, size_t len)
+{
+    size_t received = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        if (huart->pRxBuffPtr == NULL || huart->RxXferCount == 0) {
+            break;
+        }
+
+        *huart->pRxBuffPtr++ = data[i];
+        huart->RxXferCount--;
+        received++;
+
+        if (huart->RxXferCount == 0) {
+            huart->pRxBuffPtr = NULL;
+            hal_host_record(HAL_HOST_EV_UART_RX, huart->Instance, 0, huart->RxXferSize);
+            HAL_UART_RxCpltCallback(huart);
+        }
+    }
+    return received;
+}
+
+size_t hal_host_uart_tx_size(const UART_HandleTypeDef *huart)
+{
+    hal_host_uart_t *uart = hal_host_uart_find(huart->Instance);
+    return (uart != NULL) ? uart->tx_len : 0;
+}
+
+const uint8_t *hal_host_uart_tx_data(const UART_HandleTypeDef *huart)
+{
+    hal_host_uart_t *uart = hal_host_uart_find(huart->Instance);
+    return (uart != NULL) ? uart->tx : NULL;
+}
+
+void hal_host_uart_tx_clear(const UART_HandleTypeDef *huart)
+{
+    hal_host_uart_t *uart = hal_host_uart_find(huart->Instance);
+    if (uart != NULL) {
+        uart->tx_len = 0;
+    }
+}
+
+/**
+ * @brief Si echo está activo, lo transmitido también se escribe en la consola.
+ */
+void hal_host_uart_set_echo(bool echo)
+{
+    host.uart_echo = echo;
+}
+
+static void hal_host_uart_capture(hal_host_uart_t *uart, UART_HandleTypeDef *huart,
+                                  const uint8_t *pData, uint16_t Size)
+{
+    if (uart != NULL) {
+        size_t room = HAL_HOST_UART_CAPTURE_LEN - uart->tx_len;
+        size_t n = (Size < room) ? Size : room;
+        memcpy(&uart->tx[uart->tx_len], pData, n);
+        uart->tx_len += n;
+    }
+    if (host.uart_echo) {
+        // Directo al descriptor: stdout puede estar redirigido a esta misma UART
+        ssize_t written = write(STDOUT_FILENO, pData, Size);
+        (void)written;
+    }
+
+    hal_host_record(HAL_HOST_EV_UART_TX, huart->Instance, 0, Size);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+    hal_host_uart_capture(hal_host_uart_find(huart->Instance), huart, pData, Size);
+    return HAL_OK;
+}
+
+/**
+ * @brief Los bytes se capturan enseguida, pero la UART queda ocupada (gState)
+ * el tiempo que tardaría la línea a Init.BaudRate con 10 bits por byte;
+ * hal_host_advance() la libera y llama a HAL_UART_TxCpltCallback().
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0) {
+        return HAL_ERROR;
+    }
+    if (huart->gState != HAL_UART_STATE_READY) {
+        return HAL_BUSY;
+    }
+
+    hal_host_uart_t *uart = hal_host_uart_find(huart->Instance);
+    hal_host_uart_capture(uart, huart, pData, Size);
+
+    uint32_t baud = (huart->Init.BaudRate != 0) ? huart->Init.BaudRate : 115200U;
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    if (uart != NULL) {
+        uart->tx_it = huart;
+        uart->tx_it_done = host.tick + (uint32_t)(((uint64_t)Size * 10000U + baud - 1U) / baud);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    if (pData == NULL || Size == 0) {
+        return HAL_ERROR;
+    }
+    huart->pRxBuffPtr = pData;
+    huart->RxXferSize = Size;
+    huart->RxXferCount = Size;
+    return HAL_OK;
+}
+
+/* I2C ----------------------------------------------------------------------*/
+
+/**
+ * @brief Resultado que devolverán las próximas escrituras I2C (p. ej. HAL_ERROR
+ * para simular un NACK del display).
+ */
+void hal_host_i2c_set_result(HAL_StatusTypeDef result)
+{
+    host.i2c_result = result;
+}
+
+void hal_host_i2c_set_write_hook(hal_host_i2c_write_fn hook)
+{
+    host.i2c_write_hook = hook;
+}
+
+uint32_t hal_host_i2c_transactions(void)
+{
+    return host.i2c_transactions;
+}
+
+uint32_t hal_host_i2c_bytes(void)
+{
+    return host.i2c_bytes;
+}
+
+uint32_t hal_host_i2c_fast_mode_plus(void)
+{
+    return host.i2c_fmp;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+    hi2c->Instance->TIMINGR = hi2c->Init.Timing;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    return HAL_OK;
+}
+
+void HAL_I2CEx_EnableFastModePlus(uint32_t ConfigFastModePlus)
+{
+    host.i2c_fmp |= ConfigFastModePlus;
+}
+
+void HAL_I2CEx_DisableFastModePlus(uint32_t ConfigFastModePlus)
+{
+    host.i2c_fmp &= ~ConfigFastModePlus;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+    (void)Timeout;
+
+    hal_host_record(HAL_HOST_EV_I2C_WRITE, hi2c->Instance, DevAddress, Size);
+    if (host.i2c_result != HAL_OK) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return host.i2c_result;
+    }
+
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    host.i2c_transactions++;
+    host.i2c_bytes += MemAddSize + Size;
+    if (host.i2c_write_hook != NULL) {
+        host.i2c_write_hook(DevAddress, MemAddress, pData, Size);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                          uint16_t Size, uint32_t Timeout)
+{
+    // Sin dirección de memoria: el primer byte es el byte de control
+    if (Size == 0) {
+        return HAL_ERROR;
+    }
+    return HAL_I2C_Mem_Write(hi2c, DevAddress, pData[0], 0, &pData[1], (uint16_t)(Size - 1), Timeout);
+}
+
+/* ADC ----------------------------------------------------------------------*/
+
+void hal_host_adc_set_value(uint32_t raw)
+{
+    host.adc_value = raw & 0x0FFFU;
+}
+
+void hal_host_adc_set_result(HAL_StatusTypeDef result)
+{
+    host.adc_result = result;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
+{
+    (void)hadc;
+    return host.adc_result;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc)
+{
+    (void)hadc;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout)
+{
+    (void)hadc;
+    (void)Timeout;
+    return host.adc_result;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc)
+{
+    hal_host_record(HAL_HOST_EV_ADC_READ, hadc->Instance, 0, host.adc_value);
+    return host.adc_value;
+}
+
+/* Callbacks por defecto (débiles, como en la HAL real) ---------------------*/
+
+__attribute__((weak)) void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__attribute__((weak)) void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    (void)huart;
+}
+
+__attribute__((weak)) void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    (void)GPIO_Pin;
+}
+
+__attribute__((weak)) void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+}
+
+__attribute__((weak)) void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+}
+
+/* TIM / DMA ----------------------------------------------------------------*/
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->CR1 |= 1U;
+    hal_host_record(HAL_HOST_EV_TIM_START, htim->Instance, Channel, 1);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    htim->Instance->CR1 &= ~1U;
+    hal_host_record(HAL_HOST_EV_TIM_START, htim->Instance, Channel, 0);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength)
+{
+    hal_host_dma_t *dma = hal_host_dma_find(hdma->Instance);
+    if (dma == NULL || DataLength == 0 || hdma->State == HAL_DMA_STATE_BUSY) {
+        return HAL_ERROR;
+    }
+
+    dma->hdma = hdma;
+    dma->src = (const uint8_t *)SrcAddress;
+    dma->dst = (volatile uint32_t *)DstAddress;
+    dma->length = DataLength;
+
+    hdma->State = HAL_DMA_STATE_BUSY;
+    hdma->Instance->CNDTR = DataLength;
+    hdma->Instance->CCR |= DMA_IT_TC | DMA_IT_TE | 1U;
+    if (hdma->XferHalfCpltCallback != NULL) {
+        hdma->Instance->CCR |= DMA_IT_HT;
+    }
+
+    hal_host_record(HAL_HOST_EV_DMA_START, hdma->Instance, 0, DataLength);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+    hdma->Instance->CCR &= ~(DMA_IT_TC | DMA_IT_HT | DMA_IT_TE | 1U);
+    hdma->State = HAL_DMA_STATE_READY;
+    return HAL_OK;
+}
+
+// Una petición DMA: copia un elemento y dispara HT/TC como el controlador real
+static void hal_host_dma_request(DMA_HandleTypeDef *hdma)
+{
+    hal_host_dma_t *dma = hal_host_dma_find(hdma->Instance);
+    if (dma == NULL || dma->src == NULL || hdma->State != HAL_DMA_STATE_BUSY) {
+        return;
+    }
+
+    uint32_t index = dma->length - hdma->Instance->CNDTR;
+    switch (hdma->Init.MemDataAlignment) {
+    case DMA_MDATAALIGN_WORD:
+        *dma->dst = ((const uint32_t *)dma->src)[index];
+        break;
+    case DMA_MDATAALIGN_HALFWORD:
+        *dma->dst = ((const uint16_t *)dma->src)[index];
+        break;
+    default:
+        *dma->dst = dma->src[index];
+        break;
+    }
+
+    hdma->Instance->CNDTR--;
+
+    if (hdma->Instance->CNDTR == dma->length / 2) {
+        DMA1->ISR |= __HAL_DMA_GET_HT_FLAG_INDEX(hdma);
+        hal_host_dma_irq(hdma);
+    }
+
+    if (hdma->Instance->CNDTR == 0) {
+        DMA1->ISR |= __HAL_DMA_GET_TC_FLAG_INDEX(hdma);
+        if (hdma->Init.Mode == DMA_CIRCULAR) {
+            hdma->Instance->CNDTR = dma->length;
+        } else {
+            hdma->State = HAL_DMA_STATE_READY;
+        }
+        hal_host_dma_irq(hdma);
+    }
+}
+
+/**
+ * @brief Atiende HT/TC como HAL_DMA_IRQHandler(): si la bandera está puesta y
+ * la interrupción habilitada, la limpia y llama al callback. Con PRIMASK en 1
+ * no hace nada y la bandera queda pendiente.
+ */
+void hal_host_dma_irq(DMA_HandleTypeDef *hdma)
+{
+    if (hal_host_primask != 0U) {
+        return;
+    }
+
+    uint32_t ht = __HAL_DMA_GET_HT_FLAG_INDEX(hdma);
+    if ((DMA1->ISR & ht) && (hdma->Instance->CCR & DMA_IT_HT)) {
+        DMA1->ISR &= ~ht;
+        if (hdma->XferHalfCpltCallback != NULL) {
+            hdma->XferHalfCpltCallback(hdma);
+        }
+    }
+
+    uint32_t tc = __HAL_DMA_GET_TC_FLAG_INDEX(hdma);
+    if ((DMA1->ISR & tc) && (hdma->Instance->CCR & DMA_IT_TC)) {
+        DMA1->ISR &= ~tc;
+        if (hdma->XferCpltCallback != NULL) {
+            hdma->XferCpltCallback(hdma);
+        }
+    }
+}
+
+void hal_host_irq_unmask(void)
+{
+    for (size_t i = 0; i < HAL_HOST_DMA_CHANNELS; i++) {
+        if (host.dma[i].hdma != NULL) {
+            hal_host_dma_irq(host.dma[i].hdma);
+        }
+    }
+}
+
+uint32_t hal_host_dma_get_counter(DMA_HandleTypeDef *hdma)
+{
+    uint32_t counter = hdma->Instance->CNDTR;
+    if (host.dma_counter_hook != NULL) {
+        host.dma_counter_hook(hdma);
+    }
+    return counter;
+}
+
+/**
+ * @brief Hook llamado después de cada lectura de CNDTR (p. ej. para avanzar
+ * el timer y simular que el DMA se mueve mientras el firmware calcula).
+ */
+void hal_host_dma_set_counter_hook(hal_host_dma_counter_fn hook)
+{
+    host.dma_counter_hook = hook;
+}
+
+/**
+ * @brief Simula events periodos completos del timer. Si el update tiene DMA
+ * habilitado (TIM_DMA_UPDATE), cada periodo genera una petición al canal
+ * enlazado en htim->hdma[TIM_DMA_ID_UPDATE].
+ */
+void hal_host_tim_update(TIM_HandleTypeDef *htim, uint32_t events)
+{
+    for (uint32_t i = 0; i < events; i++) {
+        htim->Instance->SR |= 1U;
+        if ((htim->Instance->DIER & TIM_DMA_UPDATE) && htim->hdma[TIM_DMA_ID_UPDATE] != NULL) {
+            hal_host_dma_request(htim->hdma[TIM_DMA_ID_UPDATE]);
+        }
+    }
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+}
+
+/* FLASH --------------------------------------------------------------------*/
+
+// Aparte de host: hal_host_reset() no borra la flash (es no volátil)
+static struct {
+    uint8_t ram[FLASH_SIZE];
+    uint8_t *mem;           // ram o el archivo mapeado
+    bool unlocked;
+    uint32_t busy_us;       // Tiempo de programación aún no sumado al tick
+    uint32_t programs;
+    uint32_t page_erases;
+} flash;
+
+static uint8_t *hal_host_flash_mem(void)
+{
+    if (flash.mem == NULL) {
+        memset(flash.ram, 0xFF, sizeof(flash.ram));
+        flash.mem = flash.ram;
+    }
+    return flash.mem;
+}
+
+// La CPU queda detenida mientras la flash está ocupada: avanza el tick
+static void hal_host_flash_busy(uint32_t us)
+{
+    flash.busy_us += us;
+    host.tick += flash.busy_us / 1000U;
+    flash.busy_us %= 1000U;
+}
+
+/**
+ * @brief Respalda la flash emulada en un archivo (mmap compartido). Si el
+ * archivo no existe se crea borrado; si existe, su contenido es la flash.
+ */
+bool hal_host_flash_attach(const char *path)
+{
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (st.st_size < (off_t)FLASH_SIZE && ftruncate(fd, FLASH_SIZE) != 0)) {
+        close(fd);
+        return false;
+    }
+
+    uint8_t *mem = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+    if (st.st_size < (off_t)FLASH_SIZE) {
+        memset(&mem[st.st_size], 0xFF, FLASH_SIZE - (size_t)st.st_size);
+    }
+    flash.mem = mem;
+    return true;
+}
+
+void hal_host_flash_erase_all(void)
+{
+    memset(hal_host_flash_mem(), 0xFF, FLASH_SIZE);
+}
+
+uint32_t hal_host_flash_programs(void)
+{
+    return flash.programs;
+}
+
+uint32_t hal_host_flash_page_erases(void)
+{
+    return flash.page_erases;
+}
+
+const uint8_t *hal_host_flash_ptr(uint32_t address)
+{
+    return &hal_host_flash_mem()[address - FLASH_BASE];
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    flash.unlocked = true;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    flash.unlocked = false;
+    return HAL_OK;
+}
+
+/**
+ * @brief Programa una palabra doble. Como en el L476 (PROGERR), falla si
+ * la dirección no está alineada o la palabra no está borrada.
+ */
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+    uint8_t *mem = hal_host_flash_mem();
+    uint64_t current;
+
+    if (!flash.unlocked || TypeProgram != FLASH_TYPEPROGRAM_DOUBLEWORD ||
+        Address < FLASH_BASE || Address - FLASH_BASE > FLASH_SIZE - 8U || (Address & 7U) != 0) {
+        return HAL_ERROR;
+    }
+    memcpy(&current, &mem[Address - FLASH_BASE], sizeof(current));
+    if (current != UINT64_MAX) {
+        return HAL_ERROR;
+    }
+
+    memcpy(&mem[Address - FLASH_BASE], &Data, sizeof(Data));
+    flash.programs++;
+    hal_host_flash_busy(HAL_HOST_FLASH_PROGRAM_US);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError)
+{
+    uint8_t *mem = hal_host_flash_mem();
+    uint32_t pages_per_bank = FLASH_BANK_SIZE / FLASH_PAGE_SIZE;
+
+    *PageError = 0xFFFFFFFFU;
+    if (!flash.unlocked || pEraseInit->TypeErase != FLASH_TYPEERASE_PAGES ||
+        (pEraseInit->Banks != FLASH_BANK_1 && pEraseInit->Banks != FLASH_BANK_2) ||
+        pEraseInit->Page + pEraseInit->NbPages > pages_per_bank) {
+        return HAL_ERROR;
+    }
+
+    uint32_t bank_offset = (pEraseInit->Banks == FLASH_BANK_2) ? FLASH_BANK_SIZE : 0U;
+    for (uint32_t page = pEraseInit->Page; page < pEraseInit->Page + pEraseInit->NbPages; page++) {
+        memset(&mem[bank_offset + page * FLASH_PAGE_SIZE], 0xFF, FLASH_PAGE_SIZE);
+        flash.page_erases++;
+        hal_host_flash_busy(HAL_HOST_FLASH_ERASE_US);
+    }
+    return HAL_OK;
+}
+
+/* RTC ----------------------------------------------------------------------*/
+
+// Días desde 1970-01-01 de una fecha del calendario gregoriano (H. Hinnant)
+static int64_t hal_host_days_from_civil(int64_t y, uint32_t m, uint32_t d)
+{
+    y -= (m <= 2U) ? 1 : 0;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    uint32_t yoe = (uint32_t)(y - era * 400);
+    uint32_t doy = (153U * (m > 2U ? m - 3U : m + 9U) + 2U) / 5U + d - 1U;
+    uint32_t doe = yoe * 365U + yoe / 4U - yoe / 100U + doy;
+    return era * 146097 + (int64_t)doe - 719468;
+}
+
+static void hal_host_civil_from_days(int64_t z, int64_t *y, uint32_t *m, uint32_t *d)
+{
+    z += 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    uint32_t doe = (uint32_t)(z - era * 146097);
+    uint32_t yoe = (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+    uint32_t doy = doe - (365U * yoe + yoe / 4U - yoe / 100U);
+    uint32_t mp = (5U * doy + 2U) / 153U;
+    *d = doy - (153U * mp + 2U) / 5U + 1U;
+    *m = (mp < 10U) ? mp + 3U : mp - 9U;
+    *y = (int64_t)yoe + era * 400 + (*m <= 2U ? 1 : 0);
+}
+
+// Avanza el calendario hasta el tick actual a la frecuencia del LSE
+static void hal_host_rtc_update(void)
+{
+    uint32_t dt = host.tick - host.rtc_tick;
+    host.rtc_tick = host.tick;
+
+    double ppm = host.rtc_error_ppm + (double)host.rtc_cal_pulses * 1e6 / 1048576.0;
+    host.rtc_rest_ns += (double)dt * 1e6 * (1.0 + ppm / 1e6);
+    int64_t whole = (int64_t)host.rtc_rest_ns;
+    host.rtc_ns += whole;
+    host.rtc_rest_ns -= (double)whole;
+}
+
+void hal_host_rtc_set_error_ppm(double ppm)
+{
+    hal_host_rtc_update();
+    host.rtc_error_ppm = ppm;
+}
+
+uint64_t hal_host_rtc_epoch_ms(void)
+{
+    hal_host_rtc_update();
+    return (uint64_t)(host.rtc_ns / 1000000LL) + (uint64_t)HAL_HOST_RTC_EPOCH_DAYS * 86400000ULL;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    (void)Format;
+    hal_host_rtc_update();
+
+    int64_t seconds = host.rtc_ns / HAL_HOST_RTC_NS_PER_S;
+    int64_t ns = host.rtc_ns % HAL_HOST_RTC_NS_PER_S;
+    uint32_t of_day = (uint32_t)(seconds % 86400);
+    uint32_t prediv_s = hrtc->Init.SynchPrediv;
+
+    memset(sTime, 0, sizeof(*sTime));
+    sTime->Hours = (uint8_t)(of_day / 3600U);
+    sTime->Minutes = (uint8_t)(of_day / 60U % 60U);
+    sTime->Seconds = (uint8_t)(of_day % 60U);
+    sTime->SubSeconds = prediv_s - (uint32_t)(ns * (prediv_s + 1U) / HAL_HOST_RTC_NS_PER_S);
+    sTime->SecondFraction = prediv_s;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    int64_t days = host.rtc_ns / HAL_HOST_RTC_NS_PER_S / 86400;
+    int64_t year;
+    uint32_t month, day;
+    hal_host_civil_from_days(days + HAL_HOST_RTC_EPOCH_DAYS, &year, &month, &day);
+
+    sDate->Year = (uint8_t)(year - 2000);
+    sDate->Month = (uint8_t)month;
+    sDate->Date = (uint8_t)day;
+    sDate->WeekDay = (uint8_t)((days + 5) % 7 + 1);   // 2000-01-01 fue sábado (6)
+    return HAL_OK;
+}
+
+// Escribir hora o fecha reinicia los prescalers: el segundo arranca entero
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    hal_host_rtc_update();
+    int64_t days = host.rtc_ns / HAL_HOST_RTC_NS_PER_S / 86400;
+    int64_t of_day = sTime->Hours * 3600 + sTime->Minutes * 60 + sTime->Seconds;
+    host.rtc_ns = (days * 86400 + of_day) * HAL_HOST_RTC_NS_PER_S;
+    host.rtc_rest_ns = 0.0;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+    (void)hrtc;
+    (void)Format;
+    hal_host_rtc_update();
+    int64_t of_day = host.rtc_ns / HAL_HOST_RTC_NS_PER_S % 86400;
+    int64_t days = hal_host_days_from_civil(2000 + sDate->Year, sDate->Month, sDate->Date) -
+                   HAL_HOST_RTC_EPOCH_DAYS;
+    host.rtc_ns = (days * 86400 + of_day) * HAL_HOST_RTC_NS_PER_S;
+    host.rtc_rest_ns = 0.0;
+    return HAL_OK;
+}
+
+// Alarma B: día del mes, hora, minuto y segundo del calendario
+static bool hal_host_rtc_alarm_b_match(void)
+{
+    RTC_TimeTypeDef time;
+    RTC_DateTypeDef date;
+    HAL_RTC_GetTime(host.rtc_alarm_b, &time, RTC_FORMAT_BIN);
+    HAL_RTC_GetDate(host.rtc_alarm_b, &date, RTC_FORMAT_BIN);
+    const RTC_AlarmTypeDef *at = &host.rtc_alarm_b_at;
+    return date.Date == at->AlarmDateWeekDay && time.Hours == at->AlarmTime.Hours &&
+           time.Minutes == at->AlarmTime.Minutes && time.Seconds == at->AlarmTime.Seconds;
+}
+
+// Solo las formas que usa el firmware: alarma A con todos los campos
+// enmascarados y alarma B sin máscaras, por día del mes
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format)
+{
+    (void)Format;
+    hal_host_rtc_update();
+    if (sAlarm->Alarm == RTC_ALARM_A && sAlarm->AlarmMask == RTC_ALARMMASK_ALL) {
+        host.rtc_alarm = hrtc;
+        host.rtc_alarm_second = host.rtc_ns / HAL_HOST_RTC_NS_PER_S;
+        return HAL_OK;
+    }
+    if (sAlarm->Alarm == RTC_ALARM_B && sAlarm->AlarmMask == RTC_ALARMMASK_NONE &&
+        sAlarm->AlarmDateWeekDaySel == RTC_ALARMDATEWEEKDAYSEL_DATE) {
+        host.rtc_alarm_b = hrtc;
+        host.rtc_alarm_b_at = *sAlarm;
+        return HAL_OK;
+    }
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm)
+{
+    (void)hrtc;
+    if (Alarm == RTC_ALARM_A) {
+        host.rtc_alarm = NULL;
+    } else if (Alarm == RTC_ALARM_B) {
+        host.rtc_alarm_b = NULL;
+    } else {
+        return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetSmoothCalib(RTC_HandleTypeDef *hrtc, uint32_t SmoothCalibPeriod,
+                                           uint32_t SmoothCalibPlusPulses, uint32_t SmoothCalibMinusPulsesValue)
+{
+    (void)SmoothCalibPeriod;
+    if (SmoothCalibMinusPulsesValue > 0x1FFU) {
+        return HAL_ERROR;
+    }
+    hal_host_rtc_update();
+    hrtc->Instance->CALR = SmoothCalibPlusPulses | SmoothCalibMinusPulsesValue;
+    host.rtc_cal_pulses = ((SmoothCalibPlusPulses != 0U) ? 512 : 0) - (int32_t)SmoothCalibMinusPulsesValue;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetSynchroShift(RTC_HandleTypeDef *hrtc, uint32_t ShiftAdd1S, uint32_t ShiftSubFS)
+{
+    if (ShiftSubFS > 0x7FFFU) {
+        return HAL_ERROR;
+    }
+    hal_host_rtc_update();
+    int64_t add = (ShiftAdd1S != 0U) ? HAL_HOST_RTC_NS_PER_S : 0;
+    host.rtc_ns += add - (int64_t)ShiftSubFS * HAL_HOST_RTC_NS_PER_S / (hrtc->Init.SynchPrediv + 1U);
+    return HAL_OK;
+}
+
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister, uint32_t Data)
+{
+    hrtc->Instance->BKPxR[BackupRegister] = Data;
+}
+
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister)
+{
+    return hrtc->Instance->BKPxR[BackupRegister];
+}
+
+/* RCC / tick ---------------------------------------------------------------*/
+
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+    return host.pclk1;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+    return host.pclk1;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+    return host.pclk1;
+}
+
+/**
+ * @brief Contador de "ciclos" del host: nanosegundos de CLOCK_MONOTONIC, es
+ * decir un núcleo de 1 GHz (SystemCoreClock) para las conversiones a µs.
+ */
+uint32_t hal_host_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return host.tick;
+}
+
+// UID fijo (coordenadas de oblea, lote): la misma clave de equipo en cada corrida
+uint32_t HAL_GetUIDw0(void)
+{
+    return 0x00350041U;
+}
+
+uint32_t HAL_GetUIDw1(void)
+{
+    return 0x5052500BU;
+}
+
+uint32_t HAL_GetUIDw2(void)
+{
+    return 0x20373648U;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    host.tick += Delay;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file pbm.c
+ * @brief PBM P4 <-> framebuffer en páginas del SSD1306.
+ */
+#include "pbm.h"
+#include <stdio.h>
+#include <string.h>
+
+static bool pbm_get(const uint8_t *pages, uint16_t width, uint16_t x, uint16_t y)
+{
+    return (pages[(size_t)(y / 8) * width + x] >> (y % 8)) & 1u;
+}
+
+bool pbm_write(const char *path, const uint8_t *pages, uint16_t width, uint16_t height)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+
+    fprintf(f, "P4\n%u %u\n", (unsigned)width, (unsigned)height);
+    for (uint16_t y = 0; y < height; y++) {
+        uint8_t byte = 0;
+        for (uint16_t x = 0; x < width; x++) {
+            byte = (uint8_t)((byte << 1) | pbm_get(pages, width, x, y));
+            if (x % 8 == 7 || x == width - 1) {
+                // Fila incompleta: completar con ceros a la derecha
+                byte = (uint8_t)(byte << (7 - x % 8));
+                fputc(byte, f);
+                byte = 0;
+            }
+        }
+    }
+    return fclose(f) == 0;
+}
+
+bool pbm_read(const char *path, uint8_t *pages, uint16_t width, uint16_t height)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+
+    unsigned w = 0, h = 0;
+    if (fscanf(f, "P4 %u %u", &w, &h) != 2 || w != width || h != height || fgetc(f) == EOF) {
+        fclose(f);
+        return false;
+    }
+
+    memset(pages, 0, (size_t)width * ((height + 7) / 8));
+    size_t row_bytes = (width + 7) / 8;
+    for (uint16_t y = 0; y < height; y++) {
+        for (size_t b = 0; b < row_bytes; b++) {
+            int byte = fgetc(f);
+            if (byte == EOF) {
+                fclose(f);
+                return false;
+            }
+            for (uint16_t bit = 0; bit < 8 && b * 8 + bit < width; bit++) {
+                if (byte & (0x80 >> bit)) {
+                    pages[(size_t)(y / 8) * width + b * 8 + bit] |= (uint8_t)(1u << (y % 8));
+                }
+            }
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+size_t pbm_diff(const uint8_t *a, const uint8_t *b, uint16_t width, uint16_t height)
+{
+    size_t diff = 0;
+    size_t len = (size_t)width * ((height + 7) / 8);
+
+    for (size_t i = 0; i < len; i++) {
+        diff += (size_t)__builtin_popcount((unsigned)(a[i] ^ b[i]));
+    }
+    return diff;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file tlog_host.c
+ * @brief Reconstrucción del texto de TLOG() a partir de los formatos de la
+ * sección tlog. Misma lógica que Host/tools/tlog_decode.py.
+ */
+#include "tlog_host.h"
+#include "tlog.h"
+#include <stdio.h>
+#include <string.h>
+
+extern const char __stop_tlog[];
+
+typedef struct {
+    char *out;
+    size_t size;
+    size_t len;
+} tlog_text_t;
+
+static void tlog_text_append(tlog_text_t *text, const char *s, size_t n)
+{
+    for (size_t i = 0; i < n && text->len + 1 < text->size; i++) {
+        text->out[text->len++] = s[i];
+    }
+    text->out[text->len] = '\0';
+}
+
+static int tlog_read_varint(const uint8_t **p, const uint8_t *end, uint32_t *value)
+{
+    *value = 0;
+    for (unsigned shift = 0; *p < end && shift < 35; shift += 7) {
+        uint8_t b = *(*p)++;
+        *value |= (uint32_t)(b & 0x7FU) << shift;
+        if ((b & 0x80U) == 0) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int tlog_read_int(const uint8_t **p, const uint8_t *end, int32_t *value)
+{
+    uint32_t zz;
+    if (tlog_read_varint(p, end, &zz) != 0) {
+        return -1;
+    }
+    *value = (int32_t)((zz >> 1) ^ (0U - (zz & 1U)));
+    return 0;
+}
+
+// %{A|B|C}: el texto número value (o "?")
+static const char *tlog_render_choice(tlog_text_t *text, const char *fmt, int32_t value)
+{
+    const char *close = strchr(fmt, '}');
+    if (close == NULL) {
+        return fmt + strlen(fmt);
+    }
+    const char *option = fmt + 2;
+    for (int32_t i = 0; i < value && option < close; i++) {
+        const char *bar = memchr(option, '|', (size_t)(close - option));
+        option = (bar != NULL) ? bar + 1 : close;
+    }
+    if (value < 0 || option >= close) {
+        tlog_text_append(text, "?", 1);
+    } else {
+        const char *bar = memchr(option, '|', (size_t)(close - option));
+        tlog_text_append(text, option, (size_t)((bar != NULL ? bar : close) - option));
+    }
+    return close + 1;
+}
+
+int tlog_host_render(const uint8_t *frame, size_t len, char *out, size_t out_size)
+{
+    if (out_size == 0 || len < 4 || frame[0] != TLOG_SYNC || frame[1] != len - 2) {
+        return -1;
+    }
+    uint16_t id = (uint16_t)(frame[2] | (frame[3] << 8));
+    if (id >= (size_t)(__stop_tlog - __start_tlog)) {
+        return -1;
+    }
+
+    const char *fmt = __start_tlog + id;
+    const uint8_t *p = frame + 4;
+    const uint8_t *end = frame + len;
+    tlog_text_t text = { out, out_size, 0 };
+    out[0] = '\0';
+
+    while (*fmt != '\0') {
+        const char *pct = strchr(fmt, '%');
+        if (pct == NULL) {
+            tlog_text_append(&text, fmt, strlen(fmt));
+            break;
+        }
+        tlog_text_append(&text, fmt, (size_t)(pct - fmt));
+        fmt = pct;
+
+        if (fmt[1] == '%') {
+            tlog_text_append(&text, "%", 1);
+            fmt += 2;
+            continue;
+        }
+
+        int32_t value = 0;
+        if (fmt[1] == '{') {
+            if (tlog_read_int(&p, end, &value) != 0) {
+                return -1;
+            }
+            fmt = tlog_render_choice(&text, fmt, value);
+            continue;
+        }
+
+        // Banderas, ancho y precisión se pasan a snprintf; el largo (l, h, z) no
+        char spec[16] = "%";
+        size_t spec_len = 1;
+        fmt++;
+        while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != NULL && spec_len < sizeof(spec) - 2) {
+            spec[spec_len++] = *fmt++;
+        }
+        while (*fmt == 'l' || *fmt == 'h' || *fmt == 'z') {
+            fmt++;
+        }
+        char conv = *fmt;
+        if (conv == '\0') {
+            break;
+        }
+        fmt++;
+        spec[spec_len++] = conv;
+        spec[spec_len] = '\0';
+
+        char piece[64];
+        int n = 0;
+        if (strchr("fFeEgG", conv) != NULL) {
+            if (end - p < 4) {
+                return -1;
+            }
+            uint32_t bits = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            p += 4;
+            n = snprintf(piece, sizeof(piece), spec, (double)f);
+        } else if (conv == 's') {
+            uint32_t slen;
+            if (tlog_read_varint(&p, end, &slen) != 0 || slen > (uint32_t)(end - p) || slen >= sizeof(piece)) {
+                return -1;
+            }
+            char str[64];
+            memcpy(str, p, slen);
+            str[slen] = '\0';
+            p += slen;
+            n = snprintf(piece, sizeof(piece), spec, str);
+        } else if (strchr("diuxXoc", conv) != NULL) {
+            if (tlog_read_int(&p, end, &value) != 0) {
+                return -1;
+            }
+            n = (conv == 'd' || conv == 'i' || conv == 'c')
+                    ? snprintf(piece, sizeof(piece), spec, (int)value)
+                    : snprintf(piece, sizeof(piece), spec, (unsigned)value);
+        } else {
+            return -1;
+        }
+        if (n > 0) {
+            tlog_text_append(&text, piece, ((size_t)n < sizeof(piece)) ? (size_t)n : sizeof(piece) - 1);
+        }
+    }
+    return (int)text.len;
+}
+
+size_t tlog_host_feed(tlog_host_stream_t *stream, uint8_t byte, char *out, size_t out_size)
+{
+    if (stream->len == 0 && byte != TLOG_SYNC) {
+        if (out_size == 0) {
+            return 0;
+        }
+        out[0] = (char)byte;
+        return 1;
+    }
+
+    stream->frame[stream->len++] = byte;
+    if (stream->len == 2) {
+        stream->expected = 2U + byte;
+    }
+    if (stream->len < 2 || stream->len < stream->expected) {
+        return 0;
+    }
+
+    int n = tlog_host_render(stream->frame, stream->len, out, out_size);
+    stream->len = 0;
+    stream->expected = 0;
+    if (n < 0) {
+        n = snprintf(out, out_size, "<tlog?>\n");
+    }
+    return (n > 0) ? (size_t)n : 0;
+}
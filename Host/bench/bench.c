@@ -0,0 +1,283 @@
+/**
+ * @file bench.c
+ * @brief Runner de benchmarks: calibración, repeticiones y salida JSON.
+ *
+ * Uso: room_control_bench [--filter TEXTO] [--min-time MS] [--repetitions N]
+ *                         [--json ARCHIVO|-] [--label TEXTO] [--list]
+ */
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_REPETITIONS 32
+
+typedef struct {
+    const char *name;
+    double value;
+} bench_counter_t;
+
+typedef struct {
+    const bench_case_t *bench;
+    uint64_t iterations;
+    double real_ns[BENCH_MAX_REPETITIONS];   // ns por operación en cada repetición
+    double cpu_ns[BENCH_MAX_REPETITIONS];
+    unsigned repetitions;
+    bench_counter_t counters[BENCH_MAX_COUNTERS];
+    unsigned counter_count;
+} bench_result_t;
+
+static bench_result_t *bench_current;
+
+void bench_counter(const char *name, double value_per_op)
+{
+    if (bench_current == NULL) {
+        return;
+    }
+    for (unsigned i = 0; i < bench_current->counter_count; i++) {
+        if (strcmp(bench_current->counters[i].name, name) == 0) {
+            bench_current->counters[i].value = value_per_op;
+            return;
+        }
+    }
+    if (bench_current->counter_count < BENCH_MAX_COUNTERS) {
+        bench_current->counters[bench_current->counter_count].name = name;
+        bench_current->counters[bench_current->counter_count].value = value_per_op;
+        bench_current->counter_count++;
+    }
+}
+
+void bench_do_not_optimize(const void *p)
+{
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+static double bench_clock_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Corre un lote y devuelve el tiempo real total (ns); cpu_ns recibe el de CPU
+static double bench_run_batch(const bench_case_t *bench, uint64_t iterations, double *cpu_ns)
+{
+    if (bench->setup != NULL) {
+        bench->setup();
+    }
+
+    double cpu_start = bench_clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    double start = bench_clock_ns(CLOCK_MONOTONIC);
+    bench->run(iterations);
+    double elapsed = bench_clock_ns(CLOCK_MONOTONIC) - start;
+    *cpu_ns = bench_clock_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    return elapsed;
+}
+
+static int bench_compare_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double bench_median(const double *values, unsigned n)
+{
+    double sorted[BENCH_MAX_REPETITIONS];
+    memcpy(sorted, values, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), bench_compare_double);
+    return (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+}
+
+static double bench_min(const double *values, unsigned n)
+{
+    double m = values[0];
+    for (unsigned i = 1; i < n; i++) {
+        if (values[i] < m) {
+            m = values[i];
+        }
+    }
+    return m;
+}
+
+static void bench_run_case(bench_result_t *result, double min_time_ns, unsigned repetitions)
+{
+    const bench_case_t *bench = result->bench;
+    double cpu_ns;
+
+    bench_current = result;
+
+    // Calibración: duplicar el lote hasta que dure al menos 1/10 del mínimo
+    uint64_t iterations = 1;
+    double elapsed = bench_run_batch(bench, iterations, &cpu_ns);
+    while (elapsed < min_time_ns / 10.0 && iterations < (UINT64_C(1) << 40)) {
+        iterations *= 2;
+        elapsed = bench_run_batch(bench, iterations, &cpu_ns);
+    }
+    if (elapsed < min_time_ns) {
+        iterations = (uint64_t)((double)iterations * min_time_ns / (elapsed > 1.0 ? elapsed : 1.0)) + 1;
+    }
+
+    result->iterations = iterations;
+    result->repetitions = repetitions;
+    for (unsigned r = 0; r < repetitions; r++) {
+        elapsed = bench_run_batch(bench, iterations, &cpu_ns);
+        result->real_ns[r] = elapsed / (double)iterations;
+        result->cpu_ns[r] = cpu_ns / (double)iterations;
+    }
+
+    bench_current = NULL;
+}
+
+static void bench_print_json_string(FILE *out, const char *s)
+{
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+static void bench_write_json(FILE *out, const bench_result_t *results, unsigned count, const char *label)
+{
+    char date[32];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+    fprintf(out, "{\n  \"context\": {\n    \"date\": \"%s\",\n", date);
+    fprintf(out, "    \"label\": ");
+    bench_print_json_string(out, label);
+    fprintf(out, ",\n    \"compiler\": \"%s\",\n", __VERSION__);
+#ifdef NDEBUG
+    fprintf(out, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+    fprintf(out, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+    fprintf(out, "  \"benchmarks\": [\n");
+
+    for (unsigned i = 0; i < count; i++) {
+        const bench_result_t *r = &results[i];
+        double real = bench_median(r->real_ns, r->repetitions);
+
+        fprintf(out, "    {\n      \"name\": ");
+        bench_print_json_string(out, r->bench->name);
+        fprintf(out, ",\n      \"run_type\": \"aggregate\",\n      \"aggregate_name\": \"median\",\n");
+        fprintf(out, "      \"repetitions\": %u,\n", r->repetitions);
+        fprintf(out, "      \"iterations\": %llu,\n", (unsigned long long)r->iterations);
+        fprintf(out, "      \"real_time\": %.3f,\n", real);
+        fprintf(out, "      \"real_time_min\": %.3f,\n", bench_min(r->real_ns, r->repetitions));
+        fprintf(out, "      \"cpu_time\": %.3f,\n", bench_median(r->cpu_ns, r->repetitions));
+        if (r->bench->bytes_per_op != 0) {
+            fprintf(out, "      \"bytes_per_second\": %.0f,\n", (double)r->bench->bytes_per_op * 1e9 / real);
+        }
+        for (unsigned c = 0; c < r->counter_count; c++) {
+            fprintf(out, "      ");
+            bench_print_json_string(out, r->counters[c].name);
+            fprintf(out, ": %.3f,\n", r->counters[c].value);
+        }
+        fprintf(out, "      \"time_unit\": \"ns\"\n    }%s\n", (i + 1 < count) ? "," : "");
+    }
+
+    fprintf(out, "  ]\n}\n");
+}
+
+static void bench_print_table(FILE *out, const bench_result_t *r)
+{
+    fprintf(out, "%-36s %12.1f ns %12.1f ns min %12llu it",
+           r->bench->name, bench_median(r->real_ns, r->repetitions),
+           bench_min(r->real_ns, r->repetitions), (unsigned long long)r->iterations);
+    for (unsigned c = 0; c < r->counter_count; c++) {
+        fprintf(out, "  %s=%.1f", r->counters[c].name, r->counters[c].value);
+    }
+    fprintf(out, "\n");
+}
+
+static void bench_usage(const char *argv0)
+{
+    fprintf(stderr,
+            "uso: %s [--filter TEXTO] [--min-time MS] [--repetitions N]\n"
+            "          [--json ARCHIVO|-] [--label TEXTO] [--list]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *json_path = NULL;
+    const char *label = "";
+    double min_time_ms = 100.0;
+    unsigned repetitions = 5;
+    int list_only = 0;
+
+    // board_host_init() redirige stdout a USART2: guardar la consola real
+    FILE *console = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time_ms = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+            repetitions = (unsigned)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            label = argv[++i];
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list_only = 1;
+        } else {
+            bench_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (repetitions == 0 || repetitions > BENCH_MAX_REPETITIONS || min_time_ms <= 0.0) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+
+    bench_result_t *results = calloc(bench_case_count, sizeof(bench_result_t));
+    if (results == NULL) {
+        return 1;
+    }
+
+    // Con --json - la tabla va a stderr para no mezclarla con el JSON
+    FILE *table = (json_path != NULL && strcmp(json_path, "-") == 0) ? stderr : console;
+
+    unsigned count = 0;
+    for (unsigned i = 0; i < bench_case_count; i++) {
+        if (filter != NULL && strstr(bench_cases[i].name, filter) == NULL) {
+            continue;
+        }
+        if (list_only) {
+            fprintf(console, "%s\n", bench_cases[i].name);
+            continue;
+        }
+
+        results[count].bench = &bench_cases[i];
+        bench_run_case(&results[count], min_time_ms * 1e6, repetitions);
+
+        bench_print_table(table, &results[count]);
+        fflush(table);
+        count++;
+    }
+
+    int status = 0;
+    if (json_path != NULL && !list_only) {
+        FILE *out = (strcmp(json_path, "-") == 0) ? console : fopen(json_path, "w");
+        if (out == NULL) {
+            perror(json_path);
+            status = 1;
+        } else {
+            bench_write_json(out, results, count, label);
+            if (out != console) {
+                fclose(out);
+            }
+        }
+    }
+
+    free(results);
+    return status;
+}
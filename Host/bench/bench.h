@@ -0,0 +1,37 @@
+/**
+ * @file bench.h
+ * @brief Arnés mínimo de benchmarks para el build de host.
+ *
+ * Cada caso corre en lotes de iteraciones calibrados hasta superar el
+ * tiempo mínimo, se repite varias veces y se informa la mediana en ns por
+ * operación. La salida JSON usa los nombres de campo de Google Benchmark
+ * (name, iterations, real_time, cpu_time, time_unit) para poder comparar
+ * corridas con las mismas herramientas.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+#define BENCH_MAX_COUNTERS 4
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);                 // Opcional, antes de cada repetición
+    void (*run)(uint64_t iterations);
+    uint32_t bytes_per_op;               // Si != 0 se informa bytes_per_second
+} bench_case_t;
+
+/**
+ * @brief Contador propio del caso (valor por operación), p. ej. bytes I2C
+ * por cuadro. Se llama desde run(); queda el último valor informado.
+ */
+void bench_counter(const char *name, double value_per_op);
+
+// Evita que el compilador elimine un resultado no usado
+void bench_do_not_optimize(const void *p);
+
+extern const bench_case_t bench_cases[];
+extern const unsigned bench_case_count;
+
+#endif // BENCH_H
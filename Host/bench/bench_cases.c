@@ -0,0 +1,420 @@
+/**
+ * @file bench_cases.c
+ * @brief Casos de benchmark: render del SSD1306, ring_buffer, parser de
+ * comandos, máquina de estados de room_control, almacén de configuración,
+ * log de telemetría y log tokenizado frente a printf.
+ *
+ * Todos corren sobre la HAL simulada con el log de llamadas apagado para
+ * medir el código del firmware y no el del arnés.
+ */
+#include "bench.h"
+#include "board_host.h"
+#include "hal_host.h"
+#include "ssd1306.h"
+#include "ssd1306_fonts.h"
+#include "ring_buffer.h"
+#include "command_parser.h"
+#include "room_control.h"
+#include "config_store.h"
+#include "telemetry.h"
+#include "tlog.h"
+#include "pin_hash.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_RING_CAPACITY 64
+#define BENCH_RANDOM_STREAM_LEN 4096
+
+static void bench_setup_display(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    ssd1306_Init();
+}
+
+static void bench_setup_room(void)
+{
+    bench_setup_display();
+    room_control_init(&room_system);
+    room_control_update(&room_system);
+}
+
+/* Render de glifos ---------------------------------------------------------*/
+
+// Un glifo por operación, recorriendo los 95 caracteres imprimibles
+static void bench_glyph(uint64_t iterations, SSD1306_Font_t font)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        ssd1306_SetCursor(0, 0);
+        char ch = ssd1306_WriteChar((char)(' ' + i % 95), font, White);
+        bench_do_not_optimize(&ch);
+    }
+}
+
+#define BENCH_GLYPH_CASE(font) \
+    static void bench_glyph_##font(uint64_t iterations) { bench_glyph(iterations, font); }
+
+BENCH_GLYPH_CASE(Font_6x8)
+BENCH_GLYPH_CASE(Font_7x10)
+BENCH_GLYPH_CASE(Font_11x18)
+BENCH_GLYPH_CASE(Font_16x15)
+BENCH_GLYPH_CASE(Font_16x24)
+BENCH_GLYPH_CASE(Font_16x26)
+
+/* Pantalla completa --------------------------------------------------------*/
+
+// Cuadro típico de room_control: limpiar, tres líneas de texto y enviar por I2C
+static void bench_screen_frame(uint64_t iterations)
+{
+    uint32_t bytes_before = hal_host_i2c_bytes();
+    uint32_t transactions_before = hal_host_i2c_transactions();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        ssd1306_Fill(Black);
+        ssd1306_SetCursor(10, 10);
+        ssd1306_WriteString("SISTEMA", Font_7x10, White);
+        ssd1306_SetCursor(10, 25);
+        ssd1306_WriteString("BLOQUEADO", Font_7x10, White);
+        ssd1306_SetCursor(10, 45);
+        ssd1306_WriteString("Temp: 24.5C", Font_7x10, White);
+        ssd1306_UpdateScreen();
+    }
+
+    bench_counter("i2c_bytes", (double)(hal_host_i2c_bytes() - bytes_before) / (double)iterations);
+    bench_counter("i2c_transactions",
+                  (double)(hal_host_i2c_transactions() - transactions_before) / (double)iterations);
+}
+
+// Solo el envío del framebuffer (ssd1306_UpdateScreen)
+static void bench_screen_flush(uint64_t iterations)
+{
+    uint32_t bytes_before = hal_host_i2c_bytes();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        ssd1306_UpdateScreen();
+    }
+
+    bench_counter("i2c_bytes", (double)(hal_host_i2c_bytes() - bytes_before) / (double)iterations);
+}
+
+/* ring_buffer --------------------------------------------------------------*/
+
+// Llenar y vaciar el buffer completo: 2 * capacidad bytes por operación
+static void bench_ring_buffer(uint64_t iterations)
+{
+    static uint8_t storage[BENCH_RING_CAPACITY];
+    ring_buffer_t rb;
+    uint8_t sum = 0;
+
+    ring_buffer_init(&rb, storage, BENCH_RING_CAPACITY);
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (uint16_t k = 0; k < BENCH_RING_CAPACITY; k++) {
+            ring_buffer_write(&rb, (uint8_t)k);
+        }
+        uint8_t byte;
+        while (ring_buffer_read(&rb, &byte)) {
+            sum += byte;
+        }
+    }
+    bench_do_not_optimize(&sum);
+}
+
+/* Parser de comandos -------------------------------------------------------*/
+
+static void bench_command(uint64_t iterations, const char *line, bool drain)
+{
+    size_t len = strlen(line);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        // Un segundo por comando: el limitador de tasa siempre tiene fichas
+        hal_host_set_tick(HAL_GetTick() + 1000U);
+        for (size_t k = 0; k < len; k++) {
+            command_parser_process_debug((uint8_t)line[k]);
+        }
+        if (drain) {
+            room_control_update(&room_system);
+        }
+        // La captura de TX se vacía para no medir un buffer lleno
+        hal_host_uart_tx_clear(&huart2);
+    }
+}
+
+static void bench_command_get_status(uint64_t iterations)
+{
+    bench_command(iterations, "GET_STATUS\n", false);
+}
+
+static void bench_command_get_temp(uint64_t iterations)
+{
+    bench_command(iterations, "GET_TEMP\n", false);
+}
+
+static void bench_command_unknown(uint64_t iterations)
+{
+    bench_command(iterations, "NO_EXISTE:123\n", false);
+}
+
+// Comando que genera un evento: parseo + despacho en room_control_update()
+// FORCE_FAN pide sesión de admin: LOGIN con la clave maestra por defecto
+static void bench_setup_admin(void)
+{
+    bench_setup_room();
+    command_parser_reset();
+    hal_host_set_tick(HAL_GetTick() + 2000U);
+    for (const char *p = "LOGIN:2222\n"; *p != '\0'; p++) {
+        command_parser_process_debug((uint8_t)*p);
+    }
+    hal_host_uart_tx_clear(&huart2);
+}
+
+static void bench_command_force_fan(uint64_t iterations)
+{
+    bench_command(iterations, "FORCE_FAN:1\n", true);
+}
+
+// Bytes aleatorios por el canal debug: throughput del parser ante basura
+// (líneas inválidas, desbordes de buffer) con un '\n' cada ~16 bytes
+static void bench_command_random_stream(uint64_t iterations)
+{
+    static uint8_t stream[BENCH_RANDOM_STREAM_LEN];
+    uint32_t state = 0x12345678u;
+
+    for (size_t k = 0; k < BENCH_RANDOM_STREAM_LEN; k++) {
+        // xorshift32: la misma secuencia en cada corrida
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        stream[k] = ((state & 0xF) == 1) ? '\n' : (uint8_t)(state >> 24);
+    }
+
+    // Un segundo por línea repone el limitador de tasa: cada línea llega al
+    // despacho de comandos en lugar de cortarse en "ERR: RATE"
+    uint32_t overflows_before = command_parser_get_overflows();
+    uint32_t limited_before = command_parser_get_rate_limited();
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (size_t k = 0; k < BENCH_RANDOM_STREAM_LEN; k++) {
+            command_parser_process_debug(stream[k]);
+            if (stream[k] == '\n') {
+                hal_host_set_tick(HAL_GetTick() + 1000U);
+            }
+        }
+        hal_host_uart_tx_clear(&huart2);
+    }
+    bench_counter("overflows",
+                  (double)(command_parser_get_overflows() - overflows_before) / (double)iterations);
+    bench_counter("rate_limited",
+                  (double)(command_parser_get_rate_limited() - limited_before) / (double)iterations);
+}
+
+/* Configuración en flash ---------------------------------------------------*/
+
+static void bench_setup_config(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    hal_host_flash_erase_all();
+    config_store_init();
+}
+
+// Un cambio de setpoint por operación; incluye las compactaciones que toquen
+static void bench_config_set(uint64_t iterations)
+{
+    uint32_t programs_before = hal_host_flash_programs();
+    uint32_t erases_before = hal_host_flash_page_erases();
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        int32_t setpoint = 2000 + (int32_t)(i & 1);
+        config_store_set(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint));
+    }
+    bench_counter("flash_programs", (double)(hal_host_flash_programs() - programs_before) / (double)iterations);
+    bench_counter("erases_per_1k", 1000.0 * (double)(hal_host_flash_page_erases() - erases_before) / (double)iterations);
+}
+
+// Arranque con las páginas llenas: recorrido completo y armado del índice
+static void bench_config_boot_scan(uint64_t iterations)
+{
+    // Registros de 16 bytes hasta ocupar todas las páginas menos la libre
+    uint32_t writes = (CONFIG_STORE_PAGES - 1) * (CONFIG_STORE_PAGE_SIZE / 16) - 4;
+    config_store_stats_t st;
+
+    for (uint32_t i = 0; i < writes; i++) {
+        int32_t setpoint = 2000 + (int32_t)(i & 1);
+        config_store_set(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint));
+    }
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        config_store_init();
+    }
+    config_store_get_stats(&st);
+    bench_counter("records", (double)st.records);
+}
+
+/* Telemetría ---------------------------------------------------------------*/
+
+static void bench_setup_telemetry(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    telemetry_init();
+    telemetry_clear();
+    telemetry_poll();
+}
+
+// Una muestra por operación: temperatura que sube 0.1 °C cada 10 min y un
+// cambio de duty por hora. Informa cuántos bytes ocupa una hora a 1 Hz.
+static void bench_telemetry_sample(uint64_t iterations)
+{
+    telemetry_stats_t st;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        uint32_t s = (uint32_t)(i % 36000U);
+        telemetry_sample(22.0f + 0.1f * (float)(s / 600U), (uint16_t)(300U + 100U * (s / 3600U)), 1);
+    }
+    // Sobre lo que queda en el anillo (el resto ya se pisó)
+    telemetry_get_stats(&st);
+    bench_counter("bytes_per_hour", 4.0 * 3600.0 * (double)st.records / (double)st.periods);
+}
+
+/* Log: printf frente a TLOG() -------------------------------------------*/
+
+static void bench_setup_log(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    tlog_init();
+}
+
+// El mensaje de room_control_change_state(), incluido el envío por USART2
+static void bench_log_printf(uint64_t iterations)
+{
+    size_t bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        printf("Estado -> %s (temp=%.1f, fan=%d, manual=%d)\r\n",
+               "UNLOCKED", 22.5f + (float)(i & 7), 70, 0);
+        bytes += hal_host_uart_tx_size(&huart2);
+        hal_host_uart_tx_clear(&huart2);
+    }
+    bench_counter("uart_bytes", (double)bytes / (double)iterations);
+}
+
+// Un flush cada 16 mensajes
+static void bench_log_tlog(uint64_t iterations)
+{
+    size_t bytes = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        TLOG("Estado -> %{LOCKED|UNLOCKED|INPUT_PASSWORD|ACCESS_DENIED|EMERGENCY} "
+             "(temp=%.1f, fan=%d, manual=%d)\r\n",
+             ROOM_STATE_UNLOCKED, 22.5f + (float)(i & 7), 70, 0);
+
+        // El superloop envía lo acumulado una vez por vuelta
+        if ((i & 15) == 15) {
+            tlog_flush();
+            bytes += hal_host_uart_tx_size(&huart2);
+            hal_host_uart_tx_clear(&huart2);
+        }
+    }
+
+    // Lo que quedó de la última vuelta incompleta también se envía
+    tlog_flush();
+    bytes += hal_host_uart_tx_size(&huart2);
+    hal_host_uart_tx_clear(&huart2);
+    bench_counter("uart_bytes", (double)bytes / (double)iterations);
+}
+
+/* Verificación de la clave ---------------------------------------------------*/
+
+static pin_hash_t bench_pin;
+
+static void bench_setup_pin(void)
+{
+    board_host_init();
+    pin_hash_create(&bench_pin, "20481024", 8);
+}
+
+// Los tres casos deben tardar lo mismo: la comparación no sale antes
+static void bench_pin_verify(uint64_t iterations, const char *pin)
+{
+    uint32_t ok = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ok += pin_hash_verify(&bench_pin, pin, 8) ? 1U : 0U;
+    }
+    bench_do_not_optimize(&ok);
+    bench_counter("budget_us", (double)PIN_VERIFY_BUDGET_US);
+}
+
+static void bench_pin_verify_ok(uint64_t iterations)
+{
+    bench_pin_verify(iterations, "20481024");
+}
+
+static void bench_pin_verify_first_wrong(uint64_t iterations)
+{
+    bench_pin_verify(iterations, "90481024");
+}
+
+static void bench_pin_verify_last_wrong(uint64_t iterations)
+{
+    bench_pin_verify(iterations, "20481029");
+}
+
+static void bench_pin_create(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        pin_hash_create(&bench_pin, "20481024", 8);
+    }
+}
+
+/* Máquina de estados -------------------------------------------------------*/
+
+// Ciclo completo: clave correcta, dos niveles de ventilador y volver a bloquear
+static void bench_room_unlock_cycle(uint64_t iterations)
+{
+    static const char keys[] = "222213B";
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (size_t k = 0; k < sizeof(keys) - 1; k++) {
+            room_control_process_key(&room_system, keys[k]);
+            room_control_update(&room_system);
+        }
+        hal_host_uart_tx_clear(&huart2);
+    }
+    bench_counter("keys", (double)(sizeof(keys) - 1));
+}
+
+// Vuelta del superloop sin eventos (camino rápido)
+static void bench_room_update_idle(uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        room_control_update(&room_system);
+    }
+}
+
+const bench_case_t bench_cases[] = {
+    { "font_glyph/Font_6x8",       bench_setup_display, bench_glyph_Font_6x8,      0 },
+    { "font_glyph/Font_7x10",      bench_setup_display, bench_glyph_Font_7x10,     0 },
+    { "font_glyph/Font_11x18",     bench_setup_display, bench_glyph_Font_11x18,    0 },
+    { "font_glyph/Font_16x15",     bench_setup_display, bench_glyph_Font_16x15,    0 },
+    { "font_glyph/Font_16x24",     bench_setup_display, bench_glyph_Font_16x24,    0 },
+    { "font_glyph/Font_16x26",     bench_setup_display, bench_glyph_Font_16x26,    0 },
+    { "screen/render_flush",       bench_setup_display, bench_screen_frame,        0 },
+    { "screen/flush",              bench_setup_display, bench_screen_flush,        0 },
+    { "ring_buffer/fill_drain_64", NULL,                bench_ring_buffer,         2 * BENCH_RING_CAPACITY },
+    { "command/GET_STATUS",        bench_setup_room,    bench_command_get_status,  0 },
+    { "command/GET_TEMP",          bench_setup_room,    bench_command_get_temp,    0 },
+    { "command/unknown",           bench_setup_room,    bench_command_unknown,     0 },
+    { "command/FORCE_FAN_dispatch", bench_setup_admin,  bench_command_force_fan,   0 },
+    { "command/random_stream_4k",  bench_setup_room,    bench_command_random_stream, BENCH_RANDOM_STREAM_LEN },
+    { "config/set",                bench_setup_config,  bench_config_set,          0 },
+    { "config/boot_scan",          bench_setup_config,  bench_config_boot_scan,    0 },
+    { "telemetry/sample",          bench_setup_telemetry, bench_telemetry_sample,  0 },
+    { "log/printf_state",          bench_setup_log,     bench_log_printf,          0 },
+    { "log/tlog_state",            bench_setup_log,     bench_log_tlog,            0 },
+    { "pin/verify_ok",             bench_setup_pin,     bench_pin_verify_ok,       0 },
+    { "pin/verify_first_wrong",    bench_setup_pin,     bench_pin_verify_first_wrong, 0 },
+    { "pin/verify_last_wrong",     bench_setup_pin,     bench_pin_verify_last_wrong, 0 },
+    { "pin/create",                bench_setup_pin,     bench_pin_create,          0 },
+    { "room/unlock_cycle",         bench_setup_room,    bench_room_unlock_cycle,   0 },
+    { "room/update_idle",          bench_setup_room,    bench_room_update_idle,    0 },
+};
+
+const unsigned bench_case_count = sizeof(bench_cases) / sizeof(bench_cases[0]);
@@ -0,0 +1,29 @@
+/**
+ * @file fuzz.h
+ * @brief Contrato común de los objetivos de fuzzing del build de host.
+ *
+ * Cada objetivo implementa LLVMFuzzerTestOneInput(). Con clang se enlaza
+ * con libFuzzer (-fsanitize=fuzzer); con otros compiladores se enlaza con
+ * fuzz_driver.c, que reproduce archivos de corpus o genera entradas
+ * aleatorias y mide el rendimiento.
+ */
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+// Falla del invariante: aborta para que el fuzzer guarde la entrada
+#define FUZZ_ASSERT(cond) do { if (!(cond)) fuzz_fail(#cond, __FILE__, __LINE__); } while (0)
+
+static inline void fuzz_fail(const char *expr, const char *file, int line)
+{
+    fprintf(stderr, "%s:%d: invariante violado: %s\n", file, line, expr);
+    abort();
+}
+
+#endif // FUZZ_H
@@ -0,0 +1,52 @@
+/**
+ * @file fuzz_command_parser.c
+ * @brief Objetivo de fuzzing de command_parser_process_debug() y
+ * command_parser_process_esp01().
+ *
+ * FUZZ_PARSER_CHANNEL elige la entrada: 0 = USART2 (debug), 1 = USART3
+ * (ESP-01). Cada entrada parte de la placa recién encendida con la flash
+ * borrada y app_init() completo (configuración, usuarios, RTC, horario...),
+ * así lo que una entrada guardó con SET_* no cambia la siguiente. Después
+ * de los bytes se corre room_control_update() para despachar los eventos
+ * que hayan generado los comandos.
+ */
+#include "fuzz.h"
+#include "board_host.h"
+#include "hal_host.h"
+#include "command_parser.h"
+#include "room_control.h"
+#include "app.h"
+
+#ifndef FUZZ_PARSER_CHANNEL
+#define FUZZ_PARSER_CHANNEL 0
+#endif
+
+#if FUZZ_PARSER_CHANNEL == 0
+#define FUZZ_PARSER_FEED command_parser_process_debug
+#else
+#define FUZZ_PARSER_FEED command_parser_process_esp01
+#endif
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    // hal_host_reset() deja la flash como estaba: borrarla a mano
+    hal_host_flash_erase_all();
+    board_host_init();
+    hal_host_log_enable(false);
+    app_init();
+    command_parser_reset();
+
+    for (size_t i = 0; i < size; i++) {
+        FUZZ_PARSER_FEED(data[i]);
+    }
+    room_control_update(&room_system);
+
+    // Invariantes visibles desde fuera del parser
+    FUZZ_ASSERT(room_control_get_state(&room_system) <= ROOM_STATE_EMERGENCY);
+    FUZZ_ASSERT(room_control_get_fan_level(&room_system) <= FAN_LEVEL_HIGH);
+    FUZZ_ASSERT(room_control_get_fan_duty(&room_system) <= FAN_DUTY_MAX);
+
+    hal_host_uart_tx_clear(&huart2);
+    hal_host_uart_tx_clear(&huart3);
+    return 0;
+}
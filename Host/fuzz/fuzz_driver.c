@@ -0,0 +1,288 @@
+/**
+ * @file fuzz_driver.c
+ * @brief Reemplazo de libFuzzer para compiladores sin -fsanitize=fuzzer.
+ *
+ * Llama a LLVMFuzzerTestOneInput() con cada archivo (o cada archivo de
+ * cada directorio) de la línea de comandos; sin archivos genera entradas
+ * aleatorias. Al terminar informa ejecuciones/s y bytes/s, y la entrada
+ * más lenta. Una entrada que tarda más de --timeout-ms se guarda en
+ * slow-unit y termina con código 1; si un sanitizer aborta, la entrada en
+ * curso queda en crash-unit.
+ *
+ * Uso: fuzz_X [--runs N] [--max-len N] [--seed N] [--timeout-ms N]
+ *             [--dict ARCHIVO] [ARCHIVO|DIR ...]
+ */
+#include "fuzz.h"
+#include <dirent.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define FUZZ_DRIVER_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FUZZ_DRIVER_ASAN 1
+#endif
+#endif
+
+#ifdef FUZZ_DRIVER_ASAN
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#define FUZZ_DRIVER_MAX_INPUT   (64 * 1024)
+#define FUZZ_DRIVER_DICT_WORDS  128
+#define FUZZ_DRIVER_WORD_LEN    32
+#define FUZZ_DRIVER_PATH_LEN    512
+
+typedef struct {
+    uint8_t data[FUZZ_DRIVER_WORD_LEN];
+    size_t len;
+} fuzz_word_t;
+
+typedef struct {
+    uint64_t runs;
+    uint64_t bytes;
+    double elapsed_ns;
+    double slowest_ns;
+    char slowest_name[FUZZ_DRIVER_PATH_LEN];
+} fuzz_stats_t;
+
+static uint8_t input[FUZZ_DRIVER_MAX_INPUT];
+static size_t input_len;
+
+static fuzz_word_t dict[FUZZ_DRIVER_DICT_WORDS];
+static unsigned dict_count;
+
+static double timeout_ns;
+static uint64_t rng_state = 0x9E3779B97F4A7C15ull;
+
+/* Entradas -----------------------------------------------------------------*/
+
+static void save_input(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (f != NULL) {
+        fwrite(input, 1, input_len, f);
+        fclose(f);
+        fprintf(stderr, "entrada guardada en %s (%zu bytes)\n", path, input_len);
+    }
+}
+
+#ifdef FUZZ_DRIVER_ASAN
+static void on_sanitizer_death(void)
+{
+    save_input("crash-unit");
+}
+#endif
+
+static double clock_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static bool run_input(fuzz_stats_t *stats, const char *name)
+{
+    double start = clock_ns();
+    LLVMFuzzerTestOneInput(input, input_len);
+    double elapsed = clock_ns() - start;
+
+    stats->runs++;
+    stats->bytes += input_len;
+    stats->elapsed_ns += elapsed;
+    if (elapsed > stats->slowest_ns) {
+        stats->slowest_ns = elapsed;
+        snprintf(stats->slowest_name, sizeof(stats->slowest_name), "%s", name);
+    }
+    if (timeout_ns > 0.0 && elapsed > timeout_ns) {
+        fprintf(stderr, "entrada lenta: %s tardó %.1f ms\n", name, elapsed / 1e6);
+        save_input("slow-unit");
+        return false;
+    }
+    return true;
+}
+
+static bool run_file(fuzz_stats_t *stats, const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    input_len = fread(input, 1, sizeof(input), f);
+    fclose(f);
+    return run_input(stats, path);
+}
+
+static bool run_path(fuzz_stats_t *stats, const char *path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        perror(path);
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return run_file(stats, path);
+    }
+
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        perror(path);
+        return false;
+    }
+    bool ok = true;
+    struct dirent *entry;
+    while (ok && (entry = readdir(dir)) != NULL) {
+        char child[FUZZ_DRIVER_PATH_LEN];
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(child, sizeof(child), "%s/%s", path, entry->d_name);
+        if (stat(child, &st) == 0 && S_ISREG(st.st_mode)) {
+            ok = run_file(stats, child);
+        }
+    }
+    closedir(dir);
+    return ok;
+}
+
+/* Entradas aleatorias ------------------------------------------------------*/
+
+static uint32_t rng_next(void)
+{
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+// Bytes aleatorios con '\n' frecuentes y, si hay diccionario, palabras de él
+static void random_input(size_t max_len)
+{
+    size_t target = (max_len > 0) ? rng_next() % (max_len + 1) : 0;
+
+    input_len = 0;
+    while (input_len < target) {
+        uint32_t r = rng_next();
+        if (dict_count > 0 && (r & 0x3) == 0) {
+            const fuzz_word_t *w = &dict[(r >> 8) % dict_count];
+            size_t n = (w->len < target - input_len) ? w->len : target - input_len;
+            memcpy(&input[input_len], w->data, n);
+            input_len += n;
+        } else if ((r & 0xF) == 1) {
+            input[input_len++] = '\n';
+        } else {
+            input[input_len++] = (uint8_t)(r >> 16);
+        }
+    }
+}
+
+// Formato de diccionario de libFuzzer: [nombre=]"texto" con escapes \\ \" \xNN
+static bool load_dict(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL && dict_count < FUZZ_DRIVER_DICT_WORDS) {
+        char *p = strchr(line, '"');
+        if (line[0] == '#' || p == NULL) {
+            continue;
+        }
+        fuzz_word_t *w = &dict[dict_count];
+        w->len = 0;
+        for (p++; *p != '\0' && *p != '"' && w->len < FUZZ_DRIVER_WORD_LEN; p++) {
+            unsigned hex;
+            if (p[0] == '\\' && p[1] == 'x' && sscanf(&p[2], "%2x", &hex) == 1) {
+                w->data[w->len++] = (uint8_t)hex;
+                p += 3;
+            } else if (p[0] == '\\' && p[1] != '\0') {
+                w->data[w->len++] = (uint8_t)*++p;
+            } else {
+                w->data[w->len++] = (uint8_t)*p;
+            }
+        }
+        if (w->len > 0) {
+            dict_count++;
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+/* Main ---------------------------------------------------------------------*/
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "uso: %s [--runs N] [--max-len N] [--seed N] [--timeout-ms N]\n"
+            "          [--dict ARCHIVO] [ARCHIVO|DIR ...]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t runs = 100000;
+    size_t max_len = 256;
+    fuzz_stats_t stats = { 0 };
+    int first_path = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--max-len") == 0 && i + 1 < argc) {
+            max_len = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0) * 2 + 1;   // nunca 0
+        } else if (strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+            timeout_ns = atof(argv[++i]) * 1e6;
+        } else if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) {
+            if (!load_dict(argv[++i])) {
+                return 2;
+            }
+        } else if (argv[i][0] != '-') {
+            first_path = i;
+            break;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (max_len > FUZZ_DRIVER_MAX_INPUT) {
+        max_len = FUZZ_DRIVER_MAX_INPUT;
+    }
+
+#ifdef FUZZ_DRIVER_ASAN
+    __sanitizer_set_death_callback(on_sanitizer_death);
+#endif
+
+    bool ok = true;
+    if (first_path < argc) {
+        for (int i = first_path; ok && i < argc; i++) {
+            ok = run_path(&stats, argv[i]);
+        }
+    } else {
+        for (uint64_t r = 0; ok && r < runs; r++) {
+            char name[32];
+            snprintf(name, sizeof(name), "#%llu", (unsigned long long)r);
+            random_input(max_len);
+            ok = run_input(&stats, name);
+        }
+    }
+
+    double seconds = stats.elapsed_ns / 1e9;
+    fprintf(stderr, "%llu ejecuciones, %llu bytes en %.3f s: %.0f exec/s, %.0f bytes/s\n",
+            (unsigned long long)stats.runs, (unsigned long long)stats.bytes, seconds,
+            seconds > 0.0 ? (double)stats.runs / seconds : 0.0,
+            seconds > 0.0 ? (double)stats.bytes / seconds : 0.0);
+    if (stats.runs > 0) {
+        fprintf(stderr, "más lenta: %s (%.1f us)\n", stats.slowest_name, stats.slowest_ns / 1e3);
+    }
+    return ok ? 0 : 1;
+}
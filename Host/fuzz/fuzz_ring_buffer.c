@@ -0,0 +1,112 @@
+/**
+ * @file fuzz_ring_buffer.c
+ * @brief Objetivo de fuzzing de ring_buffer: secuencias de operaciones
+ * contrastadas con un modelo de referencia.
+ *
+ * El primer byte fija la capacidad (1..FUZZ_RING_MAX_CAPACITY); cada byte
+ * siguiente es una operación (bits bajos) y, en las escrituras, el byte a
+ * escribir. El modelo reproduce la semántica del driver: escribir con el
+ * buffer lleno descarta el dato más antiguo.
+ */
+#include "fuzz.h"
+#include "ring_buffer.h"
+#include <string.h>
+
+#define FUZZ_RING_MAX_CAPACITY 64
+
+typedef enum {
+    FUZZ_RING_WRITE = 0,   // 0..3: escrituras, las más frecuentes
+    FUZZ_RING_READ = 4,
+    FUZZ_RING_READ_ALL = 5,
+    FUZZ_RING_FLUSH = 6,
+    FUZZ_RING_QUERY = 7,
+} fuzz_ring_op_t;
+
+typedef struct {
+    uint8_t data[FUZZ_RING_MAX_CAPACITY];
+    uint16_t first;
+    uint16_t count;
+    uint16_t capacity;
+} fuzz_ring_model_t;
+
+static void model_write(fuzz_ring_model_t *m, uint8_t value)
+{
+    if (m->count == m->capacity) {
+        m->first = (m->first + 1) % m->capacity;
+        m->count--;
+    }
+    m->data[(m->first + m->count) % m->capacity] = value;
+    m->count++;
+}
+
+static int model_read(fuzz_ring_model_t *m, uint8_t *value)
+{
+    if (m->count == 0) {
+        return 0;
+    }
+    *value = m->data[m->first];
+    m->first = (m->first + 1) % m->capacity;
+    m->count--;
+    return 1;
+}
+
+static void check_read(ring_buffer_t *rb, fuzz_ring_model_t *m)
+{
+    uint8_t expected = 0;
+    uint8_t got = 0;
+    int has = model_read(m, &expected);
+
+    FUZZ_ASSERT(ring_buffer_read(rb, &got) == (has != 0));
+    if (has) {
+        FUZZ_ASSERT(got == expected);
+    }
+}
+
+static void check_query(ring_buffer_t *rb, const fuzz_ring_model_t *m)
+{
+    FUZZ_ASSERT(ring_buffer_count(rb) == m->count);
+    FUZZ_ASSERT(ring_buffer_is_empty(rb) == (m->count == 0));
+    FUZZ_ASSERT(ring_buffer_is_full(rb) == (m->count == m->capacity));
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    // Un byte más de almacenamiento como centinela contra escrituras fuera de rango
+    static uint8_t storage[FUZZ_RING_MAX_CAPACITY + 1];
+    ring_buffer_t rb;
+    fuzz_ring_model_t model;
+
+    if (size == 0) {
+        return 0;
+    }
+
+    memset(&model, 0, sizeof(model));
+    model.capacity = (uint16_t)(data[0] % FUZZ_RING_MAX_CAPACITY + 1);
+    storage[model.capacity] = 0xA5;
+    ring_buffer_init(&rb, storage, model.capacity);
+
+    for (size_t i = 1; i < size; i++) {
+        uint8_t op = data[i] & 0x07;
+
+        if (op < FUZZ_RING_READ) {
+            uint8_t value = (i + 1 < size) ? data[++i] : 0;
+            FUZZ_ASSERT(ring_buffer_write(&rb, value));
+            model_write(&model, value);
+        } else if (op == FUZZ_RING_READ) {
+            check_read(&rb, &model);
+        } else if (op == FUZZ_RING_READ_ALL) {
+            while (model.count > 0) {
+                check_read(&rb, &model);
+            }
+            check_read(&rb, &model);
+        } else if (op == FUZZ_RING_FLUSH) {
+            ring_buffer_flush(&rb);
+            model.first = 0;
+            model.count = 0;
+        }
+        check_query(&rb, &model);
+    }
+
+    FUZZ_ASSERT(storage[model.capacity] == 0xA5);
+    return 0;
+}
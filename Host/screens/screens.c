@@ -0,0 +1,247 @@
+/**
+ * @file screens.c
+ * @brief Volcado de las pantallas de room_control a PBM.
+ *
+ * Lleva la máquina de estados a cada room_state_t (y a casos límite:
+ * temperaturas negativas o fuera de rango, textos que no entran en los
+ * 128 px) y guarda ssd1306_GetBuffer() como DIR/<pantalla>.pbm.
+ *
+ * Con --compare REF se compara cada pantalla contra REF/<pantalla>.pbm
+ * (p. ej. un volcado hecho antes de un cambio de render) y se termina con
+ * código 1 si alguna difiere. Las referencias versionadas están en
+ * Host/screens/golden y ctest las compara en screens_golden.
+ *
+ * Uso: room_control_screens DIR [--compare REF] [--list]
+ */
+#include "board_host.h"
+#include "hal_host.h"
+#include "pbm.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define SCREENS_PATH_LEN 512
+
+typedef struct {
+    const char *name;
+    void (*render)(void);
+} screen_case_t;
+
+/* Helpers ------------------------------------------------------------------*/
+
+static void screens_keys(const char *keys)
+{
+    for (; *keys != '\0'; keys++) {
+        room_control_process_key(&room_system, *keys);
+        room_control_update(&room_system);
+    }
+}
+
+static void screens_temperature(float celsius)
+{
+    room_control_set_temperature(&room_system, celsius);
+    room_control_update(&room_system);
+}
+
+static void screens_unlocked(float celsius)
+{
+    screens_temperature(celsius);
+    screens_keys("2222");
+}
+
+/* Pantallas ----------------------------------------------------------------*/
+
+static void screen_locked(void)
+{
+    room_control_update(&room_system);
+}
+
+static void screen_input_empty(void)
+{
+    screens_keys("*");
+}
+
+static void screen_input_partial(void)
+{
+    screens_keys("22");
+}
+
+static void screen_input_full(void)
+{
+    // Tres dígitos: el cuarto confirmaría la clave
+    screens_keys("222");
+}
+
+static void screen_access_denied(void)
+{
+    screens_keys("1111");
+}
+
+static void screen_unlocked_off(void)
+{
+    screens_unlocked(22.5f);
+}
+
+static void screen_unlocked_low(void)
+{
+    screens_unlocked(26.0f);
+}
+
+static void screen_unlocked_med(void)
+{
+    screens_unlocked(29.0f);
+}
+
+static void screen_unlocked_high(void)
+{
+    screens_unlocked(35.0f);
+}
+
+static void screen_unlocked_manual(void)
+{
+    screens_unlocked(22.5f);
+    screens_keys("3");
+}
+
+static void screen_unlocked_pid(void)
+{
+    screens_unlocked(27.0f);
+    room_control_set_fan_mode(&room_system, FAN_MODE_PID);
+    room_control_update(&room_system);
+    hal_host_advance(1000);
+    room_control_update(&room_system);
+}
+
+static void screen_unlocked_negative(void)
+{
+    screens_unlocked(-12.3f);
+}
+
+static void screen_unlocked_over_range(void)
+{
+    // Máximo del ADC con el LM35 (3.3 V)
+    screens_unlocked(330.0f);
+}
+
+static void screen_unlocked_long_text(void)
+{
+    // "Temp: -1234.5C" no entra en la línea de 11x18
+    screens_unlocked(-1234.5f);
+}
+
+static void screen_emergency(void)
+{
+    screens_unlocked(22.5f);
+    screens_keys("D");
+}
+
+static const screen_case_t screen_cases[] = {
+    { "locked",                screen_locked },
+    { "input_empty",           screen_input_empty },
+    { "input_partial",         screen_input_partial },
+    { "input_full",            screen_input_full },
+    { "access_denied",         screen_access_denied },
+    { "unlocked_off",          screen_unlocked_off },
+    { "unlocked_low",          screen_unlocked_low },
+    { "unlocked_med",          screen_unlocked_med },
+    { "unlocked_high",         screen_unlocked_high },
+    { "unlocked_manual",       screen_unlocked_manual },
+    { "unlocked_pid",          screen_unlocked_pid },
+    { "unlocked_negative",     screen_unlocked_negative },
+    { "unlocked_over_range",   screen_unlocked_over_range },
+    { "unlocked_long_text",    screen_unlocked_long_text },
+    { "emergency",             screen_emergency },
+};
+
+#define SCREEN_CASE_COUNT (sizeof(screen_cases) / sizeof(screen_cases[0]))
+
+/* Runner -------------------------------------------------------------------*/
+
+// Cada pantalla parte de la placa recién encendida
+static void screens_boot(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    hal_host_set_tick(1000);
+    ssd1306_Init();
+    room_control_init(&room_system);
+}
+
+static void screens_usage(const char *argv0)
+{
+    fprintf(stderr, "uso: %s DIR [--compare REF] [--list]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_dir = NULL;
+    const char *ref_dir = NULL;
+    int list_only = 0;
+
+    // board_host_init() redirige stdout a USART2: guardar la consola real
+    FILE *console = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            ref_dir = argv[++i];
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list_only = 1;
+        } else if (argv[i][0] != '-' && out_dir == NULL) {
+            out_dir = argv[i];
+        } else {
+            screens_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (list_only) {
+        for (size_t i = 0; i < SCREEN_CASE_COUNT; i++) {
+            fprintf(console, "%s\n", screen_cases[i].name);
+        }
+        return 0;
+    }
+    if (out_dir == NULL) {
+        screens_usage(argv[0]);
+        return 2;
+    }
+    mkdir(out_dir, 0777);
+
+    unsigned differences = 0;
+    for (size_t i = 0; i < SCREEN_CASE_COUNT; i++) {
+        char path[SCREENS_PATH_LEN];
+
+        screens_boot();
+        screen_cases[i].render();
+
+        snprintf(path, sizeof(path), "%s/%s.pbm", out_dir, screen_cases[i].name);
+        if (!pbm_write(path, ssd1306_GetBuffer(), SSD1306_WIDTH, SSD1306_HEIGHT)) {
+            perror(path);
+            return 1;
+        }
+
+        if (ref_dir == NULL) {
+            fprintf(console, "%-24s %s\n", screen_cases[i].name, path);
+            continue;
+        }
+
+        static uint8_t reference[SSD1306_BUFFER_SIZE];
+        snprintf(path, sizeof(path), "%s/%s.pbm", ref_dir, screen_cases[i].name);
+        if (!pbm_read(path, reference, SSD1306_WIDTH, SSD1306_HEIGHT)) {
+            fprintf(console, "%-24s SIN REFERENCIA (%s)\n", screen_cases[i].name, path);
+            differences++;
+            continue;
+        }
+
+        size_t diff = pbm_diff(ssd1306_GetBuffer(), reference, SSD1306_WIDTH, SSD1306_HEIGHT);
+        if (diff != 0) {
+            fprintf(console, "%-24s DIFIERE en %zu píxeles\n", screen_cases[i].name, diff);
+            differences++;
+        } else {
+            fprintf(console, "%-24s igual\n", screen_cases[i].name);
+        }
+    }
+
+    if (ref_dir != NULL) {
+        fprintf(console, "%u de %zu pantallas difieren\n", differences, SCREEN_CASE_COUNT);
+    }
+    return differences != 0;
+}
@@ -0,0 +1,842 @@
+/**
+ * @file sim.c
+ * @brief Simulador del firmware completo sobre tiempo virtual.
+ *
+ * Corre app_init() y app_loop() de la aplicación real contra la HAL de host.
+ * Un guion indica cuándo llegan teclas del keypad, líneas por USART2, el
+ * botón B1 y la temperatura del LM35. Se capturan la salida de USART2, la
+ * traza del PWM del ventilador (TIM3->CCR1) y la pantalla reconstruida a
+ * partir del tráfico I2C.
+ *
+ * Uso: room_control_sim GUION [--step MS] [--idle-step MS] [--duration T]
+ *                      [--uart ARCHIVO|-] [--pwm ARCHIVO.csv] [--oled ARCHIVO]
+ *                      [--pbm DIR] [--flash ARCHIVO] [--esp ARCHIVO]
+ *                      [--speed X] [--quiet]
+ *
+ * Con --esp lo que el firmware transmite por USART3 (ESP-01) se escribe en
+ * ARCHIVO y lo que se lee de él llega a USART3 como recepción. Con el pty
+ * que crea Host/tools/esp_link_stub.py, el stub hace de esp-link. Como el
+ * stub responde en tiempo real, --speed X limita la simulación a X veces
+ * el tiempo real (sin --speed corre lo más rápido posible).
+ *
+ * Con --flash la flash emulada (y con ella la configuración guardada por
+ * config_store) persiste en ARCHIVO entre corridas; si no, arranca borrada.
+ *
+ * Con --pbm cada cuadro distinto que recibe el display se guarda como
+ * DIR/frame_<ms>.pbm.
+ *
+ * El tiempo avanza de a --step ms (1 por defecto) mientras hay algo en
+ * curso: teclas, rampa del ventilador, un plazo de room_control armado o
+ * una acción del guion cerca. El resto del tiempo avanza de a --idle-step
+ * ms (1000 por defecto), lo que permite simular días en segundos.
+ *
+ * Guion: una acción por línea, "<tiempo> <acción> [args]". El tiempo lleva
+ * sufijo ms, s, m o h (sin sufijo = ms) y con '+' es relativo a la línea
+ * anterior. Las líneas que empiezan con '#' son comentarios ('#' también es
+ * una tecla del keypad).
+ *
+ *   0      temp 22.5            temperatura del LM35
+ *   10s    temp 35 2m           rampa lineal hasta 35 °C en 2 minutos
+ *   +1s    key 1234             teclas separadas SIM_KEY_GAP_MS
+ *   +1s    uart GET_STATUS      línea por USART2 (se agrega '\n')
+ *   +1s    button               EXTI del botón B1
+ *   0      rtc 100              error del cristal del LSE en ppm (+ adelanta)
+ *   +1s    expect state UNLOCKED
+ *   +0     expect fan 70        nivel del ventilador (0, 30, 70, 100)
+ *   +0     expect uart OK:      texto en la salida de USART2 desde el último expect uart
+ *   2h     end
+ *
+ * Termina con código 1 si algún expect falla.
+ */
+#include "board_host.h"
+#include "hal_host.h"
+#include "fan_ramp.h"
+#include "fan_pwm.h"
+#include "sim_oled.h"
+#include "pbm.h"
+#include "tlog_host.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_LINE_LEN        256
+#define SIM_KEY_GAP_MS      250     // > 100 ms de bloqueo de keypad_scan() + 150 ms de filtro
+#define SIM_DEFAULT_STEP_MS 1
+#define SIM_DEFAULT_IDLE_MS 1000
+#define SIM_UART_WINDOW     8192    // Salida reciente que revisa "expect uart"
+#define SIM_DEFAULT_TEMP_C  22.0f
+
+typedef enum {
+    SIM_ACT_TEMP,
+    SIM_ACT_KEY,
+    SIM_ACT_UART,
+    SIM_ACT_BUTTON,
+    SIM_ACT_RTC_PPM,
+    SIM_ACT_EXPECT_STATE,
+    SIM_ACT_EXPECT_FAN,
+    SIM_ACT_EXPECT_UART,
+    SIM_ACT_END
+} sim_action_type_t;
+
+typedef struct {
+    uint64_t time_ms;
+    sim_action_type_t type;
+    unsigned line;
+    float value;
+    uint64_t ramp_ms;
+    char text[SIM_LINE_LEN];
+} sim_action_t;
+
+static struct {
+    sim_action_t *actions;
+    size_t count;
+    size_t capacity;
+} script;
+
+static struct {
+    uint64_t now_ms;          // Tiempo virtual de 64 bits (el tick de la HAL es de 32)
+    uint32_t step_ms;
+    uint32_t idle_step_ms;
+    uint32_t settle_events;   // Updates de TIM3 que faltan para que el DMA quede en el valor final
+    FILE *console;
+    FILE *uart_out;
+    FILE *pwm_out;
+    FILE *oled_out;
+    int esp_fd;
+    uint64_t esp_bytes;
+    double speed;
+    struct timespec wall_start;
+    const char *pbm_dir;
+    bool quiet;
+    bool uart_line_start;
+
+    // Temperatura: valor actual y rampa en curso
+    float temp_c;
+    float ramp_from, ramp_to;
+    uint64_t ramp_start, ramp_ms;
+
+    // Tecla pulsada (fila/columna) y teclas pendientes del guion
+    int key_row, key_col;
+    char keys[SIM_LINE_LEN];
+    size_t key_next;
+    uint64_t key_time;
+
+    uint32_t last_ccr, last_arr;
+    bool pwm_started;
+
+    char uart_window[SIM_UART_WINDOW];
+    size_t uart_window_len;
+    tlog_host_stream_t tlog;
+
+    unsigned expects;
+    unsigned failures;
+    uint64_t loops;
+} sim = {
+    .step_ms = SIM_DEFAULT_STEP_MS,
+    .idle_step_ms = SIM_DEFAULT_IDLE_MS,
+    .key_row = -1,
+    .key_col = -1,
+    .esp_fd = -1
+};
+
+static const char *const sim_state_names[ROOM_STATE_COUNT] = {
+    [ROOM_STATE_LOCKED]         = "LOCKED",
+    [ROOM_STATE_UNLOCKED]       = "UNLOCKED",
+    [ROOM_STATE_INPUT_PASSWORD] = "INPUT_PASSWORD",
+    [ROOM_STATE_ACCESS_DENIED]  = "ACCESS_DENIED",
+    [ROOM_STATE_EMERGENCY]      = "EMERGENCY",
+};
+
+static const char sim_keymap[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'}
+};
+
+/* Guion --------------------------------------------------------------------*/
+
+// "250", "250ms", "2s", "5m", "3h" -> ms; false si no es un tiempo válido
+static bool sim_parse_time(const char *s, uint64_t *ms)
+{
+    char *end;
+    double v = strtod(s, &end);
+
+    if (end == s || v < 0.0) {
+        return false;
+    }
+    if (*end == '\0' || strcmp(end, "ms") == 0) {
+        *ms = (uint64_t)v;
+    } else if (strcmp(end, "s") == 0) {
+        *ms = (uint64_t)(v * 1000.0);
+    } else if (strcmp(end, "m") == 0) {
+        *ms = (uint64_t)(v * 60000.0);
+    } else if (strcmp(end, "h") == 0) {
+        *ms = (uint64_t)(v * 3600000.0);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool sim_parse_state(const char *name, float *value)
+{
+    for (int i = 0; i < ROOM_STATE_COUNT; i++) {
+        if (strcmp(name, sim_state_names[i]) == 0) {
+            *value = (float)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static sim_action_t *sim_add_action(void)
+{
+    if (script.count == script.capacity) {
+        size_t capacity = script.capacity ? script.capacity * 2 : 64;
+        sim_action_t *actions = realloc(script.actions, capacity * sizeof(sim_action_t));
+        if (actions == NULL) {
+            return NULL;
+        }
+        script.actions = actions;
+        script.capacity = capacity;
+    }
+    sim_action_t *a = &script.actions[script.count++];
+    memset(a, 0, sizeof(*a));
+    return a;
+}
+
+static bool sim_parse_line(char *line, unsigned line_no, uint64_t *last_ms)
+{
+    char *p = line;
+    while (isspace((unsigned char)*p)) {
+        p++;
+    }
+    if (*p == '#') {
+        return true;
+    }
+
+    char *time_tok = strtok(line, " \t\r\n");
+    if (time_tok == NULL) {
+        return true;
+    }
+    char *verb = strtok(NULL, " \t\r\n");
+    char *rest = strtok(NULL, "\r\n");
+    if (rest != NULL) {
+        while (isspace((unsigned char)*rest)) {
+            rest++;
+        }
+        size_t len = strlen(rest);
+        while (len > 0 && isspace((unsigned char)rest[len - 1])) {
+            rest[--len] = '\0';
+        }
+    }
+
+    bool relative = (time_tok[0] == '+');
+    uint64_t t;
+    if (!sim_parse_time(relative ? time_tok + 1 : time_tok, &t) || verb == NULL) {
+        fprintf(stderr, "guion:%u: se esperaba \"<tiempo> <acción>\"\n", line_no);
+        return false;
+    }
+    t = relative ? *last_ms + t : t;
+    if (t < *last_ms) {
+        fprintf(stderr, "guion:%u: el tiempo retrocede\n", line_no);
+        return false;
+    }
+    *last_ms = t;
+
+    sim_action_t *a = sim_add_action();
+    if (a == NULL) {
+        return false;
+    }
+    a->time_ms = t;
+    a->line = line_no;
+
+    if (strcmp(verb, "temp") == 0 && rest != NULL) {
+        char *ramp = NULL;
+        a->type = SIM_ACT_TEMP;
+        a->value = strtof(rest, &ramp);
+        while (ramp != NULL && isspace((unsigned char)*ramp)) {
+            ramp++;
+        }
+        if (ramp != NULL && *ramp != '\0' && !sim_parse_time(ramp, &a->ramp_ms)) {
+            fprintf(stderr, "guion:%u: duración de rampa inválida\n", line_no);
+            return false;
+        }
+    } else if (strcmp(verb, "key") == 0 && rest != NULL) {
+        a->type = SIM_ACT_KEY;
+        snprintf(a->text, sizeof(a->text), "%s", rest);
+    } else if (strcmp(verb, "uart") == 0 && rest != NULL) {
+        a->type = SIM_ACT_UART;
+        snprintf(a->text, sizeof(a->text), "%s", rest);
+    } else if (strcmp(verb, "button") == 0) {
+        a->type = SIM_ACT_BUTTON;
+    } else if (strcmp(verb, "rtc") == 0 && rest != NULL) {
+        a->type = SIM_ACT_RTC_PPM;
+        a->value = strtof(rest, NULL);
+    } else if (strcmp(verb, "end") == 0) {
+        a->type = SIM_ACT_END;
+    } else if (strcmp(verb, "expect") == 0 && rest != NULL) {
+        if (strncmp(rest, "state ", 6) == 0 && sim_parse_state(rest + 6, &a->value)) {
+            a->type = SIM_ACT_EXPECT_STATE;
+        } else if (strncmp(rest, "fan ", 4) == 0) {
+            a->type = SIM_ACT_EXPECT_FAN;
+            a->value = strtof(rest + 4, NULL);
+        } else if (strncmp(rest, "uart ", 5) == 0) {
+            a->type = SIM_ACT_EXPECT_UART;
+            snprintf(a->text, sizeof(a->text), "%s", rest + 5);
+        } else {
+            fprintf(stderr, "guion:%u: expect state|fan|uart\n", line_no);
+            return false;
+        }
+    } else {
+        fprintf(stderr, "guion:%u: acción desconocida \"%s\"\n", line_no, verb);
+        return false;
+    }
+    return true;
+}
+
+static bool sim_load_script(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+
+    char line[SIM_LINE_LEN];
+    unsigned line_no = 0;
+    uint64_t last_ms = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f) != NULL) {
+        ok = sim_parse_line(line, ++line_no, &last_ms);
+    }
+    fclose(f);
+    return ok;
+}
+
+/* Entradas -----------------------------------------------------------------*/
+
+// LM35 de 10 mV/°C sobre un ADC de 12 bits con Vref = 3.3 V
+static void sim_apply_temperature(float celsius)
+{
+    float raw = celsius / 330.0f * 4095.0f;
+    if (raw < 0.0f) {
+        raw = 0.0f;
+    } else if (raw > 4095.0f) {
+        raw = 4095.0f;
+    }
+    hal_host_adc_set_value((uint32_t)(raw + 0.5f));
+}
+
+static void sim_update_temperature(void)
+{
+    if (sim.ramp_ms == 0) {
+        return;
+    }
+
+    uint64_t elapsed = sim.now_ms - sim.ramp_start;
+    if (elapsed >= sim.ramp_ms) {
+        sim.temp_c = sim.ramp_to;
+        sim.ramp_ms = 0;
+    } else {
+        sim.temp_c = sim.ramp_from + (sim.ramp_to - sim.ramp_from) * (float)elapsed / (float)sim.ramp_ms;
+    }
+    sim_apply_temperature(sim.temp_c);
+}
+
+/*
+ * Teclado matricial: la columna de la tecla pulsada lee 0 cuando su fila
+ * está en 0. La tecla se suelta en cuanto keypad_scan() la detecta para no
+ * quedar en su espera de liberación.
+ */
+static GPIO_PinState sim_gpio_read(GPIO_TypeDef *port, uint16_t pin)
+{
+    if (sim.key_row < 0 ||
+        port != keypad.col_ports[sim.key_col] || pin != keypad.col_pins[sim.key_col]) {
+        return GPIO_PIN_SET;
+    }
+
+    if (hal_host_gpio_get_output(keypad.row_ports[sim.key_row], keypad.row_pins[sim.key_row]) == GPIO_PIN_RESET) {
+        sim.key_row = -1;
+        return GPIO_PIN_RESET;
+    }
+    return GPIO_PIN_SET;
+}
+
+static void sim_press_key(char key)
+{
+    for (int r = 0; r < 4; r++) {
+        for (int c = 0; c < 4; c++) {
+            if (sim_keymap[r][c] == key) {
+                sim.key_row = r;
+                sim.key_col = c;
+                HAL_GPIO_EXTI_Callback(keypad.col_pins[c]);
+                return;
+            }
+        }
+    }
+    fprintf(stderr, "sim: tecla desconocida '%c'\n", key);
+}
+
+static void sim_update_keys(void)
+{
+    if (sim.keys[sim.key_next] != '\0' && sim.now_ms >= sim.key_time) {
+        sim_press_key(sim.keys[sim.key_next++]);
+        sim.key_time = sim.now_ms + SIM_KEY_GAP_MS;
+    }
+}
+
+/* Salidas ------------------------------------------------------------------*/
+
+static void sim_print_time(FILE *out, uint64_t ms)
+{
+    fprintf(out, "[%02llu:%02llu:%02llu.%03llu] ",
+            (unsigned long long)(ms / 3600000u), (unsigned long long)(ms / 60000u % 60u),
+            (unsigned long long)(ms / 1000u % 60u), (unsigned long long)(ms % 1000u));
+}
+
+static void sim_uart_char(char ch)
+{
+    if (sim.uart_out != NULL && ch != '\r') {
+        if (sim.uart_line_start) {
+            sim_print_time(sim.uart_out, sim.now_ms);
+            sim.uart_line_start = false;
+        }
+        fputc(ch, sim.uart_out);
+        sim.uart_line_start = (ch == '\n');
+    }
+
+    // Ventana deslizante para "expect uart"
+    if (sim.uart_window_len == SIM_UART_WINDOW - 1) {
+        memmove(sim.uart_window, sim.uart_window + SIM_UART_WINDOW / 2, SIM_UART_WINDOW / 2);
+        sim.uart_window_len -= SIM_UART_WINDOW / 2;
+    }
+    sim.uart_window[sim.uart_window_len++] = ch;
+    sim.uart_window[sim.uart_window_len] = '\0';
+}
+
+// Salida de USART2 con las tramas de TLOG() ya convertidas a texto
+static void sim_collect_uart(void)
+{
+    size_t size = hal_host_uart_tx_size(&huart2);
+    const uint8_t *data = hal_host_uart_tx_data(&huart2);
+    char text[256];
+
+    if (size == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        size_t n = tlog_host_feed(&sim.tlog, data[i], text, sizeof(text));
+        for (size_t k = 0; k < n; k++) {
+            sim_uart_char(text[k]);
+        }
+    }
+    hal_host_uart_tx_clear(&huart2);
+}
+
+// USART3 <-> --esp: TX tal cual hacia el archivo, lo disponible en él hacia RX
+static void sim_exchange_esp(void)
+{
+    size_t size = hal_host_uart_tx_size(&huart3);
+    const uint8_t *data = hal_host_uart_tx_data(&huart3);
+
+    if (sim.esp_fd < 0) {
+        hal_host_uart_tx_clear(&huart3);
+        return;
+    }
+
+    for (size_t sent = 0; sent < size;) {
+        ssize_t n = write(sim.esp_fd, &data[sent], size - sent);
+        if (n <= 0) {
+            break;
+        }
+        sent += (size_t)n;
+    }
+    sim.esp_bytes += size;
+    hal_host_uart_tx_clear(&huart3);
+
+    struct pollfd pfd = { .fd = sim.esp_fd, .events = POLLIN };
+    uint8_t rx[64];
+    while (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        ssize_t n = read(sim.esp_fd, rx, sizeof(rx));
+        if (n <= 0) {
+            break;
+        }
+        hal_host_uart_inject(&huart3, rx, (size_t)n);
+    }
+}
+
+static void sim_collect_pwm(void)
+{
+    uint32_t ccr = TIM3->CCR1;
+    uint32_t arr = TIM3->ARR;
+
+    if (sim.pwm_out == NULL || (sim.pwm_started && ccr == sim.last_ccr && arr == sim.last_arr)) {
+        return;
+    }
+    fprintf(sim.pwm_out, "%llu,%lu,%lu,%.2f\n", (unsigned long long)sim.now_ms,
+            (unsigned long)ccr, (unsigned long)arr, 100.0 * ccr / (arr + 1));
+    sim.last_ccr = ccr;
+    sim.last_arr = arr;
+    sim.pwm_started = true;
+}
+
+static void sim_collect_oled(void)
+{
+    if ((sim.oled_out == NULL && sim.pbm_dir == NULL) || !sim_oled_take_dirty()) {
+        return;
+    }
+
+    if (sim.oled_out != NULL) {
+        sim_print_time(sim.oled_out, sim.now_ms);
+        fprintf(sim.oled_out, "\n");
+        sim_oled_print(sim.oled_out);
+    }
+    if (sim.pbm_dir != NULL) {
+        char path[SIM_LINE_LEN * 2];
+        snprintf(path, sizeof(path), "%s/frame_%09llu.pbm", sim.pbm_dir, (unsigned long long)sim.now_ms);
+        if (!pbm_write(path, sim_oled_ram(), SIM_OLED_WIDTH, SIM_OLED_HEIGHT)) {
+            perror(path);
+            sim.pbm_dir = NULL;
+        }
+    }
+}
+
+/* Acciones -----------------------------------------------------------------*/
+
+static void sim_expect_failed(const sim_action_t *a, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void sim_expect_failed(const sim_action_t *a, const char *fmt, ...)
+{
+    va_list args;
+
+    sim.failures++;
+    sim_print_time(sim.console, sim.now_ms);
+    fprintf(sim.console, "FALLO guion:%u: ", a->line);
+    va_start(args, fmt);
+    vfprintf(sim.console, fmt, args);
+    va_end(args);
+    fprintf(sim.console, "\n");
+}
+
+// Ejecuta una acción; devuelve false con "end"
+static bool sim_run_action(const sim_action_t *a)
+{
+    switch (a->type) {
+        case SIM_ACT_TEMP:
+            if (a->ramp_ms == 0) {
+                sim.temp_c = a->value;
+                sim.ramp_ms = 0;
+                sim_apply_temperature(sim.temp_c);
+            } else {
+                sim.ramp_from = sim.temp_c;
+                sim.ramp_to = a->value;
+                sim.ramp_start = sim.now_ms;
+                sim.ramp_ms = a->ramp_ms;
+            }
+            break;
+
+        case SIM_ACT_KEY:
+            snprintf(sim.keys, sizeof(sim.keys), "%s", a->text);
+            sim.key_next = 0;
+            sim.key_time = sim.now_ms;
+            break;
+
+        case SIM_ACT_UART: {
+            char line[SIM_LINE_LEN + 1];
+            int len = snprintf(line, sizeof(line), "%s\n", a->text);
+            hal_host_uart_inject(&huart2, (const uint8_t *)line, (size_t)len);
+            break;
+        }
+
+        case SIM_ACT_BUTTON:
+            HAL_GPIO_EXTI_Callback(B1_Pin);
+            break;
+
+        case SIM_ACT_RTC_PPM:
+            hal_host_rtc_set_error_ppm(a->value);
+            break;
+
+        case SIM_ACT_EXPECT_STATE: {
+            room_state_t st = room_control_get_state(&room_system);
+            sim.expects++;
+            if ((int)st != (int)a->value) {
+                sim_expect_failed(a, "estado %s, se esperaba %s",
+                                  sim_state_names[st], sim_state_names[(int)a->value]);
+            }
+            break;
+        }
+
+        case SIM_ACT_EXPECT_FAN: {
+            fan_level_t fan = room_control_get_fan_level(&room_system);
+            sim.expects++;
+            if ((int)fan != (int)a->value) {
+                sim_expect_failed(a, "ventilador %d, se esperaba %d", (int)fan, (int)a->value);
+            }
+            break;
+        }
+
+        case SIM_ACT_EXPECT_UART:
+            sim.expects++;
+            if (strstr(sim.uart_window, a->text) == NULL) {
+                sim_expect_failed(a, "no apareció \"%s\" en USART2", a->text);
+            }
+            sim.uart_window_len = 0;
+            sim.uart_window[0] = '\0';
+            break;
+
+        case SIM_ACT_END:
+            return false;
+    }
+    return true;
+}
+
+/* Bucle principal ----------------------------------------------------------*/
+
+// Con --speed espera hasta que el reloj real alcance now_ms / speed
+static void sim_pace(void)
+{
+    if (sim.speed <= 0.0) {
+        return;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed_ms = (double)(now.tv_sec - sim.wall_start.tv_sec) * 1e3 +
+                        (double)(now.tv_nsec - sim.wall_start.tv_nsec) / 1e6;
+    double ahead_ms = (double)sim.now_ms / sim.speed - elapsed_ms;
+    if (ahead_ms > 0.0) {
+        struct timespec wait = {
+            .tv_sec = (time_t)(ahead_ms / 1e3),
+            .tv_nsec = (long)((ahead_ms - (double)(time_t)(ahead_ms / 1e3) * 1e3) * 1e6)
+        };
+        nanosleep(&wait, NULL);
+    }
+}
+
+/*
+ * Eventos de update de TIM3 en step_ms. Solo hacen falta mientras el DMA
+ * recorre una rampa; después de dos vueltas del buffer circular ya está
+ * entero en el valor final y CCR1 no cambia más.
+ */
+static void sim_advance_timer(uint32_t step_ms)
+{
+    uint64_t events = (uint64_t)fan_pwm_get_frequency(&htim3) * step_ms / 1000u;
+
+    if (fan_ramp_is_active()) {
+        sim.settle_events = 2 * FAN_RAMP_BUFFER_LEN;
+    } else {
+        if (events > sim.settle_events) {
+            events = sim.settle_events;
+        }
+        sim.settle_events -= (uint32_t)events;
+    }
+    if (events > 0) {
+        hal_host_tim_update(&htim3, (uint32_t)events);
+    }
+}
+
+// Paso fino si hay algo en curso; si no, el paso largo sin pasarse de la próxima acción
+static uint32_t sim_next_step(uint64_t next_action_ms)
+{
+    bool busy = sim.keys[sim.key_next] != '\0' || sim.key_row >= 0 ||
+                fan_ramp_is_active() || sim.settle_events > 0 ||
+                room_system.timeout_armed;
+    uint64_t step = busy ? sim.step_ms : sim.idle_step_ms;
+
+    if (step < sim.step_ms) {
+        step = sim.step_ms;
+    }
+    if (next_action_ms > sim.now_ms && next_action_ms - sim.now_ms < step) {
+        step = next_action_ms - sim.now_ms;
+    }
+    return (uint32_t)step;
+}
+
+static uint64_t sim_run(uint64_t duration_ms)
+{
+    size_t next = 0;
+
+    for (;;) {
+        while (next < script.count && script.actions[next].time_ms <= sim.now_ms) {
+            if (!sim_run_action(&script.actions[next++])) {
+                return sim.now_ms;
+            }
+        }
+        if (sim.now_ms >= duration_ms && next >= script.count) {
+            return sim.now_ms;
+        }
+
+        sim_update_temperature();
+        sim_update_keys();
+
+        app_loop();
+        sim.loops++;
+
+        sim_collect_uart();
+        sim_exchange_esp();
+        sim_collect_pwm();
+        sim_collect_oled();
+
+        uint32_t step = sim_next_step(next < script.count ? script.actions[next].time_ms : UINT64_MAX);
+        sim.now_ms += step;
+        hal_host_advance(step);
+        sim_advance_timer(step);
+        sim_pace();
+    }
+}
+
+static void sim_usage(const char *argv0)
+{
+    fprintf(stderr,
+            "uso: %s GUION [--step MS] [--idle-step MS] [--duration T]\n"
+            "          [--uart ARCHIVO|-] [--pwm ARCHIVO.csv] [--oled ARCHIVO] [--pbm DIR]\n"
+            "          [--flash ARCHIVO] [--esp ARCHIVO] [--speed X] [--quiet]\n", argv0);
+}
+
+static FILE *sim_open(const char *path, FILE *console)
+{
+    if (strcmp(path, "-") == 0) {
+        return console;
+    }
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+    }
+    return f;
+}
+
+int main(int argc, char **argv)
+{
+    const char *script_path = NULL;
+    const char *uart_path = "-";
+    const char *pwm_path = NULL;
+    const char *oled_path = NULL;
+    const char *flash_path = NULL;
+    const char *esp_path = NULL;
+    uint64_t duration_ms = 0;
+
+    // board_host_init() redirige stdout a USART2: guardar la consola real
+    sim.console = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--step") == 0 && i + 1 < argc) {
+            sim.step_ms = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--idle-step") == 0 && i + 1 < argc) {
+            sim.idle_step_ms = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            if (!sim_parse_time(argv[++i], &duration_ms)) {
+                sim_usage(argv[0]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--uart") == 0 && i + 1 < argc) {
+            uart_path = argv[++i];
+        } else if (strcmp(argv[i], "--pwm") == 0 && i + 1 < argc) {
+            pwm_path = argv[++i];
+        } else if (strcmp(argv[i], "--oled") == 0 && i + 1 < argc) {
+            oled_path = argv[++i];
+        } else if (strcmp(argv[i], "--pbm") == 0 && i + 1 < argc) {
+            sim.pbm_dir = argv[++i];
+        } else if (strcmp(argv[i], "--flash") == 0 && i + 1 < argc) {
+            flash_path = argv[++i];
+        } else if (strcmp(argv[i], "--esp") == 0 && i + 1 < argc) {
+            esp_path = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            sim.speed = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--quiet") == 0) {
+            sim.quiet = true;
+            uart_path = NULL;
+        } else if (argv[i][0] != '-' && script_path == NULL) {
+            script_path = argv[i];
+        } else {
+            sim_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (script_path == NULL || sim.step_ms == 0 || !sim_load_script(script_path)) {
+        sim_usage(argv[0]);
+        return 2;
+    }
+
+    if (uart_path != NULL && (sim.uart_out = sim_open(uart_path, sim.console)) == NULL) {
+        return 1;
+    }
+    if (pwm_path != NULL) {
+        if ((sim.pwm_out = sim_open(pwm_path, sim.console)) == NULL) {
+            return 1;
+        }
+        fprintf(sim.pwm_out, "t_ms,ccr,arr,duty_pct\n");
+    }
+    if (oled_path != NULL && (sim.oled_out = sim_open(oled_path, sim.console)) == NULL) {
+        return 1;
+    }
+    if (flash_path != NULL && !hal_host_flash_attach(flash_path)) {
+        perror(flash_path);
+        return 1;
+    }
+    if (esp_path != NULL &&
+        (sim.esp_fd = open(esp_path, O_RDWR | O_CREAT | O_TRUNC | O_NOCTTY, 0644)) < 0) {
+        perror(esp_path);
+        return 1;
+    }
+    sim.uart_line_start = true;
+
+    // Placa recién encendida
+    board_host_init();
+    hal_host_log_enable(false);
+    hal_host_gpio_set_read_hook(sim_gpio_read);
+    sim_oled_reset();
+    hal_host_i2c_set_write_hook(sim_oled_i2c_write);
+    sim.temp_c = SIM_DEFAULT_TEMP_C;
+    sim_apply_temperature(sim.temp_c);
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    sim.wall_start = t0;
+
+    app_init();
+    uint64_t end_ms = sim_run(duration_ms);
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double wall_s = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    sim_collect_uart();
+    sim_exchange_esp();
+    if (!sim.quiet) {
+        fprintf(sim.console, "\n");
+        sim_print_time(sim.console, end_ms);
+        fprintf(sim.console, "estado=%s ventilador=%d temp=%.1fC\n",
+                sim_state_names[room_control_get_state(&room_system)],
+                (int)room_control_get_fan_level(&room_system), sim.temp_c);
+        sim_oled_print(sim.console);
+    }
+    fprintf(sim.console, "sim: %.2f h simuladas en %.3f s (%.0f h/s), %llu vueltas, "
+            "%u expect, %u fallos\n",
+            (double)end_ms / 3600000.0, wall_s,
+            wall_s > 0.0 ? (double)end_ms / 3600000.0 / wall_s : 0.0,
+            (unsigned long long)sim.loops, sim.expects, sim.failures);
+
+    if (sim.pwm_out != NULL && sim.pwm_out != sim.console) {
+        fclose(sim.pwm_out);
+    }
+    if (sim.oled_out != NULL && sim.oled_out != sim.console) {
+        fclose(sim.oled_out);
+    }
+    if (sim.uart_out != NULL && sim.uart_out != sim.console) {
+        fclose(sim.uart_out);
+    }
+    if (sim.esp_fd >= 0) {
+        fprintf(sim.console, "sim: %llu bytes por USART3\n", (unsigned long long)sim.esp_bytes);
+        close(sim.esp_fd);
+    }
+    free(script.actions);
+    return sim.failures != 0;
+}
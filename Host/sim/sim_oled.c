@@ -0,0 +1,198 @@
+/**
+ * @file sim_oled.c
+ * @brief Decodificador del flujo de comandos/datos del SSD1306.
+ *
+ * Sigue el puntero de página/columna (modos de direccionamiento horizontal
+ * y por página) para que la pantalla capturada sea la que produce el
+ * driver real, no una copia de su framebuffer.
+ */
+#include "sim_oled.h"
+#include "ssd1306.h"
+#include <string.h>
+
+#define SIM_OLED_MODE_HORIZONTAL 0x00
+#define SIM_OLED_MODE_VERTICAL   0x01
+#define SIM_OLED_MODE_PAGE       0x02
+
+static struct {
+    uint8_t ram[SIM_OLED_PAGES][SIM_OLED_WIDTH];
+    uint8_t mode;
+    uint8_t page, col;
+    uint8_t col_start, col_end;
+    uint8_t page_start, page_end;
+    bool on;
+    bool dirty;
+
+    // Comando de varios bytes en curso
+    uint8_t cmd;
+    uint8_t args[6];
+    uint8_t args_len;
+    uint8_t args_needed;
+} oled;
+
+void sim_oled_reset(void)
+{
+    memset(&oled, 0, sizeof(oled));
+    oled.mode = SIM_OLED_MODE_PAGE;
+    oled.col_end = SIM_OLED_WIDTH - 1;
+    oled.page_end = SIM_OLED_PAGES - 1;
+}
+
+// Bytes de argumento de cada comando (datasheet SSD1306, tabla 9-1)
+static uint8_t sim_oled_arg_count(uint8_t cmd)
+{
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void sim_oled_execute(void)
+{
+    uint8_t c = oled.cmd;
+
+    if (c == 0x20) {
+        oled.mode = oled.args[0] & 0x03;
+    } else if (c == 0x21) {
+        oled.col_start = oled.args[0] & 0x7F;
+        oled.col_end = oled.args[1] & 0x7F;
+        oled.col = oled.col_start;
+    } else if (c == 0x22) {
+        oled.page_start = oled.args[0] & 0x07;
+        oled.page_end = oled.args[1] & 0x07;
+        oled.page = oled.page_start;
+    } else if (c <= 0x0F) {
+        oled.col = (uint8_t)((oled.col & 0xF0) | c);
+    } else if (c >= 0x10 && c <= 0x1F) {
+        oled.col = (uint8_t)((oled.col & 0x0F) | ((c & 0x07) << 4));
+    } else if (c >= 0xB0 && c <= 0xB7) {
+        oled.page = c & 0x07;
+    } else if (c == 0xAE || c == 0xAF) {
+        oled.on = (c == 0xAF);
+        oled.dirty = true;
+    }
+}
+
+static void sim_oled_command(uint8_t byte)
+{
+    if (oled.args_needed > 0) {
+        oled.args[oled.args_len++] = byte;
+        if (oled.args_len == oled.args_needed) {
+            oled.args_needed = 0;
+            sim_oled_execute();
+        }
+        return;
+    }
+
+    oled.cmd = byte;
+    oled.args_len = 0;
+    oled.args_needed = sim_oled_arg_count(byte);
+    if (oled.args_needed == 0) {
+        sim_oled_execute();
+    }
+}
+
+static void sim_oled_data(uint8_t byte)
+{
+    uint8_t *cell = &oled.ram[oled.page % SIM_OLED_PAGES][oled.col % SIM_OLED_WIDTH];
+    if (*cell != byte) {
+        *cell = byte;
+        oled.dirty = true;
+    }
+
+    switch (oled.mode) {
+        case SIM_OLED_MODE_HORIZONTAL:
+            if (oled.col++ >= oled.col_end) {
+                oled.col = oled.col_start;
+                oled.page = (oled.page >= oled.page_end) ? oled.page_start : oled.page + 1;
+            }
+            break;
+        case SIM_OLED_MODE_VERTICAL:
+            if (oled.page++ >= oled.page_end) {
+                oled.page = oled.page_start;
+                oled.col = (oled.col >= oled.col_end) ? oled.col_start : oled.col + 1;
+            }
+            break;
+        default:
+            // Modo página: la columna da la vuelta dentro de la misma página
+            oled.col = (oled.col + 1) % SIM_OLED_WIDTH;
+            break;
+    }
+}
+
+void sim_oled_i2c_write(uint16_t address, uint16_t mem_address, const uint8_t *data, uint16_t size)
+{
+    if (address != SSD1306_I2C_ADDR) {
+        return;
+    }
+
+    // Byte de control: D/C# (bit 6) elige datos o comandos; Co = 0 en todo el driver
+    bool is_data = (mem_address & 0x40) != 0;
+    for (uint16_t i = 0; i < size; i++) {
+        if (is_data) {
+            sim_oled_data(data[i]);
+        } else {
+            sim_oled_command(data[i]);
+        }
+    }
+}
+
+bool sim_oled_pixel(uint8_t x, uint8_t y)
+{
+    if (x >= SIM_OLED_WIDTH || y >= SIM_OLED_HEIGHT) {
+        return false;
+    }
+    return (oled.ram[y / 8][x] >> (y % 8)) & 1u;
+}
+
+const uint8_t *sim_oled_ram(void)
+{
+    return &oled.ram[0][0];
+}
+
+bool sim_oled_display_on(void)
+{
+    return oled.on;
+}
+
+bool sim_oled_take_dirty(void)
+{
+    bool dirty = oled.dirty;
+    oled.dirty = false;
+    return dirty;
+}
+
+void sim_oled_print(FILE *out)
+{
+    static const char *const blocks[4] = { " ", "▀", "▄", "█" };
+
+    fprintf(out, "+");
+    for (int x = 0; x < SIM_OLED_WIDTH; x++) {
+        fputc('-', out);
+    }
+    fprintf(out, "+%s\n", oled.on ? "" : " (apagado)");
+
+    for (int y = 0; y < SIM_OLED_HEIGHT; y += 2) {
+        fputc('|', out);
+        for (int x = 0; x < SIM_OLED_WIDTH; x++) {
+            int v = sim_oled_pixel((uint8_t)x, (uint8_t)y) | (sim_oled_pixel((uint8_t)x, (uint8_t)(y + 1)) << 1);
+            fputs(blocks[v], out);
+        }
+        fprintf(out, "|\n");
+    }
+
+    fprintf(out, "+");
+    for (int x = 0; x < SIM_OLED_WIDTH; x++) {
+        fputc('-', out);
+    }
+    fprintf(out, "+\n");
+}
@@ -0,0 +1,34 @@
+/**
+ * @file sim_oled.h
+ * @brief Modelo del SSD1306 alimentado por las escrituras I2C de la HAL
+ * simulada: reconstruye la GDDRAM tal como la ve el display.
+ */
+#ifndef SIM_OLED_H
+#define SIM_OLED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_OLED_WIDTH   128
+#define SIM_OLED_PAGES   8
+#define SIM_OLED_HEIGHT  (SIM_OLED_PAGES * 8)
+
+void sim_oled_reset(void);
+
+// Hook para hal_host_i2c_set_write_hook()
+void sim_oled_i2c_write(uint16_t address, uint16_t mem_address, const uint8_t *data, uint16_t size);
+
+bool sim_oled_pixel(uint8_t x, uint8_t y);
+
+// GDDRAM en el mismo formato que el framebuffer del driver (páginas de 8 filas)
+const uint8_t *sim_oled_ram(void);
+bool sim_oled_display_on(void);
+
+// true si la GDDRAM cambió desde la última llamada
+bool sim_oled_take_dirty(void);
+
+// Dibuja la pantalla con medios bloques (dos filas por línea de texto)
+void sim_oled_print(FILE *out);
+
+#endif // SIM_OLED_H
@@ -0,0 +1,33 @@
+/**
+ * @file test_check.h
+ * @brief Verificaciones mínimas para los tests de host (ctest).
+ *
+ * CHECK() cuenta y reporta cada falla sin cortar el test; el main del test
+ * termina con test_check_result(), que vale 1 si algo falló. Todo sale por
+ * stderr: board_host_init() redirige stdout a la USART2 simulada.
+ */
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+
+static unsigned test_check_count;
+static unsigned test_check_failures;
+
+#define CHECK(cond, ...) do {                                       \
+        test_check_count++;                                         \
+        if (!(cond)) {                                              \
+            test_check_failures++;                                  \
+            fprintf(stderr, "%s:%d: falla: %s: ", __FILE__, __LINE__, #cond); \
+            fprintf(stderr, __VA_ARGS__);                           \
+            fputc('\n', stderr);                                    \
+        }                                                           \
+    } while (0)
+
+static inline int test_check_result(const char *name)
+{
+    fprintf(stderr, "%s: %u verificaciones, %u fallas\n", name, test_check_count, test_check_failures);
+    return (test_check_failures == 0) ? 0 : 1;
+}
+
+#endif // TEST_CHECK_H
@@ -0,0 +1,114 @@
+/**
+ * @file test_config_store.c
+ * @brief config_store_compact() y la migración de la clave en texto.
+ *
+ * Una flash escrita por una versión anterior guarda la clave como char[4];
+ * al arrancar, room_control la reemplaza por su hash y compacta. Después
+ * no puede quedar ningún registro con esos cuatro dígitos en la región
+ * CONFIG, y el resto de la configuración tiene que seguir igual.
+ */
+#include "board_host.h"
+#include "hal_host.h"
+#include "config_store.h"
+#include "room_control.h"
+#include "tlog.h"
+#include "test_check.h"
+#include <string.h>
+
+#define LEGACY_PIN      "7391"
+#define REGION_SIZE     (CONFIG_STORE_PAGES * CONFIG_STORE_PAGE_SIZE)
+
+// Apariciones de los bytes en la región CONFIG de la flash
+static unsigned region_count(const void *bytes, size_t len)
+{
+    const uint8_t *region = FLASH_READ_PTR(CONFIG_STORE_BASE);
+    unsigned found = 0;
+    for (size_t i = 0; i + len <= REGION_SIZE; i++) {
+        if (memcmp(&region[i], bytes, len) == 0) {
+            found++;
+        }
+    }
+    return found;
+}
+
+static void boot(void)
+{
+    board_host_init();
+    hal_host_log_enable(false);
+    tlog_init();
+    config_store_init();
+}
+
+/**
+ * Valores reescritos muchas veces: compactar deja una sola página con el
+ * último valor de cada clave y ninguno de los anteriores.
+ */
+static void test_compact(void)
+{
+    hal_host_flash_erase_all();
+    boot();
+
+    for (int32_t v = 1000; v < 1400; v++) {
+        CHECK(config_store_set(CONFIG_KEY_SETPOINT, &v, sizeof(v)), "set %d", (int)v);
+    }
+    uint8_t mode = 1;
+    config_store_set(CONFIG_KEY_FAN_MODE, &mode, sizeof(mode));
+
+    config_store_stats_t before;
+    config_store_get_stats(&before);
+    CHECK(before.records > 2, "solo %u registros antes de compactar", (unsigned)before.records);
+
+    CHECK(config_store_compact(), "compact falló");
+    config_store_stats_t after;
+    config_store_get_stats(&after);
+    CHECK(after.records == 2 && after.keys == 2, "%u registros, %u claves", (unsigned)after.records,
+          (unsigned)after.keys);
+
+    int32_t stale = 1200;
+    CHECK(region_count(&stale, sizeof(stale)) == 0, "quedó un valor reemplazado en la flash");
+
+    // Y lo mismo al volver a arrancar
+    boot();
+    int32_t setpoint = 0;
+    CHECK(config_store_get(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint)) && setpoint == 1399,
+          "setpoint %d tras el reinicio", (int)setpoint);
+    CHECK(config_store_get(CONFIG_KEY_FAN_MODE, &mode, sizeof(mode)) && mode == 1, "modo %u", mode);
+}
+
+static void test_legacy_pin(void)
+{
+    hal_host_flash_erase_all();
+    boot();
+
+    int32_t setpoint = 2650;
+    CHECK(config_store_set(CONFIG_KEY_PASSWORD, LEGACY_PIN, 4), "no se pudo guardar la clave");
+    CHECK(config_store_set(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint)), "setpoint");
+    CHECK(region_count(LEGACY_PIN, 4) == 1, "la clave en texto no quedó en la flash");
+
+    // Arranque del firmware nuevo sobre esa flash
+    boot();
+    room_control_init(&room_system);
+
+    CHECK(region_count(LEGACY_PIN, 4) == 0, "la clave en texto sigue en la flash");
+    pin_hash_t stored;
+    CHECK(config_store_get(CONFIG_KEY_PASSWORD, &stored, sizeof(stored)), "no hay hash guardado");
+    setpoint = 0;
+    CHECK(config_store_get(CONFIG_KEY_SETPOINT, &setpoint, sizeof(setpoint)) && setpoint == 2650,
+          "setpoint %d tras migrar", (int)setpoint);
+
+    // La clave vieja sigue abriendo, ahora contra el hash
+    for (const char *k = LEGACY_PIN; *k != '\0'; k++) {
+        room_control_process_key(&room_system, *k);
+        room_control_update(&room_system);
+    }
+    CHECK(room_control_get_state(&room_system) == ROOM_STATE_UNLOCKED, "estado %d",
+          (int)room_control_get_state(&room_system));
+}
+
+int main(void)
+{
+    test_compact();
+    test_legacy_pin();
+
+    return test_check_result("test_config_store");
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_fan_pwm.c
+ * @brief Barrido de fan_pwm_compute(): frecuencia obtenida, resolución y
+ *        que PSC / ARR entren en los registros de 16 bits de TIM3.
+ *
+ * Para varios relojes de timer se piden todas las frecuencias enteras hasta
+ * 200 kHz y luego escalones hasta el propio reloj. Cada resultado aceptado
+ * se recalcula desde PSC y periodo; cada rechazo tiene que deberse a que no
+ * alcanza la resolución mínima. Al final, fan_pwm_configure() sobre el TIM3
+ * de host con APB1 dividido.
+ */
+#include "board_host.h"
+#include "hal_host.h"
+#include "fan_pwm.h"
+#include "test_check.h"
+
+#define SWEEP_DENSE_HZ  200000u
+
+static const uint32_t timer_clocks_hz[] = { 80000000u, 48000000u, 16000000u, 4000000u, 1000000u };
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t rejected;
+    uint32_t bad_registers;    // PSC o ARR fuera de 16 bits, periodo < 2
+    uint32_t bad_frequency;    // frequency_hz no sale de PSC / periodo
+    uint32_t bad_resolution;   // bits != floor(log2(periodo)) o < mínimo
+    uint32_t bad_prescaler;    // Había un prescaler menor que alcanzaba
+    uint32_t bad_reject;       // Rechazo con resolución suficiente
+    double worst_error;        // Mayor error relativo / (1 / periodo)
+} sweep_stats_t;
+
+static uint8_t floor_log2(uint32_t v)
+{
+    uint8_t bits = 0;
+    while (v > 1) {
+        v >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
+static void sweep_one(uint32_t clock, uint32_t freq, uint8_t min_bits, sweep_stats_t *stats)
+{
+    fan_pwm_config_t config;
+
+    if (!fan_pwm_compute(clock, freq, min_bits, &config)) {
+        stats->rejected++;
+        // Sin prescaler queda el máximo de pasos: si aun así alcanza min_bits
+        // (con margen por el redondeo del periodo), el rechazo está mal
+        uint32_t ticks = clock / freq;
+        if (ticks <= 0xFFFFu && floor_log2(ticks) > min_bits) {
+            stats->bad_reject++;
+        }
+        return;
+    }
+    stats->accepted++;
+
+    if (config.prescaler > 0xFFFFu || config.period < 2 || config.period - 1 > 0xFFFFu) {
+        stats->bad_registers++;
+        return;
+    }
+    uint32_t divided = clock / (config.prescaler + 1);
+    if (config.frequency_hz != divided / config.period) {
+        stats->bad_frequency++;
+    }
+    if (config.resolution_bits != floor_log2(config.period) || config.resolution_bits < min_bits) {
+        stats->bad_resolution++;
+    }
+    // Prescaler mínimo: con uno menos el periodo ya no cabría en ARR
+    if (config.prescaler > 0 && clock / freq <= config.prescaler * 0xFFFFu) {
+        stats->bad_prescaler++;
+    }
+
+    // Periodo redondeado al más cercano: error de frecuencia por debajo de
+    // un paso de periodo (medio paso más el truncado de PSC)
+    double achieved = (double)clock / ((double)(config.prescaler + 1) * config.period);
+    double error = (achieved > freq ? achieved - freq : freq - achieved) / freq;
+    double steps = error * config.period;
+    if (steps > stats->worst_error) {
+        stats->worst_error = steps;
+    }
+}
+
+static void test_sweep(uint8_t min_bits)
+{
+    for (unsigned c = 0; c < sizeof(timer_clocks_hz) / sizeof(timer_clocks_hz[0]); c++) {
+        uint32_t clock = timer_clocks_hz[c];
+        sweep_stats_t stats = { 0 };
+
+        for (uint32_t f = 1; f <= SWEEP_DENSE_HZ && f <= clock; f++) {
+            sweep_one(clock, f, min_bits, &stats);
+        }
+        for (uint32_t f = SWEEP_DENSE_HZ; f <= clock; f += f / 64) {
+            sweep_one(clock, f, min_bits, &stats);
+        }
+        sweep_one(clock, clock, min_bits, &stats);
+
+        CHECK(stats.accepted > 0, "%u Hz / %u bits: ninguna frecuencia aceptada", clock, min_bits);
+        CHECK(stats.bad_registers == 0, "%u Hz: %u resultados no entran en PSC/ARR", clock,
+              stats.bad_registers);
+        CHECK(stats.bad_frequency == 0, "%u Hz: %u frecuencias no salen de PSC/periodo", clock,
+              stats.bad_frequency);
+        CHECK(stats.bad_resolution == 0, "%u Hz: %u resoluciones mal calculadas", clock,
+              stats.bad_resolution);
+        CHECK(stats.bad_prescaler == 0, "%u Hz: %u prescalers mayores de lo necesario", clock,
+              stats.bad_prescaler);
+        CHECK(stats.bad_reject == 0, "%u Hz / %u bits: %u rechazos con resolución suficiente",
+              clock, min_bits, stats.bad_reject);
+        CHECK(stats.worst_error <= 1.0, "%u Hz: error de %.3f pasos de periodo", clock,
+              stats.worst_error);
+    }
+}
+
+/**
+ * Casos conocidos y entradas inválidas.
+ */
+static void test_edges(void)
+{
+    fan_pwm_config_t config;
+
+    CHECK(fan_pwm_compute(80000000u, FAN_PWM_DEFAULT_HZ, FAN_PWM_MIN_RESOLUTION, &config),
+          "25 kHz a 80 MHz rechazado");
+    CHECK(config.prescaler == 0 && config.period == 3200 && config.frequency_hz == 25000 &&
+          config.resolution_bits == 11,
+          "25 kHz: PSC %u, periodo %u, %u Hz, %u bits", config.prescaler, config.period,
+          config.frequency_hz, config.resolution_bits);
+
+    // 1 Hz necesita prescaler y el periodo queda pegado al tope de ARR
+    CHECK(fan_pwm_compute(80000000u, 1, FAN_PWM_MIN_RESOLUTION, &config), "1 Hz rechazado");
+    CHECK(config.prescaler > 0 && config.period - 1 <= 0xFFFFu && config.frequency_hz == 1,
+          "1 Hz: PSC %u, periodo %u", config.prescaler, config.period);
+
+    CHECK(!fan_pwm_compute(80000000u, 0, 0, &config), "0 Hz aceptado");
+    CHECK(!fan_pwm_compute(80000000u, 80000001u, 0, &config), "frecuencia > reloj aceptada");
+    CHECK(!fan_pwm_compute(80000000u, 80000000u, 0, &config), "periodo de 1 paso aceptado");
+    // MSI a 4 MHz: 25 kHz deja 160 pasos, 7 bits
+    CHECK(!fan_pwm_compute(4000000u, FAN_PWM_DEFAULT_HZ, FAN_PWM_MIN_RESOLUTION, &config),
+          "25 kHz a 4 MHz aceptado con %u bits", FAN_PWM_MIN_RESOLUTION);
+    CHECK(fan_pwm_compute(4000000u, FAN_PWM_DEFAULT_HZ, 7, &config) && config.period == 160,
+          "25 kHz a 4 MHz con 7 bits");
+    CHECK(!fan_pwm_compute(80000000u, FAN_PWM_DEFAULT_HZ, 12, &config), "12 bits a 25 kHz aceptado");
+}
+
+/**
+ * fan_pwm_configure() sobre TIM3: con APB1 dividido el timer va al doble
+ * de PCLK1 y los registros quedan con PSC / ARR del cálculo.
+ */
+static void test_configure(void)
+{
+    board_host_init();
+    hal_host_set_pclk1(40000000u);
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_PPRE1) | RCC_CFGR_PPRE1_DIV2;
+
+    CHECK(fan_pwm_timer_clock_hz() == 80000000u, "reloj de TIM3 %u", fan_pwm_timer_clock_hz());
+    CHECK(fan_pwm_configure(&htim3, 20000u, FAN_PWM_MIN_RESOLUTION), "20 kHz rechazado");
+    CHECK(TIM3->PSC == 0 && TIM3->ARR == 3999, "PSC %u, ARR %u", (unsigned)TIM3->PSC,
+          (unsigned)TIM3->ARR);
+    CHECK(fan_pwm_get_frequency(&htim3) == 20000u, "frecuencia %u", fan_pwm_get_frequency(&htim3));
+
+    CHECK(fan_pwm_configure(&htim3, 5u, FAN_PWM_MIN_RESOLUTION), "5 Hz rechazado");
+    CHECK(TIM3->PSC <= 0xFFFFu && TIM3->ARR <= 0xFFFFu && TIM3->PSC > 0, "PSC %u, ARR %u",
+          (unsigned)TIM3->PSC, (unsigned)TIM3->ARR);
+    CHECK(fan_pwm_get_frequency(&htim3) == 5u, "frecuencia %u", fan_pwm_get_frequency(&htim3));
+
+    // Rechazo: los registros no se tocan
+    uint32_t arr = TIM3->ARR;
+    CHECK(!fan_pwm_configure(&htim3, 1000000u, FAN_PWM_MIN_RESOLUTION), "1 MHz aceptado");
+    CHECK(TIM3->ARR == arr, "ARR cambió tras un rechazo");
+}
+
+int main(void)
+{
+    test_sweep(FAN_PWM_MIN_RESOLUTION);
+    test_sweep(1);
+    test_edges();
+    test_configure();
+
+    return test_check_result("test_fan_pwm");
+}
@@ -0,0 +1,393 @@
+/**
+ * @file test_fan_ramp.c
+ * @brief Modelo de fan_ramp sobre la HAL de host: DMA circular -> TIM3->CCR1.
+ *
+ * Cada evento de update de hal_host_tim_update() copia una muestra del
+ * buffer al CCR1, igual que el DMA real, y dispara las interrupciones de
+ * media transferencia y transferencia completa que rellenan el buffer. El
+ * test mira la secuencia de CCR1 periodo a periodo: forma de cada curva,
+ * rellenos de las dos mitades, cambio de objetivo en plena rampa,
+ * reescalado tras cambiar la frecuencia PWM y un DMA que cruza de mitad
+ * mientras se calcula la rampa nueva.
+ */
+#include "board_host.h"
+#include "hal_host.h"
+#include "fan_pwm.h"
+#include "fan_ramp.h"
+#include "test_check.h"
+#include <stdlib.h>
+
+#define Q15_ONE         32768u
+#define RAMP_MS         100u
+#define PWM_PERIOD      3200u                        // ARR + 1 a 25 kHz
+#define RAMP_PERIODS    (RAMP_MS * FAN_PWM_DEFAULT_HZ / 1000u)
+#define HALF            (FAN_RAMP_BUFFER_LEN / 2)
+
+typedef struct {
+    uint32_t events;
+    uint32_t max_step;      // Mayor |CCR1[n] - CCR1[n-1]|
+    uint32_t min;
+    uint32_t max;
+    bool monotonic_up;
+    bool monotonic_down;
+} ramp_trace_t;
+
+static void (*ramp_half_cplt)(DMA_HandleTypeDef *hdma);
+static void (*ramp_cplt)(DMA_HandleTypeDef *hdma);
+static uint32_t half_refills;
+static uint32_t cplt_refills;
+
+// Cuentan los rellenos y siguen con los callbacks de fan_ramp
+static void count_half_cplt(DMA_HandleTypeDef *hdma)
+{
+    half_refills++;
+    ramp_half_cplt(hdma);
+}
+
+static void count_cplt(DMA_HandleTypeDef *hdma)
+{
+    cplt_refills++;
+    ramp_cplt(hdma);
+}
+
+static void ramp_setup(fan_ramp_curve_t curve, uint16_t ccr)
+{
+    board_host_init();
+    TIM3->CCR1 = ccr;
+    fan_ramp_configure(curve, RAMP_MS);
+    fan_ramp_init(&htim3);
+
+    ramp_half_cplt = hdma_tim3_up.XferHalfCpltCallback;
+    ramp_cplt = hdma_tim3_up.XferCpltCallback;
+    hdma_tim3_up.XferHalfCpltCallback = count_half_cplt;
+    hdma_tim3_up.XferCpltCallback = count_cplt;
+    half_refills = 0;
+    cplt_refills = 0;
+}
+
+// Arranques del canal DMA registrados en el log de la HAL
+static uint32_t dma_starts(void)
+{
+    uint32_t count = 0;
+    for (size_t i = 0; i < hal_host_log_count(); i++) {
+        if (hal_host_log_get(i)->type == HAL_HOST_EV_DMA_START) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static bool ramp_irqs_enabled(void)
+{
+    return (DMA1_Channel3->CCR & (DMA_IT_HT | DMA_IT_TC)) != 0;
+}
+
+// Avanza periodos PWM de a uno y resume la secuencia de CCR1
+static void ramp_trace_reset(ramp_trace_t *trace)
+{
+    *trace = (ramp_trace_t){ .min = UINT32_MAX, .monotonic_up = true, .monotonic_down = true };
+}
+
+static void ramp_run(ramp_trace_t *trace, uint32_t events)
+{
+    for (uint32_t i = 0; i < events; i++) {
+        uint32_t before = TIM3->CCR1;
+        hal_host_tim_update(&htim3, 1);
+        uint32_t after = TIM3->CCR1;
+        uint32_t step = (after > before) ? after - before : before - after;
+
+        trace->events++;
+        if (step > trace->max_step) {
+            trace->max_step = step;
+        }
+        if (after < before) {
+            trace->monotonic_up = false;
+        }
+        if (after > before) {
+            trace->monotonic_down = false;
+        }
+        if (after < trace->min) {
+            trace->min = after;
+        }
+        if (after > trace->max) {
+            trace->max = after;
+        }
+    }
+}
+
+// Periodos hasta que CCR1 llega a value (tope: limit)
+static uint32_t ramp_run_until(ramp_trace_t *trace, uint32_t value, uint32_t limit)
+{
+    uint32_t start = trace->events;
+    while (TIM3->CCR1 != value && trace->events - start < limit) {
+        ramp_run(trace, 1);
+    }
+    return trace->events - start;
+}
+
+static void test_curve_shapes(void)
+{
+    static const fan_ramp_curve_t curves[] = {
+        FAN_RAMP_LINEAR, FAN_RAMP_S_CURVE, FAN_RAMP_EXPONENTIAL
+    };
+
+    for (size_t c = 0; c < sizeof(curves) / sizeof(curves[0]); c++) {
+        fan_ramp_curve_t curve = curves[c];
+        uint16_t prev = 0;
+        bool monotonic = true;
+
+        CHECK(fan_ramp_curve(curve, 0) == 0, "curva %u: f(0) = %u", (unsigned)curve,
+              fan_ramp_curve(curve, 0));
+        CHECK(fan_ramp_curve(curve, Q15_ONE) == Q15_ONE, "curva %u: f(1) = %u", (unsigned)curve,
+              fan_ramp_curve(curve, Q15_ONE));
+        CHECK(fan_ramp_curve(curve, 40000) == Q15_ONE, "curva %u: f(>1) no satura", (unsigned)curve);
+
+        for (uint32_t p = 0; p <= Q15_ONE; p++) {
+            uint16_t f = fan_ramp_curve(curve, (uint16_t)p);
+            if (f < prev) {
+                monotonic = false;
+            }
+            prev = f;
+        }
+        CHECK(monotonic, "curva %u no es monótona", (unsigned)curve);
+    }
+
+    CHECK(fan_ramp_curve(FAN_RAMP_LINEAR, 12345) == 12345, "lineal no es la identidad");
+
+    // smoothstep: simétrica respecto del punto medio
+    CHECK(fan_ramp_curve(FAN_RAMP_S_CURVE, Q15_ONE / 2) == Q15_ONE / 2, "S: f(0.5) = %u",
+          fan_ramp_curve(FAN_RAMP_S_CURVE, Q15_ONE / 2));
+    uint32_t worst = 0;
+    for (uint32_t p = 0; p <= Q15_ONE; p += 64) {
+        int32_t sum = fan_ramp_curve(FAN_RAMP_S_CURVE, (uint16_t)p) +
+                      fan_ramp_curve(FAN_RAMP_S_CURVE, (uint16_t)(Q15_ONE - p));
+        uint32_t err = (uint32_t)abs(sum - (int32_t)Q15_ONE);
+        if (err > worst) {
+            worst = err;
+        }
+    }
+    CHECK(worst <= 2, "S: asimetría de %u", worst);
+
+    // Exponencial: pasa por los nodos de la tabla y queda sobre la lineal
+    CHECK(fan_ramp_curve(FAN_RAMP_EXPONENTIAL, 2048) == 8854, "exp: f(1/16) = %u",
+          fan_ramp_curve(FAN_RAMP_EXPONENTIAL, 2048));
+    CHECK(fan_ramp_curve(FAN_RAMP_EXPONENTIAL, 16384) == 30282, "exp: f(1/2) = %u",
+          fan_ramp_curve(FAN_RAMP_EXPONENTIAL, 16384));
+    bool above = true;
+    for (uint32_t p = 0; p <= Q15_ONE; p += 16) {
+        if (fan_ramp_curve(FAN_RAMP_EXPONENTIAL, (uint16_t)p) < p) {
+            above = false;
+        }
+    }
+    CHECK(above, "exp: cae bajo la lineal");
+}
+
+/**
+ * Rampa completa 0 -> 100 % con cada curva: CCR1 sube sin saltos mayores
+ * que la pendiente máxima de la curva, llega al final en RAMP_MS (más a lo
+ * sumo un buffer de latencia), las dos mitades se rellenan por turno y,
+ * quieta la rampa, las interrupciones del DMA se apagan.
+ */
+static void test_ramp_curve(fan_ramp_curve_t curve, uint32_t max_step)
+{
+    ramp_trace_t trace;
+
+    ramp_setup(curve, 0);
+    CHECK(!ramp_irqs_enabled(), "curva %u: HT/TC activas sin rampa", (unsigned)curve);
+
+    fan_ramp_set_target(PWM_PERIOD);
+    CHECK(fan_ramp_is_active(), "curva %u: la rampa no arrancó", (unsigned)curve);
+    CHECK(ramp_irqs_enabled(), "curva %u: HT/TC apagadas con rampa", (unsigned)curve);
+    CHECK(fan_ramp_get_target() == PWM_PERIOD, "curva %u: objetivo %u", (unsigned)curve,
+          fan_ramp_get_target());
+
+    ramp_trace_reset(&trace);
+    uint32_t periods = ramp_run_until(&trace, PWM_PERIOD, 2 * RAMP_PERIODS);
+    CHECK(periods >= RAMP_PERIODS && periods <= RAMP_PERIODS + FAN_RAMP_BUFFER_LEN,
+          "curva %u: llegó al final en %u periodos (esperado %u..%u)", (unsigned)curve,
+          periods, RAMP_PERIODS, RAMP_PERIODS + FAN_RAMP_BUFFER_LEN);
+    CHECK(trace.monotonic_up, "curva %u: CCR1 bajó durante la subida", (unsigned)curve);
+    CHECK(trace.max_step <= max_step, "curva %u: salto de %u (máximo %u)", (unsigned)curve,
+          trace.max_step, max_step);
+
+    // Cada vuelta del buffer rellena primero la mitad baja y luego la alta
+    uint32_t halves = RAMP_PERIODS / HALF;
+    CHECK(half_refills + cplt_refills >= halves, "curva %u: %u rellenos para %u mitades",
+          (unsigned)curve, half_refills + cplt_refills, halves);
+    CHECK(half_refills - cplt_refills <= 1 || cplt_refills - half_refills <= 1,
+          "curva %u: rellenos desparejos HT=%u TC=%u", (unsigned)curve, half_refills, cplt_refills);
+
+    // Dos mitades seguidas solo con el valor final apagan HT/TC
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    CHECK(!fan_ramp_is_active(), "curva %u: sigue activa", (unsigned)curve);
+    CHECK(!ramp_irqs_enabled(), "curva %u: HT/TC siguen activas", (unsigned)curve);
+    uint32_t refills = half_refills + cplt_refills;
+    ramp_run(&trace, 4 * FAN_RAMP_BUFFER_LEN);
+    CHECK(half_refills + cplt_refills == refills, "curva %u: rellenos sin rampa", (unsigned)curve);
+    CHECK(TIM3->CCR1 == PWM_PERIOD && trace.max == PWM_PERIOD, "curva %u: CCR1 = %u, máximo %u",
+          (unsigned)curve, (unsigned)TIM3->CCR1, trace.max);
+}
+
+/**
+ * Objetivo nuevo a mitad de una subida: la bajada parte del último valor
+ * ya encolado, sin saltos ni reinicio del canal, y termina en el objetivo.
+ */
+static void test_retarget(void)
+{
+    ramp_trace_t trace;
+
+    ramp_setup(FAN_RAMP_LINEAR, 0);
+    fan_ramp_set_target(PWM_PERIOD);
+    ramp_trace_reset(&trace);
+    ramp_run(&trace, RAMP_PERIODS / 2);
+
+    uint32_t at_retarget = TIM3->CCR1;
+    uint32_t starts = dma_starts();
+    CHECK(at_retarget > PWM_PERIOD / 4 && at_retarget < PWM_PERIOD * 3 / 4,
+          "a mitad de rampa CCR1 = %u", at_retarget);
+
+    fan_ramp_set_target(PWM_PERIOD / 4);
+    CHECK(fan_ramp_get_target() == PWM_PERIOD / 4, "objetivo %u", fan_ramp_get_target());
+    CHECK(fan_ramp_is_active(), "la bajada no arrancó");
+
+    ramp_trace_reset(&trace);
+    uint32_t periods = ramp_run_until(&trace, PWM_PERIOD / 4, 2 * RAMP_PERIODS);
+    CHECK(TIM3->CCR1 == PWM_PERIOD / 4, "CCR1 = %u tras la bajada", (unsigned)TIM3->CCR1);
+    CHECK(periods <= RAMP_PERIODS + FAN_RAMP_BUFFER_LEN, "bajada de %u periodos", periods);
+    CHECK(trace.max_step <= 2, "salto de %u al cambiar de objetivo", trace.max_step);
+    // Lo ya encolado de la subida sigue saliendo: a lo sumo un buffer más arriba
+    CHECK(trace.max <= at_retarget + 2 * FAN_RAMP_BUFFER_LEN, "siguió subiendo hasta %u", trace.max);
+    CHECK(starts == 1 && dma_starts() == starts, "se reinició el DMA");
+
+    // El mismo objetivo otra vez no arranca otra rampa
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    uint32_t refills = half_refills + cplt_refills;
+    fan_ramp_set_target(PWM_PERIOD / 4);
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    CHECK(!fan_ramp_is_active() && half_refills + cplt_refills == refills,
+          "repetir el objetivo rearmó la rampa");
+}
+
+/**
+ * Cambio de frecuencia a mitad de rampa (25 -> 12.5 kHz, periodo x2): CCR1,
+ * objetivo y buffer se reescalan conservando el duty, y el resto de la
+ * rampa dura lo mismo en milisegundos. Después, quieta, a 50 kHz.
+ */
+static void test_rescale(void)
+{
+    ramp_trace_t trace;
+
+    ramp_setup(FAN_RAMP_LINEAR, 0);
+    fan_ramp_set_target(PWM_PERIOD);
+    ramp_trace_reset(&trace);
+    ramp_run(&trace, RAMP_PERIODS / 2);
+
+    uint32_t before = TIM3->CCR1;
+    CHECK(fan_pwm_configure(&htim3, FAN_PWM_DEFAULT_HZ / 2, FAN_PWM_MIN_RESOLUTION),
+          "no se pudo pasar a %u Hz", FAN_PWM_DEFAULT_HZ / 2);
+    CHECK(TIM3->ARR + 1 == 2 * PWM_PERIOD, "ARR = %u", (unsigned)TIM3->ARR);
+    CHECK(fan_pwm_get_frequency(&htim3) == FAN_PWM_DEFAULT_HZ / 2, "frecuencia %u",
+          fan_pwm_get_frequency(&htim3));
+    CHECK(TIM3->CCR1 == 2 * before, "CCR1 %u -> %u, esperado %u", before, (unsigned)TIM3->CCR1,
+          2 * before);
+    CHECK(fan_ramp_get_target() == 2 * PWM_PERIOD, "objetivo %u", fan_ramp_get_target());
+    CHECK(fan_ramp_is_active(), "la rampa se cortó al reescalar");
+
+    // Quedaba la mitad de RAMP_MS: a 12.5 kHz son RAMP_PERIODS / 4 periodos
+    ramp_trace_reset(&trace);
+    uint32_t periods = ramp_run_until(&trace, 2 * PWM_PERIOD, 2 * RAMP_PERIODS);
+    CHECK(TIM3->CCR1 == 2 * PWM_PERIOD, "CCR1 = %u al final", (unsigned)TIM3->CCR1);
+    CHECK(periods + FAN_RAMP_BUFFER_LEN >= RAMP_PERIODS / 4 &&
+          periods <= RAMP_PERIODS / 4 + FAN_RAMP_BUFFER_LEN,
+          "resto de la rampa en %u periodos (esperado ~%u)", periods, RAMP_PERIODS / 4);
+    // Misma pendiente en duty por milisegundo: cada periodo dura el doble y
+    // cada cuenta vale la mitad, así que el paso por muestra crece x4 (2 -> 8)
+    CHECK(trace.monotonic_up && trace.max_step <= 8, "salto de %u tras reescalar", trace.max_step);
+
+    // Sin rampa: 50 kHz deja el 100 % en 1600 y el buffer entero reescalado
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    CHECK(fan_pwm_configure(&htim3, 2 * FAN_PWM_DEFAULT_HZ, FAN_PWM_MIN_RESOLUTION),
+          "no se pudo pasar a %u Hz", 2 * FAN_PWM_DEFAULT_HZ);
+    CHECK(TIM3->CCR1 == PWM_PERIOD / 2 && fan_ramp_get_target() == PWM_PERIOD / 2,
+          "CCR1 = %u, objetivo %u a 50 kHz", (unsigned)TIM3->CCR1, fan_ramp_get_target());
+    ramp_trace_reset(&trace);
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    CHECK(trace.min == PWM_PERIOD / 2 && trace.max == PWM_PERIOD / 2,
+          "el buffer sin reescalar dejó CCR1 en %u..%u", trace.min, trace.max);
+    CHECK(!fan_ramp_is_active(), "reescalar sin rampa arrancó una");
+}
+
+// El DMA avanza cross_events periodos justo después de que fan_ramp lee CNDTR
+static ramp_trace_t *cross_trace;
+static uint32_t cross_events;
+
+static void cross_during_fill(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    hal_host_dma_set_counter_hook(NULL);
+    ramp_run(cross_trace, cross_events);
+}
+
+static void cross_case(const char *name, uint16_t first_target)
+{
+    ramp_trace_t trace;
+
+    ramp_setup(FAN_RAMP_LINEAR, 0);
+    if (first_target != 0) {
+        fan_ramp_set_target(first_target);
+    }
+    ramp_trace_reset(&trace);
+    ramp_run(&trace, RAMP_PERIODS / 4);
+
+    // A una muestra del final de la mitad baja
+    while (DMA1_Channel3->CNDTR != HALF + 1) {
+        ramp_run(&trace, 1);
+    }
+
+    // fan_ramp ve el DMA en la mitad baja, rellena la alta y mientras tanto
+    // el DMA entra en ella: la baja tiene que quedar con la continuación
+    ramp_trace_reset(&trace);
+    cross_trace = &trace;
+    cross_events = 1;
+    hal_host_dma_set_counter_hook(cross_during_fill);
+    fan_ramp_set_target(PWM_PERIOD);
+    CHECK(trace.events == 1, "%s: el DMA no avanzó durante el relleno", name);
+
+    uint32_t periods = ramp_run_until(&trace, PWM_PERIOD, 2 * RAMP_PERIODS);
+    CHECK(TIM3->CCR1 == PWM_PERIOD, "%s: CCR1 = %u al final", name, (unsigned)TIM3->CCR1);
+    CHECK(periods <= RAMP_PERIODS + FAN_RAMP_BUFFER_LEN, "%s: subida de %u periodos", name,
+          periods);
+    CHECK(trace.monotonic_up, "%s: CCR1 volvió a muestras viejas (mín. %u)", name, trace.min);
+    CHECK(trace.max_step <= 2, "%s: salto de %u", name, trace.max_step);
+
+    ramp_run(&trace, 2 * FAN_RAMP_BUFFER_LEN);
+    CHECK(!fan_ramp_is_active() && !ramp_irqs_enabled(), "%s: la rampa no terminó", name);
+}
+
+/**
+ * El DMA cruza a la mitad que fan_ramp_set_target() está rellenando. Sin
+ * rampa las interrupciones están apagadas; en plena rampa la de media
+ * transferencia queda pendiente (PRIMASK en 1) y se descarta al limpiar
+ * las banderas. En los dos casos nadie rellenaría la mitad que el DMA dejó.
+ */
+static void test_cross_during_fill(void)
+{
+    cross_case("sin rampa", 0);
+    cross_case("en plena rampa", PWM_PERIOD / 2);
+}
+
+int main(void)
+{
+    test_curve_shapes();
+
+    // Pendiente máxima por periodo: 3200 / 2500 por la pendiente de la curva
+    test_ramp_curve(FAN_RAMP_LINEAR, 2);
+    test_ramp_curve(FAN_RAMP_S_CURVE, 3);
+    test_ramp_curve(FAN_RAMP_EXPONENTIAL, 7);
+
+    test_retarget();
+    test_rescale();
+    test_cross_during_fill();
+
+    return test_check_result("test_fan_ramp");
+}
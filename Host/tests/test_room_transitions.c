@@ -0,0 +1,79 @@
+/**
+ * @file test_room_transitions.c
+ * @brief Revisión de room_transitions[][]: la tabla real no tiene estados
+ * inalcanzables ni sin salida, y el verificador sí los detecta en tablas
+ * rotas armadas a mano.
+ *
+ * Las tablas de prueba usan la convención de room_control.c: 0 = STAY,
+ * estado + 1 = GOTO(estado).
+ */
+#include "board_host.h"
+#include "room_control.h"
+#include "test_check.h"
+#include <string.h>
+
+#define STAY            0
+#define GOTO(state)     ((uint8_t)((state) + 1))
+#define INPUTS          3
+
+// LOCKED -> INPUT -> UNLOCKED / DENIED -> LOCKED, EMERGENCY ida y vuelta
+static const uint8_t table_ok[ROOM_STATE_COUNT][INPUTS] = {
+    [ROOM_STATE_LOCKED]         = { GOTO(ROOM_STATE_INPUT_PASSWORD), GOTO(ROOM_STATE_EMERGENCY), STAY },
+    [ROOM_STATE_INPUT_PASSWORD] = { GOTO(ROOM_STATE_UNLOCKED), GOTO(ROOM_STATE_ACCESS_DENIED), STAY },
+    [ROOM_STATE_UNLOCKED]       = { GOTO(ROOM_STATE_LOCKED), STAY, STAY },
+    [ROOM_STATE_ACCESS_DENIED]  = { GOTO(ROOM_STATE_LOCKED), STAY, STAY },
+    [ROOM_STATE_EMERGENCY]      = { GOTO(ROOM_STATE_LOCKED), STAY, STAY },
+};
+
+static int check(const uint8_t *table)
+{
+    return room_control_check_transitions(table, ROOM_STATE_COUNT, INPUTS);
+}
+
+static void test_real_table(void)
+{
+    CHECK(room_control_validate_transitions() == 0, "room_transitions tiene %d problemas",
+          room_control_validate_transitions());
+}
+
+static void test_broken_tables(void)
+{
+    uint8_t table[ROOM_STATE_COUNT][INPUTS];
+
+    CHECK(check(&table_ok[0][0]) == 0, "la tabla de referencia tiene %d problemas", check(&table_ok[0][0]));
+
+    // Nadie entra a EMERGENCY: inalcanzable
+    memcpy(table, table_ok, sizeof(table));
+    table[ROOM_STATE_LOCKED][1] = STAY;
+    CHECK(check(&table[0][0]) == 1, "EMERGENCY inalcanzable: %d problemas", check(&table[0][0]));
+
+    // ACCESS_DENIED no vuelve a LOCKED: sin salida
+    memcpy(table, table_ok, sizeof(table));
+    table[ROOM_STATE_ACCESS_DENIED][0] = STAY;
+    CHECK(check(&table[0][0]) == 1, "ACCESS_DENIED sin salida: %d problemas", check(&table[0][0]));
+
+    // LOCKED sin salida deja todo lo demás inalcanzable
+    memcpy(table, table_ok, sizeof(table));
+    table[ROOM_STATE_LOCKED][0] = STAY;
+    table[ROOM_STATE_LOCKED][1] = STAY;
+    CHECK(check(&table[0][0]) == 1 + (ROOM_STATE_COUNT - 1), "LOCKED cerrado: %d problemas", check(&table[0][0]));
+
+    // Destino que no es un estado
+    memcpy(table, table_ok, sizeof(table));
+    table[ROOM_STATE_UNLOCKED][1] = GOTO(ROOM_STATE_COUNT);
+    CHECK(check(&table[0][0]) == 1, "destino fuera de rango: %d problemas", check(&table[0][0]));
+
+    CHECK(room_control_check_transitions(&table_ok[0][0], ROOM_STATE_COUNT + 1, INPUTS) != 0,
+          "más estados que ROOM_STATE_COUNT aceptados");
+}
+
+int main(void)
+{
+    // Los "FSM: ..." salen por la USART2 simulada, no por la consola
+    board_host_init();
+
+    test_real_table();
+    test_broken_tables();
+
+    return test_check_result("test_room_transitions");
+}
@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+"""Hace de esp-link en Linux para lo que el firmware publica por USART3.
+
+Lee el flujo de la UART, separa los PUBLISH de MQTT-SN (STX | mensaje |
+CRC-8, ver Core/Inc/sn_link.h) de las líneas de texto y muestra cada
+lote de telemetría como una línea igual a la del formato TXT y cada
+alerta (Core/Inc/alert.h) como "ALERT id=...". Con --gateway reenvía cada
+mensaje MQTT-SN (sin STX ni CRC) por UDP, como lo haría un puente real
+hacia un gateway MQTT-SN (por ejemplo el de Eclipse Paho, puerto 1884).
+
+Con --sync pone en hora el RTC al empezar: envía SET_TIME con la hora
+del sistema y su huso. Los tiempos de las alertas y lotes que ya son hora
+Unix se muestran además en UTC.
+
+Con --ack además hace de servidor remoto de las alertas: responde PUBACK
+a cada PUBLISH con QoS 1 y descarta duplicados por id. --drop-acks N y
+--loss P pierden respuestas a propósito para probar los reintentos.
+
+Con un comando después de "--" crea un pty, lo pasa al comando en lugar
+de "{esp}" (o agrega "--esp PTY") y lee del lado maestro hasta que el
+comando termina. Con --serial lee un dispositivo ya existente: el
+USB-serie conectado a USART3, o el pty que abre renode/room_control.resc.
+
+Uso:
+  esp_link_stub.py [--gateway HOST:PUERTO] [--send LINEA]... -- CMD [ARGS...]
+  esp_link_stub.py --serial /tmp/room_control_esp01 [--gateway HOST:PUERTO]
+  esp_link_stub.py --ack --drop-acks 3 -- \\
+      _gate_build/Host/room_control_sim Host/sim/scenarios/alert.sim --speed 50 --quiet
+
+  esp_link_stub.py --send PUB:10,5 -- \\
+      _gate_build/Host/room_control_sim Host/sim/scenarios/publish.sim --quiet
+"""
+import argparse
+import datetime
+import os
+import random
+import select
+import socket
+import subprocess
+import sys
+import termios
+import time
+import tty
+
+STX = 0x02
+MSG_PUBLISH = 0x0C
+MSG_PUBACK = 0x0D
+FLAG_DUP = 0x80
+TOPIC_ALERT = 2
+ALERT_TYPES = {1: "ACCESS_DENIED", 2: "EMERGENCY", 3: "PASSWORD_CHANGED"}
+UNIX_MIN = 946684800   # RTC_CLOCK_UNIX_MIN: antes es tiempo desde el arranque
+
+
+def crc8(data):
+    """CRC-8, polinomio 0x07, valor inicial 0 (igual que sn_link_crc8)."""
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def frame(msg):
+    """STX | mensaje | CRC-8, como sn_link_seal()."""
+    return bytes([STX]) + msg + bytes([crc8(msg)])
+
+
+def time_text(time_s):
+    """t=N, con la fecha UTC si N ya es hora Unix."""
+    if time_s < UNIX_MIN:
+        return f"t={time_s}s"
+    utc = datetime.datetime.fromtimestamp(time_s, datetime.timezone.utc)
+    return f"t={time_s} utc={utc.strftime('%Y-%m-%dT%H:%M:%SZ')}"
+
+
+def sync_line():
+    """SET_TIME con la hora y el huso del sistema, en minutos."""
+    now = time.time()
+    tz_min = int(datetime.datetime.now().astimezone().utcoffset().total_seconds() // 60)
+    return f"SET_TIME:{int(now)}.{int(now * 1000) % 1000:03d},{tz_min}"
+
+
+def decode_alert(msg):
+    if len(msg) != 12:
+        return None
+    msg_id = int.from_bytes(msg[5:7], "big")
+    kind = ALERT_TYPES.get(msg[7], str(msg[7]))
+    time_s = int.from_bytes(msg[8:12], "big")
+    return f"ALERT id={msg_id} type={kind} {time_text(time_s)} dup={int(bool(msg[2] & FLAG_DUP))}"
+
+
+def decode_publish(msg):
+    """Línea con el formato de PUB_FMT:TXT a partir de un PUBLISH de MQTT-SN."""
+    if len(msg) < 7 or msg[1] != MSG_PUBLISH:
+        return None
+    topic = int.from_bytes(msg[3:5], "big")
+    if topic == TOPIC_ALERT:
+        return decode_alert(msg)
+    if len(msg) < 16:
+        return None
+    data = msg[7:]
+    seq = int.from_bytes(data[0:2], "big")
+    period_ms = int.from_bytes(data[2:4], "big") * 100
+    time_s = int.from_bytes(data[4:8], "big")
+    n = data[8]
+    if len(data) != 9 + 4 * n:
+        return None
+    samples = []
+    for i in range(n):
+        s = data[9 + 4 * i:13 + 4 * i]
+        temp = int.from_bytes(s[0:2], "big", signed=True) / 10.0
+        samples.append(f"{temp:.1f},{s[2] * 4},{(s[3] >> 3) & 1},{s[3] & 7}")
+    return f"PUB topic={topic} seq={seq} dt={period_ms} {time_text(time_s)} " + ";".join(samples)
+
+
+class Stream:
+    """Separa mensajes MQTT-SN y líneas de texto del flujo de la UART."""
+
+    def __init__(self, out, gateway=None, ack=False, drop_acks=0, loss=0.0):
+        self.out = out
+        self.gateway = gateway
+        self.reply = None   # Escribe hacia USART3 RX
+        self.ack = ack
+        self.drop_acks = drop_acks
+        self.loss = loss
+        self.acks_sent = 0
+        self.acks_lost = 0
+        self.alerts = set()
+        self.duplicates = 0
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM) if gateway else None
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.messages = 0
+        self.samples = 0
+        self.lines = 0
+        self.crc_errors = 0
+        self.bytes = 0
+
+    def feed(self, data):
+        self.bytes += len(data)
+        self.buf += data
+        while self.buf:
+            if self.buf[0] != STX:
+                b = self.buf.pop(0)
+                if b == ord("\n"):
+                    self.emit_text()
+                elif b != ord("\r"):
+                    self.text.append(b)
+                continue
+            if len(self.buf) < 2:
+                return
+            length = self.buf[1]
+            if len(self.buf) < 1 + length + 1:
+                return
+            msg = bytes(self.buf[1:1 + length])
+            if length < 2 or crc8(msg) != self.buf[1 + length]:
+                # No era un inicio de trama: el STX pasa como texto
+                self.crc_errors += 1
+                self.text.append(self.buf.pop(0))
+                continue
+            del self.buf[:1 + length + 1]
+            self.emit_publish(msg)
+
+    def emit_text(self):
+        line = self.text.decode("latin-1")
+        self.text.clear()
+        if line:
+            self.lines += 1
+            print(line, file=self.out, flush=True)
+
+    def emit_publish(self, msg):
+        line = decode_publish(msg)
+        if line is None:
+            print(f"# mensaje MQTT-SN no reconocido: {msg.hex()}", file=self.out, flush=True)
+            return
+        self.messages += 1
+        print(line, file=self.out, flush=True)
+        if self.sock is not None:
+            self.sock.sendto(msg, self.gateway)
+
+        qos = (msg[2] >> 5) & 3
+        if int.from_bytes(msg[3:5], "big") != TOPIC_ALERT:
+            self.samples += msg[15]
+        elif msg[5:7] in self.alerts:
+            self.duplicates += 1
+        else:
+            self.alerts.add(msg[5:7])
+        if qos == 1 and self.ack:
+            self.send_puback(msg)
+
+    def send_puback(self, msg):
+        if self.drop_acks > 0:
+            self.drop_acks -= 1
+            self.acks_lost += 1
+            return
+        if self.loss > 0.0 and random.random() < self.loss:
+            self.acks_lost += 1
+            return
+        # PUBACK: largo 7 | 0x0D | tópico | msg id | código 0 (aceptado)
+        puback = bytes([7, MSG_PUBACK]) + msg[3:7] + bytes([0])
+        self.acks_sent += 1
+        if self.reply is not None:
+            try:
+                self.reply(frame(puback))
+            except OSError:
+                pass   # El otro lado ya cerró
+
+
+def set_raw(fd):
+    tty.setraw(fd)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = termios.B115200
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+
+
+def read_available(fd, stream, timeout):
+    """Lee lo disponible; False cuando el otro lado se cerró."""
+    ready, _, _ = select.select([fd], [], [], timeout)
+    if not ready:
+        return True
+    try:
+        data = os.read(fd, 4096)
+    except OSError:
+        return False   # EIO: nadie tiene abierto el lado esclavo
+    if not data:
+        return False
+    stream.feed(data)
+    return True
+
+
+def run_command(cmd, stream, send):
+    master, slave = os.openpty()
+    set_raw(slave)
+    path = os.ttyname(slave)
+    if "{esp}" in cmd:
+        cmd = [path if a == "{esp}" else a for a in cmd]
+    else:
+        cmd = cmd + ["--esp", path]
+
+    for line in send:
+        os.write(master, line.encode() + b"\n")
+    stream.reply = lambda data: os.write(master, data)
+    proc = subprocess.Popen(cmd)
+    while proc.poll() is None:
+        read_available(master, stream, 0.1)
+    os.close(slave)
+    while read_available(master, stream, 0.1):
+        pass
+    os.close(master)
+    return proc.returncode
+
+
+def run_serial(path, stream, send):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    set_raw(fd)
+    stream.reply = lambda data: os.write(fd, data)
+    for line in send:
+        os.write(fd, line.encode() + b"\n")
+    try:
+        while read_available(fd, stream, 1.0):
+            pass
+    except KeyboardInterrupt:
+        pass
+    os.close(fd)
+    return 0
+
+
+def main():
+    argv = sys.argv[1:]
+    cmd = []
+    if "--" in argv:
+        cmd = argv[argv.index("--") + 1:]
+        argv = argv[:argv.index("--")]
+
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--serial", help="dispositivo ya existente en lugar de un comando")
+    parser.add_argument("--gateway", help="HOST:PUERTO de un gateway MQTT-SN por UDP")
+    parser.add_argument("--send", action="append", default=[],
+                        help="línea que se envía a USART3 al empezar (se puede repetir)")
+    parser.add_argument("--sync", action="store_true",
+                        help="enviar SET_TIME con la hora del sistema al empezar")
+    parser.add_argument("--ack", action="store_true",
+                        help="responder PUBACK a los PUBLISH con QoS 1 (alertas)")
+    parser.add_argument("--drop-acks", type=int, default=0,
+                        help="no responder a los primeros N PUBLISH con QoS 1")
+    parser.add_argument("--loss", type=float, default=0.0,
+                        help="probabilidad de perder cada PUBACK")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args(argv)
+    if bool(cmd) == bool(args.serial):
+        parser.error("hace falta un comando después de -- o --serial")
+
+    gateway = None
+    if args.gateway:
+        host, _, port = args.gateway.rpartition(":")
+        gateway = (host or "127.0.0.1", int(port))
+
+    if args.sync:
+        args.send.insert(0, sync_line())
+
+    random.seed(args.seed)
+    stream = Stream(sys.stdout, gateway, args.ack, args.drop_acks, args.loss)
+    if cmd:
+        rc = run_command(cmd, stream, args.send)
+    else:
+        rc = run_serial(args.serial, stream, args.send)
+
+    print(f"# esp-link: {stream.bytes} bytes, {stream.messages} mensajes, "
+          f"{stream.samples} muestras, {stream.lines} líneas, "
+          f"{stream.crc_errors} errores de CRC", file=sys.stderr)
+    if stream.alerts or stream.duplicates:
+        print(f"# alertas: {len(stream.alerts)} distintas, {stream.duplicates} duplicadas, "
+              f"{stream.acks_sent} PUBACK, {stream.acks_lost} perdidos", file=sys.stderr)
+    return rc
+
+
+if __name__ == "__main__":
+    sys.exit(main())
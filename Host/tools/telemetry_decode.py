@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Decodifica un volcado TLM_DUMP de room_control a CSV.
+
+Lee la salida capturada de USART2 (terminal, room_control_sim, Renode) y
+reconstruye una fila por período a partir de los bloques TLMB:<hex>. El
+formato del bloque está documentado en Core/Inc/telemetry.h. Si el RTC
+estaba en hora, t_s es hora Unix y la columna utc la muestra en ISO 8601.
+
+Uso: telemetry_decode.py [CAPTURA|-] [-o SALIDA.csv] [--summary]
+"""
+import argparse
+import datetime
+import re
+import struct
+import sys
+
+BLOCK_SIZE = 128
+HEADER = struct.Struct("<IhH")
+RECORD_FREE = 0xFFFFFFFF
+UNIX_MIN = 946684800   # RTC_CLOCK_UNIX_MIN: antes es tiempo desde el arranque
+
+STATES = ["LOCKED", "UNLOCKED", "INPUT_PASSWORD", "ACCESS_DENIED", "EMERGENCY"]
+EVENTS = ["BOOT", "KEY", "COMMAND", "LOOP_ALARM", "QUEUE_FULL"]
+
+
+def decode_block(data, period_s):
+    time_s, temp_deci, seq = HEADER.unpack_from(data, 0)
+    rows = []
+    t = float(time_s)
+    for offset in range(HEADER.size, BLOCK_SIZE, 4):
+        (record,) = struct.unpack_from("<I", data, offset)
+        if record == RECORD_FREE:
+            break
+        delta = record & 0xFF
+        temp_deci += delta - 256 if delta & 0x80 else delta
+        duty_pct = ((record >> 8) & 0xFF) * 4 / 10.0
+        state = (record >> 16) & 0x7
+        events = (record >> 19) & 0x1F
+        repeat = record >> 24
+        for i in range(1 + repeat):
+            rows.append((seq, t, temp_deci / 10.0, duty_pct, state, events if i == 0 else 0))
+            t += period_s
+    return rows
+
+
+def utc_text(t):
+    if t < UNIX_MIN:
+        return ""
+    return datetime.datetime.fromtimestamp(t, datetime.timezone.utc).strftime("%Y-%m-%dT%H:%M:%SZ")
+
+
+def event_names(mask):
+    return "|".join(name for bit, name in enumerate(EVENTS) if mask & (1 << bit))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", default="-")
+    parser.add_argument("-o", "--output", default="-")
+    parser.add_argument("--summary", action="store_true",
+                        help="tiempo por estado y rango de temperatura")
+    args = parser.parse_args()
+
+    src = sys.stdin if args.capture == "-" else open(args.capture, encoding="utf-8", errors="replace")
+    period_s = 1.0
+    rows = []
+    blocks = 0
+    for line in src:
+        m = re.search(r"TLM: dump .*period_ms=(\d+)", line)
+        if m:
+            period_s = int(m.group(1)) / 1000.0
+            rows = []
+            blocks = 0
+            continue
+        m = re.search(r"TLMB:([0-9A-Fa-f]+)", line)
+        if m and len(m.group(1)) == 2 * BLOCK_SIZE:
+            rows.extend(decode_block(bytes.fromhex(m.group(1)), period_s))
+            blocks += 1
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w", encoding="utf-8")
+    out.write("block,t_s,temp_c,duty_pct,state,events,utc\n")
+    for seq, t, temp, duty, state, events in rows:
+        name = STATES[state] if state < len(STATES) else str(state)
+        out.write(f"{seq},{t:.0f},{temp:.1f},{duty:.1f},{name},{event_names(events)},{utc_text(t)}\n")
+
+    if args.summary:
+        per_state = {}
+        for row in rows:
+            per_state[row[4]] = per_state.get(row[4], 0) + period_s
+        print(f"{blocks} bloques, {len(rows)} períodos", file=sys.stderr)
+        for state, seconds in sorted(per_state.items()):
+            print(f"  {STATES[state]:<15} {seconds:8.0f} s", file=sys.stderr)
+        if rows:
+            temps = [row[2] for row in rows]
+            print(f"  temperatura {min(temps):.1f} .. {max(temps):.1f} C", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Convierte a texto las tramas TLOG() de una captura de USART2.
+
+Los formatos se leen de la sección tlog del ELF que corre en la placa (o
+del ejecutable de host: room_control_sim, room_control_bench). El texto de
+printf que viene mezclado pasa sin cambios. Formato de trama en
+Core/Inc/tlog.h.
+
+Uso: tlog_decode.py ELF [CAPTURA|-] [--stats]
+  cat /dev/ttyACM0 | tlog_decode.py build/Debug/Room_Control_Final_2025_1.elf
+"""
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0x00
+SPEC = re.compile(r"%(%|\{[^}]*\}|[-+ #0-9.]*[lhz]*[diuxXocfFeEgGs])")
+
+
+def tlog_section(path):
+    """Contenido de la sección tlog de un ELF de 32 o 64 bits little endian."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        raise ValueError(f"{path}: no es un ELF little endian")
+    if elf[4] == 1:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        hdr = "<IIIIIIIIII"
+    else:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        hdr = "<IIQQQQIIQQ"
+    sections = [struct.unpack_from(hdr, elf, shoff + i * shentsize) for i in range(shnum)]
+    strtab = sections[shstrndx]
+    for sec in sections:
+        name_off = strtab[4] + sec[0]
+        name = elf[name_off:elf.index(b"\0", name_off)]
+        if name == b"tlog":
+            return elf[sec[4]:sec[4] + sec[5]]
+    raise ValueError(f"{path}: sin sección tlog")
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+
+
+def read_int(data, pos):
+    zz, pos = read_varint(data, pos)
+    value = (zz >> 1) ^ -(zz & 1)
+    return value, pos
+
+
+def render(table, frame):
+    fid = frame[2] | (frame[3] << 8)
+    if fid >= len(table):
+        return None
+    fmt = table[fid:table.index(b"\0", fid)].decode("utf-8", "replace")
+    pos = 4
+    out = []
+    last = 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        spec = m.group(1)
+        if spec == "%":
+            out.append("%")
+            continue
+        if spec.startswith("{"):
+            value, pos = read_int(frame, pos)
+            options = spec[1:-1].split("|")
+            out.append(options[value] if 0 <= value < len(options) else "?")
+            continue
+        conv = spec[-1]
+        pyfmt = "%" + re.sub(r"[lhz]", "", spec)
+        if conv in "fFeEgG":
+            value, = struct.unpack_from("<f", frame, pos)
+            pos += 4
+        elif conv == "s":
+            n, pos = read_varint(frame, pos)
+            value = frame[pos:pos + n].decode("utf-8", "replace")
+            pos += n
+        else:
+            value, pos = read_int(frame, pos)
+            if conv in "uxXo":
+                value &= 0xFFFFFFFF
+            elif conv == "c":
+                value = chr(value & 0xFF)
+        out.append(pyfmt % value)
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf")
+    parser.add_argument("capture", nargs="?", default="-")
+    parser.add_argument("--stats", action="store_true",
+                        help="bytes recibidos frente a bytes de texto equivalentes")
+    args = parser.parse_args()
+
+    table = tlog_section(args.elf)
+    src = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb")
+    data = src.read()
+    out = sys.stdout
+
+    frames = frame_bytes = text_bytes = 0
+    pos = 0
+    while pos < len(data):
+        if data[pos] != SYNC:
+            end = data.find(bytes([SYNC]), pos)
+            end = len(data) if end < 0 else end
+            out.write(data[pos:end].decode("utf-8", "replace"))
+            pos = end
+            continue
+        if pos + 2 > len(data) or pos + 2 + data[pos + 1] > len(data):
+            break   # Trama cortada al final de la captura
+        frame = data[pos:pos + 2 + data[pos + 1]]
+        pos += len(frame)
+        try:
+            text = render(table, frame)
+        except (IndexError, struct.error):
+            text = None
+        text = "<tlog?>\n" if text is None else text
+        out.write(text)
+        frames += 1
+        frame_bytes += len(frame)
+        text_bytes += len(text.encode("utf-8"))
+
+    if args.stats and frames:
+        print(f"{frames} tramas: {frame_bytes} bytes en vez de {text_bytes} "
+              f"({text_bytes / frame_bytes:.1f}x)", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())